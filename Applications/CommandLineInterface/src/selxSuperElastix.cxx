@@ -25,12 +25,19 @@
 #include <boost/algorithm/string.hpp>
 #include <boost/filesystem.hpp>
 #include <boost/program_options.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/json_parser.hpp>
 
 #include <iostream>
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
 #include <iterator>
+#include <sstream>
 #include <string>
 #include <stdexcept>
+#include <thread>
 
 template< class T >
 std::ostream &
@@ -67,9 +74,151 @@ namespace selx
   }
 }
 
+// Write the plan report of the network as json, e.g. for a job scheduler to reserve the resources of the execution
+void
+WritePlanReport( const selx::NetworkPlanReport & report, const boost::filesystem::path & path )
+{
+  boost::property_tree::ptree planTree;
+  planTree.put( "RuntimeClass", selx::ResourceEstimate::ToString( report.runtimeClass ) );
+  planTree.put( "PeakMemorySize", report.peakMemorySize );
+  planTree.put( "PeakMemorySizeWithoutRelease", report.peakMemorySizeWithoutRelease );
+  planTree.put( "MaximumConcurrency", report.maximumConcurrency );
+  planTree.put( "NumberOfThreads", report.numberOfThreads );
+  planTree.put( "NumberOfUpdates", report.numberOfUpdates );
+
+  boost::property_tree::ptree componentsTree;
+  for( const auto & component : report.components )
+  {
+    boost::property_tree::ptree componentTree;
+    componentTree.put( "Name", component.name );
+    componentTree.put( "Update", component.update );
+    componentTree.put( "RuntimeClass", selx::ResourceEstimate::ToString( component.estimate.runtimeClass ) );
+    componentTree.put( "PeakMemorySize", component.estimate.peakMemorySize );
+    componentsTree.push_back( std::make_pair( "", componentTree ) );
+  }
+  planTree.add_child( "Components", componentsTree );
+
+  boost::property_tree::write_json( path.string(), planTree );
+}
+
+
+// Writes the progress events of the registration components as tab separated values while the network executes
+class ProgressWriter
+{
+public:
+
+  ProgressWriter( selx::ProgressEventBuffer::Pointer buffer, const boost::filesystem::path & path ) :
+    m_Buffer( buffer ), m_File( path.string() ), m_IsDone( false )
+  {
+    this->m_File << "Component\tLevel\tIteration\tMetricValue\tElapsedTime\n";
+    this->m_Thread = std::thread( [ this ]() {
+        while( !this->m_IsDone )
+        {
+          this->WriteEvents();
+          std::this_thread::sleep_for( std::chrono::milliseconds( 100 ) );
+        }
+      } );
+  }
+
+
+  ~ProgressWriter()
+  {
+    this->m_IsDone = true;
+    this->m_Thread.join();
+    this->WriteEvents();
+  }
+
+private:
+
+  void WriteEvents()
+  {
+    selx::ProgressEvent event;
+    while( this->m_Buffer->Pop( event ) )
+    {
+      this->m_File << event.componentName << '\t' << event.level << '\t' << event.iteration << '\t' << event.metricValue << '\t'
+                   << event.elapsedTime << '\n';
+    }
+    this->m_File.flush();
+  }
+
+  selx::ProgressEventBuffer::Pointer m_Buffer;
+  std::ofstream                      m_File;
+  std::atomic< bool >                m_IsDone;
+  std::thread                        m_Thread;
+};
+
+
+// The compile subcommand: merge the blueprints and write them as a compiled blueprint, which loads without parsing
+int
+Compile( int ac, char * av[] )
+{
+  selx::Logger::Pointer logger = selx::Logger::New();
+
+  std::vector< boost::filesystem::path > configurationPaths;
+  boost::filesystem::path                compiledPath;
+  selx::LogLevel                         logLevel = selx::LogLevel::WRN;
+
+  try
+  {
+    boost::program_options::options_description desc( "Usage: SuperElastix compile --conf <blueprints> --out <file.selxb>\nAllowed options" );
+    desc.add_options()
+      ( "help", "produce help message" )
+      ( "conf", boost::program_options::value< std::vector< boost::filesystem::path > >( &configurationPaths )->required()->multitoken(), "Configuration file: single or multiple Blueprints [.xml|.json|.selxb]" )
+      ( "out", boost::program_options::value< boost::filesystem::path >( &compiledPath )->required(), "Output compiled blueprint file [.selxb]" )
+      ( "loglevel", boost::program_options::value< selx::LogLevel >( &logLevel ), "Log level [off|critical|error|warning|info|debug|trace]" )
+      ;
+
+    boost::program_options::variables_map vm;
+    boost::program_options::store( boost::program_options::parse_command_line( ac, av, desc ), vm );
+    if( vm.count( "help" ) )
+    {
+      std::cout << desc << "\n";
+      return 0;
+    }
+    boost::program_options::notify( vm );
+  }
+  catch( std::exception & e )
+  {
+    std::cerr << "Error: " << e.what() << "\n";
+    std::cerr << "See 'SuperElastix compile --help' for help" << "\n";
+    return 1;
+  }
+
+  try
+  {
+    logger->AddStream( "cout", std::cout );
+    logger->SetLogLevel( logLevel );
+
+    selx::Blueprint::Pointer blueprint = selx::Blueprint::New();
+    blueprint->SetLogger( logger );
+    for( const auto & configurationPath : configurationPaths )
+    {
+      blueprint->MergeFromFile( configurationPath.string() );
+    }
+
+    logger->Log( selx::LogLevel::INF, "Writing compiled blueprint " + compiledPath.string() + " ..." );
+    blueprint->WriteBinary( compiledPath.string() );
+    logger->Log( selx::LogLevel::INF, "Writing compiled blueprint " + compiledPath.string() + " ... Done" );
+  }
+  catch( std::exception & e )
+  {
+    logger->Log( selx::LogLevel::CRT, "Compiling ... Error" );
+    logger->Log( selx::LogLevel::CRT, e.what() );
+    std::cerr << e.what();
+    return 1;
+  }
+
+  return 0;
+}
+
+
 int
 main( int ac, char * av[] )
 {
+  if( ac > 1 && std::string( av[ 1 ] ) == "compile" )
+  {
+    return Compile( ac - 1, av + 1 );
+  }
 
   selx::Logger::Pointer logger = selx::Logger::New();
   
@@ -93,10 +242,16 @@ main( int ac, char * av[] )
     boost::program_options::options_description desc("Allowed options");
     desc.add_options()
       ( "help", "produce help message" )
-      ("conf", boost::program_options::value< VectorOfPathsType >(&configurationPaths)->required()->multitoken(), "Configuration file: single or multiple Blueprints [.xml|.json]")
+      ("conf", boost::program_options::value< VectorOfPathsType >(&configurationPaths)->required()->multitoken(), "Configuration file: single or multiple Blueprints [.xml|.json|.selxb]. Blueprints can be compiled to .selxb by: SuperElastix compile --conf <blueprints> --out <file.selxb>")
       ("in", boost::program_options::value< VectorOfStringsType >(&inputPairs)->multitoken(), "Input data: images, labels, meshes, etc. Usage arg: <name>=<path> (or multiple pairs)")
       ("out", boost::program_options::value< VectorOfStringsType >(&outputPairs)->multitoken(), "Output data: images, labels, meshes, etc. Usage arg: <name>=<path> (or multiple pairs)")
       ("graphout", boost::program_options::value< boost::filesystem::path >(), "Output Graphviz dot file")
+      ("planout", boost::program_options::value< boost::filesystem::path >(), "Output json file with the estimated runtime class and peak memory of the network. The network is not executed.")
+      ("deterministic", "Bit-reproducible execution: seeded random samplers and no multithreaded reductions, e.g. for regression benchmarks.")
+      ("seed", boost::program_options::value< unsigned int >(), "Seed of the random samplers of all components.")
+      ("timeout", boost::program_options::value< double >(), "Cancel the execution after the given number of seconds.")
+      ("progress", boost::program_options::value< boost::filesystem::path >(), "Output tab separated file with the level, iteration, metric value and elapsed time of each iteration of the registration components, written during the execution.")
+      ("checkpoint", boost::program_options::value< boost::filesystem::path >(), "Checkpoint directory. Rerunning with the same blueprints and inputs resumes from the components that have finished.")
       ("logfile", boost::program_options::value< boost::filesystem::path >(&logPath), "Log output file")
       ("loglevel", boost::program_options::value< selx::LogLevel >(&logLevel), "Log level [off|critical|error|warning|info|debug|trace]")
       ;
@@ -161,6 +316,9 @@ main( int ac, char * av[] )
     // Store the writers for the update call
     std::vector< selx::AnyFileWriter::Pointer > fileWriters;
 
+    // Identifies the inputs in checkpoints, by their paths and the sizes and modification times of their files
+    std::stringstream checkpointInputKey;
+
     if( vm.count( "in" ) )
     {
       logger->Log( selx::LogLevel::INF, "Preparing input data ... ");
@@ -178,6 +336,10 @@ main( int ac, char * av[] )
         reader->SetFileName( path );
         superElastixFilter->SetInput( name, reader->GetOutput() );
         fileReaders.push_back( reader );
+
+        boost::system::error_code errorCode;
+        checkpointInputKey << name << '=' << path << ' ' << boost::filesystem::file_size( path, errorCode ) << ' '
+                           << boost::filesystem::last_write_time( path, errorCode ) << '\n';
         logger->Log( selx::LogLevel::INF, "Preparing input '" + name + "': " + path + " ... Done" );
       }
       logger->Log( selx::LogLevel::INF, "Preparing input data ... Done");
@@ -212,12 +374,47 @@ main( int ac, char * av[] )
       logger->Log( selx::LogLevel::INF, "No output data specified.");
     }
 
+    if( vm.count( "planout" ) )
+    {
+      logger->Log( selx::LogLevel::INF, "Planning ...");
+      WritePlanReport( superElastixFilter->GetPlanReport(), vm["planout"].as< boost::filesystem::path >() );
+      logger->Log( selx::LogLevel::INF, "Planning ... Done");
+      return 0;
+    }
+
+    if( vm.count( "checkpoint" ) )
+    {
+      superElastixFilter->SetCheckpointDirectory( vm[ "checkpoint" ].as< boost::filesystem::path >().string() );
+      superElastixFilter->SetCheckpointInputKey( checkpointInputKey.str() );
+    }
+
+    superElastixFilter->SetDeterministic( vm.count( "deterministic" ) > 0 );
+    if( vm.count( "seed" ) )
+    {
+      superElastixFilter->SetRandomSeed( vm[ "seed" ].as< unsigned int >() );
+    }
+
+    if( vm.count( "timeout" ) )
+    {
+      superElastixFilter->GetCancellationToken()->CancelAfter(
+        std::chrono::duration_cast< selx::CancellationToken::ClockType::duration >( std::chrono::duration< double >( vm[ "timeout" ].as< double >() ) ) );
+    }
+
+    std::unique_ptr< ProgressWriter > progressWriter;
+    if( vm.count( "progress" ) )
+    {
+      selx::ProgressEventBuffer::Pointer progressEventBuffer = std::make_shared< selx::ProgressEventBuffer >();
+      superElastixFilter->SetProgressEventBuffer( progressEventBuffer );
+      progressWriter.reset( new ProgressWriter( progressEventBuffer, vm[ "progress" ].as< boost::filesystem::path >() ) );
+    }
+
     /* Execute SuperElastix by updating the writers */
     logger->Log( selx::LogLevel::INF, "Executing ...");
     for( auto & writer : fileWriters )
     {
       writer->Update();
     }
+    progressWriter.reset();
     logger->Log(selx:: LogLevel::INF, "Executing ... Done");
   }
   catch( std::exception & e )
@@ -27,6 +27,13 @@ set( ${MODULE}_SOURCE_FILES
   ${${MODULE}_SOURCE_DIR}/src/selxBlueprint.cxx
   ${${MODULE}_SOURCE_DIR}/src/selxBlueprintImpl.h
   ${${MODULE}_SOURCE_DIR}/src/selxBlueprintImpl.cxx
+  ${${MODULE}_SOURCE_DIR}/src/selxBlueprintSections.h
+  ${${MODULE}_SOURCE_DIR}/src/selxBlueprintBinaryFormat.h
+  ${${MODULE}_SOURCE_DIR}/src/selxBlueprintBinaryFormat.cxx
+  ${${MODULE}_SOURCE_DIR}/src/selxBlueprintJsonReader.h
+  ${${MODULE}_SOURCE_DIR}/src/selxBlueprintJsonReader.cxx
+  ${${MODULE}_SOURCE_DIR}/src/selxBlueprintFileCache.h
+  ${${MODULE}_SOURCE_DIR}/src/selxBlueprintFileCache.cxx
 )
 
 # Export tests
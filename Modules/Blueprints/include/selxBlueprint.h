@@ -86,6 +86,12 @@ public:
 
   bool ConnectionExists( ComponentNameType upstream, ComponentNameType downstream, ConnectionNameType name = "" ) const;
 
+  // Clone the components componentNames, and the connections between them, numberOfReplicas times when the network is
+  // built. The replicas are named <componentName>_<index> and share the components that connect into the subgraph.
+  bool SetReplication( std::string name, ComponentNamesType componentNames, std::size_t numberOfReplicas );
+
+  bool DeleteReplication( std::string name );
+
   //std::unique_ptr<BlueprintImpl> Clone(BlueprintImpl const &other );
 
   // "functional" composition of blueprints is done by adding settings of other to this blueprint. Redefining/overwriting properties is not allowed and returns false.
@@ -100,9 +106,13 @@ public:
   // Write graphviz dot file
   void Write( const std::string filename );
 
+  // Write compiled blueprint file (.selxb), which MergeFromFile loads without parsing
+  void WriteBinary( const std::string & filename ) const;
+
   // Read json or XML file
   //void FromFile(const std::string& filename);
 
+  // Read json, XML or compiled blueprint file
   void MergeFromFile(const std::string& filename);
 
   void SetLogger( Logger::Pointer logger );
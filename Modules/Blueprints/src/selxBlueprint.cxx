@@ -124,6 +124,24 @@ Blueprint
 }
 
 
+bool
+Blueprint
+::SetReplication( std::string name, ComponentNamesType componentNames, std::size_t numberOfReplicas )
+{
+  this->Modified();
+  return this->m_BlueprintImpl->SetReplication( name, componentNames, numberOfReplicas );
+}
+
+
+bool
+Blueprint
+::DeleteReplication( std::string name )
+{
+  this->Modified();
+  return this->m_BlueprintImpl->DeleteReplication( name );
+}
+
+
 bool
 Blueprint
 ::ComposeWith( const Blueprint * other)
@@ -156,6 +174,13 @@ Blueprint
   this->m_BlueprintImpl->Write( filename );
 }
 
+void
+Blueprint
+::WriteBinary( const std::string & filename ) const
+{
+  this->m_BlueprintImpl->WriteBinary( filename );
+}
+
 void
 Blueprint
 ::MergeFromFile( const std::string& filename )
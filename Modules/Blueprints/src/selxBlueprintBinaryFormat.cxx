@@ -0,0 +1,302 @@
+/*=========================================================================
+ *
+ *  Copyright Leiden University Medical Center, Erasmus University Medical
+ *  Center and contributors
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "selxBlueprintBinaryFormat.h"
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <stdexcept>
+#include <vector>
+
+namespace selx
+{
+const char BlueprintBinaryFormat::Magic[ 8 ] = { 'S', 'E', 'L', 'X', 'B', 'L', 'U', 'E' };
+const std::uint32_t BlueprintBinaryFormat::Version;
+const std::uint32_t BlueprintBinaryFormat::ByteOrderMark;
+const char * const  BlueprintBinaryFormat::Extension = ".selxb";
+
+namespace
+{
+// Stores every distinct string once, in the order in which they are added
+class StringTable
+{
+public:
+
+  std::uint64_t Add( const std::string & value )
+  {
+    auto entry = this->m_Indices.emplace( value, this->m_Offsets.size() );
+    if( entry.second )
+    {
+      this->m_Data += value;
+      this->m_Offsets.push_back( this->m_Data.size() );
+    }
+    return entry.first->second;
+  }
+
+
+  // The begin of every string and the end of the last
+  std::vector< std::uint64_t > GetOffsets() const
+  {
+    std::vector< std::uint64_t > offsets( 1, 0 );
+    offsets.insert( offsets.end(), this->m_Offsets.begin(), this->m_Offsets.end() );
+    return offsets;
+  }
+
+
+  const std::string & GetData() const { return this->m_Data; }
+
+private:
+
+  std::map< std::string, std::uint64_t > m_Indices;
+  std::vector< std::uint64_t >           m_Offsets;
+  std::string                            m_Data;
+};
+
+void
+AddParameterMap( const BlueprintSections::ParameterMapType & parameterMap, StringTable & strings, std::vector< std::uint64_t > & parameters,
+  std::vector< std::uint64_t > & values )
+{
+  for( const auto & parameter : parameterMap )
+  {
+    parameters.push_back( strings.Add( parameter.first ) );
+    parameters.push_back( values.size() );
+    parameters.push_back( parameter.second.size() );
+    for( const auto & value : parameter.second )
+    {
+      values.push_back( strings.Add( value ) );
+    }
+  }
+}
+
+
+void
+WriteWords( std::ofstream & file, const std::vector< std::uint64_t > & words )
+{
+  file.write( reinterpret_cast< const char * >( words.data() ), static_cast< std::streamsize >( words.size() * sizeof( std::uint64_t ) ) );
+}
+} // namespace
+
+
+void
+BlueprintBinaryFormat::Write( const BlueprintSections & sections, const std::string & fileName )
+{
+  if( !sections.includes.empty() )
+  {
+    throw std::runtime_error( fileName + ": compiled blueprints cannot have includes" );
+  }
+
+  StringTable                  strings;
+  std::vector< std::uint64_t > components;
+  std::vector< std::uint64_t > connections;
+  std::vector< std::uint64_t > replications;
+  std::vector< std::uint64_t > parameters;
+  std::vector< std::uint64_t > values;
+
+  for( const auto & component : sections.components )
+  {
+    components.push_back( strings.Add( component.name ) );
+    components.push_back( parameters.size() / 3 );
+    components.push_back( component.parameterMap->size() );
+    AddParameterMap( *component.parameterMap, strings, parameters, values );
+  }
+  for( const auto & connection : sections.connections )
+  {
+    connections.push_back( strings.Add( connection.out ) );
+    connections.push_back( strings.Add( connection.in ) );
+    connections.push_back( strings.Add( connection.name ) );
+    connections.push_back( parameters.size() / 3 );
+    connections.push_back( connection.parameterMap->size() );
+    AddParameterMap( *connection.parameterMap, strings, parameters, values );
+  }
+  for( const auto & replication : sections.replications )
+  {
+    replications.push_back( strings.Add( replication.name ) );
+    replications.push_back( values.size() );
+    replications.push_back( replication.componentNames.size() );
+    replications.push_back( replication.numberOfReplicas );
+    for( const auto & componentName : replication.componentNames )
+    {
+      values.push_back( strings.Add( componentName ) );
+    }
+  }
+
+  const std::vector< std::uint64_t > stringOffsets = strings.GetOffsets();
+
+  HeaderType header;
+  std::memcpy( header.magic, Magic, sizeof( header.magic ) );
+  header.version              = Version;
+  header.byteOrderMark        = ByteOrderMark;
+  header.numberOfStrings      = stringOffsets.size() - 1;
+  header.numberOfComponents   = sections.components.size();
+  header.numberOfConnections  = sections.connections.size();
+  header.numberOfReplications = sections.replications.size();
+  header.numberOfParameters   = parameters.size() / 3;
+  header.numberOfValues       = values.size();
+  header.stringDataSize       = strings.GetData().size();
+
+  std::ofstream file( fileName, std::ios::out | std::ios::binary | std::ios::trunc );
+  file.write( reinterpret_cast< const char * >( &header ), sizeof( header ) );
+  WriteWords( file, stringOffsets );
+  WriteWords( file, components );
+  WriteWords( file, connections );
+  WriteWords( file, replications );
+  WriteWords( file, parameters );
+  WriteWords( file, values );
+  file.write( strings.GetData().data(), static_cast< std::streamsize >( strings.GetData().size() ) );
+  if( !file )
+  {
+    throw std::runtime_error( fileName + ": cannot write compiled blueprint" );
+  }
+}
+
+
+BlueprintSections
+BlueprintBinaryFormat::Read( const std::string & fileName )
+{
+  auto fail = [ &fileName ]( const std::string & message ) {
+      throw std::runtime_error( fileName + ": " + message );
+    };
+
+  boost::interprocess::mapped_region region;
+  try
+  {
+    boost::interprocess::file_mapping mapping( fileName.c_str(), boost::interprocess::read_only );
+    region = boost::interprocess::mapped_region( mapping, boost::interprocess::read_only );
+  }
+  catch( const std::exception & error )
+  {
+    fail( std::string( "cannot map file: " ) + error.what() );
+  }
+  const char *      data = static_cast< const char * >( region.get_address() );
+  const std::size_t size = region.get_size();
+
+  HeaderType header;
+  if( size < sizeof( header ) )
+  {
+    fail( "not a compiled blueprint" );
+  }
+  std::memcpy( &header, data, sizeof( header ) );
+  if( std::memcmp( header.magic, Magic, sizeof( header.magic ) ) != 0 )
+  {
+    fail( "not a compiled blueprint" );
+  }
+  if( header.version != Version )
+  {
+    fail( "unsupported compiled blueprint version " + std::to_string( header.version ) );
+  }
+  if( header.byteOrderMark != ByteOrderMark )
+  {
+    fail( "compiled blueprint has a different byte order" );
+  }
+
+  // Check the sizes of the arrays before computing the size of the file from them, such that it cannot overflow
+  const std::uint64_t maximumNumberOfWords = size / sizeof( std::uint64_t );
+  if( header.numberOfStrings >= maximumNumberOfWords || header.numberOfComponents > maximumNumberOfWords / 3
+    || header.numberOfConnections > maximumNumberOfWords / 5 || header.numberOfReplications > maximumNumberOfWords / 4
+    || header.numberOfParameters > maximumNumberOfWords / 3 || header.numberOfValues > maximumNumberOfWords || header.stringDataSize > size )
+  {
+    fail( "compiled blueprint is truncated" );
+  }
+  const std::uint64_t numberOfWords = header.numberOfStrings + 1 + 3 * header.numberOfComponents + 5 * header.numberOfConnections
+    + 4 * header.numberOfReplications + 3 * header.numberOfParameters + header.numberOfValues;
+  if( sizeof( header ) + numberOfWords * sizeof( std::uint64_t ) + header.stringDataSize != size )
+  {
+    fail( "compiled blueprint is truncated" );
+  }
+
+  // The mapping is page aligned and the header a multiple of 8 bytes, so the arrays are aligned
+  const std::uint64_t * stringOffsets = reinterpret_cast< const std::uint64_t * >( data + sizeof( header ) );
+  const std::uint64_t * components    = stringOffsets + header.numberOfStrings + 1;
+  const std::uint64_t * connections   = components + 3 * header.numberOfComponents;
+  const std::uint64_t * replications  = connections + 5 * header.numberOfConnections;
+  const std::uint64_t * parameters    = replications + 4 * header.numberOfReplications;
+  const std::uint64_t * values        = parameters + 3 * header.numberOfParameters;
+  const char *          stringData    = reinterpret_cast< const char * >( values + header.numberOfValues );
+
+  if( stringOffsets[ 0 ] != 0 || stringOffsets[ header.numberOfStrings ] != header.stringDataSize )
+  {
+    fail( "compiled blueprint has an invalid string table" );
+  }
+  for( std::uint64_t index = 0; index < header.numberOfStrings; ++index )
+  {
+    if( stringOffsets[ index ] > stringOffsets[ index + 1 ] )
+    {
+      fail( "compiled blueprint has an invalid string table" );
+    }
+  }
+
+  auto getString = [ & ]( std::uint64_t index ) {
+      if( index >= header.numberOfStrings )
+      {
+        fail( "compiled blueprint refers to string " + std::to_string( index ) + " that does not exist" );
+      }
+      return std::string( stringData + stringOffsets[ index ], stringData + stringOffsets[ index + 1 ] );
+    };
+  auto getValues = [ & ]( std::uint64_t first, std::uint64_t count ) {
+      if( first > header.numberOfValues || count > header.numberOfValues - first )
+      {
+        fail( "compiled blueprint refers to values that do not exist" );
+      }
+      Blueprint::ParameterValueType parameterValues;
+      parameterValues.reserve( count );
+      for( std::uint64_t value = first; value < first + count; ++value )
+      {
+        parameterValues.push_back( getString( values[ value ] ) );
+      }
+      return parameterValues;
+    };
+  auto getParameterMap = [ & ]( std::uint64_t first, std::uint64_t count ) {
+      if( first > header.numberOfParameters || count > header.numberOfParameters - first )
+      {
+        fail( "compiled blueprint refers to parameters that do not exist" );
+      }
+      // The parameters were written in the order of the map, so each is inserted at its end
+      BlueprintSections::ParameterMapType parameterMap;
+      for( const std::uint64_t * parameter = parameters + 3 * first; parameter != parameters + 3 * ( first + count ); parameter += 3 )
+      {
+        parameterMap.emplace_hint( parameterMap.end(), getString( parameter[ 0 ] ), getValues( parameter[ 1 ], parameter[ 2 ] ) );
+      }
+      return std::make_shared< const BlueprintSections::ParameterMapType >( std::move( parameterMap ) );
+    };
+
+  BlueprintSections sections;
+  sections.components.reserve( header.numberOfComponents );
+  for( const std::uint64_t * component = components; component != connections; component += 3 )
+  {
+    sections.components.push_back( { getString( component[ 0 ] ), getParameterMap( component[ 1 ], component[ 2 ] ) } );
+  }
+  sections.connections.reserve( header.numberOfConnections );
+  for( const std::uint64_t * connection = connections; connection != replications; connection += 5 )
+  {
+    sections.connections.push_back( { getString( connection[ 0 ] ), getString( connection[ 1 ] ), getString( connection[ 2 ] ),
+                                      getParameterMap( connection[ 3 ], connection[ 4 ] ) } );
+  }
+  sections.replications.reserve( header.numberOfReplications );
+  for( const std::uint64_t * replication = replications; replication != parameters; replication += 4 )
+  {
+    sections.replications.push_back( { getString( replication[ 0 ] ), getValues( replication[ 1 ], replication[ 2 ] ),
+                                       static_cast< std::size_t >( replication[ 3 ] ) } );
+  }
+  return sections;
+}
+} // namespace selx
@@ -0,0 +1,80 @@
+/*=========================================================================
+ *
+ *  Copyright Leiden University Medical Center, Erasmus University Medical
+ *  Center and contributors
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#ifndef selxBlueprintBinaryFormat_h
+#define selxBlueprintBinaryFormat_h
+
+#include "selxBlueprintSections.h"
+
+#include <cstdint>
+#include <string>
+
+namespace selx
+{
+// Compiled blueprint files (.selxb): the components, connections and replications of a blueprint with its includes
+// resolved, for deployments that load the same validated blueprint over and over. The file consists of a header, the
+// record arrays and a string table in which every distinct name, key and value is stored once:
+//
+//   Header
+//   uint64 stringOffsets[ numberOfStrings + 1 ]   begin of each string in the string data, and the end of the last
+//   uint64 components[ numberOfComponents ][ 3 ]     name, first parameter, number of parameters
+//   uint64 connections[ numberOfConnections ][ 5 ]   out, in, name, first parameter, number of parameters
+//   uint64 replications[ numberOfReplications ][ 4 ] name, first value, number of values, number of replicas
+//   uint64 parameters[ numberOfParameters ][ 3 ]     key, first value, number of values
+//   uint64 values[ numberOfValues ]                  string index of each value or replicated component name
+//   char   stringData[ stringDataSize ]
+//
+// Names, keys and values are string indices. All integers are in the byte order of the writing machine, which the
+// header records. The file is memory mapped for reading and validated before any of it is used.
+class BlueprintBinaryFormat
+{
+public:
+
+  struct HeaderType
+  {
+    char          magic[ 8 ];
+    std::uint32_t version;
+    std::uint32_t byteOrderMark;
+    std::uint64_t numberOfStrings;
+    std::uint64_t numberOfComponents;
+    std::uint64_t numberOfConnections;
+    std::uint64_t numberOfReplications;
+    std::uint64_t numberOfParameters;
+    std::uint64_t numberOfValues;
+    std::uint64_t stringDataSize;
+  };
+
+  static const char          Magic[ 8 ];
+  static const std::uint32_t Version       = 1;
+  static const std::uint32_t ByteOrderMark = 0x01020304;
+
+  // The extension by which MergeFromFile recognizes compiled blueprints
+  static const char * const Extension;
+
+  // Write the sections, whose includes must have been merged already. Throws std::runtime_error on failure.
+  static void Write( const BlueprintSections & sections, const std::string & fileName );
+
+  // Map the file and read its sections. Apart from the strings and parameter maps of the sections themselves, which the
+  // blueprint takes over, only the section arrays are allocated. Throws std::runtime_error if the file cannot be mapped
+  // or is not a valid compiled blueprint.
+  static BlueprintSections Read( const std::string & fileName );
+};
+} // namespace selx
+
+#endif // #ifndef selxBlueprintBinaryFormat_h
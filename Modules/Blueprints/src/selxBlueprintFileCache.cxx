@@ -0,0 +1,210 @@
+/*=========================================================================
+ *
+ *  Copyright Leiden University Medical Center, Erasmus University Medical
+ *  Center and contributors
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+
+#include "selxBlueprintFileCache.h"
+#include "selxBlueprintBinaryFormat.h"
+#include "selxBlueprintJsonReader.h"
+
+#include <boost/filesystem.hpp>
+
+#include <stdexcept>
+
+#if defined( _WIN32 )
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <sys/stat.h>
+#endif
+
+namespace selx
+{
+const std::size_t BlueprintFileCache::DefaultCapacity;
+
+namespace
+{
+// The modification time of the file in nanoseconds, as precise as the file system records it, and its size. A time
+// in whole seconds would not notice that a file was written again within the second it was read.
+bool
+GetModifiedTimeAndSize( const std::string & fileName, std::int64_t & modifiedTime, std::uintmax_t & fileSize )
+{
+#if defined( _WIN32 )
+  WIN32_FILE_ATTRIBUTE_DATA attributes;
+  if( !GetFileAttributesExA( fileName.c_str(), GetFileExInfoStandard, &attributes ) )
+  {
+    return false;
+  }
+  // In units of 100 nanoseconds
+  modifiedTime = ( ( static_cast< std::int64_t >( attributes.ftLastWriteTime.dwHighDateTime ) << 32 )
+    | attributes.ftLastWriteTime.dwLowDateTime ) * 100;
+  fileSize = ( static_cast< std::uintmax_t >( attributes.nFileSizeHigh ) << 32 ) | attributes.nFileSizeLow;
+#else
+  struct stat status;
+  if( stat( fileName.c_str(), &status ) != 0 )
+  {
+    return false;
+  }
+#if defined( __APPLE__ )
+  const struct timespec & time = status.st_mtimespec;
+#else
+  const struct timespec & time = status.st_mtim;
+#endif
+  modifiedTime = static_cast< std::int64_t >( time.tv_sec ) * 1000000000 + time.tv_nsec;
+  fileSize     = static_cast< std::uintmax_t >( status.st_size );
+#endif
+  return true;
+}
+} // end anonymous namespace
+
+
+BlueprintFileCache &
+BlueprintFileCache::GetDefault()
+{
+  static BlueprintFileCache cache;
+  return cache;
+}
+
+
+BlueprintFileCache::SectionsPointer
+BlueprintFileCache::Read( const std::string & fileName, LoggerImpl & logger )
+{
+  boost::system::error_code error;
+  const boost::filesystem::path canonicalPath = boost::filesystem::canonical( fileName, error );
+  if( error )
+  {
+    throw std::runtime_error( fileName + ": cannot open file" );
+  }
+  const std::string key = canonicalPath.string();
+  std::int64_t      modifiedTime;
+  std::uintmax_t    fileSize;
+  if( !GetModifiedTimeAndSize( key, modifiedTime, fileSize ) )
+  {
+    throw std::runtime_error( fileName + ": cannot read file" );
+  }
+
+  std::promise< SectionsPointer > promise;
+  std::shared_future< SectionsPointer > sections;
+  {
+    std::lock_guard< std::mutex > lock( this->m_Mutex );
+    auto cached = this->m_Cache.find( key );
+    if( cached != this->m_Cache.end() && cached->second->modifiedTime == modifiedTime && cached->second->fileSize == fileSize )
+    {
+      this->m_Entries.splice( this->m_Entries.begin(), this->m_Entries, cached->second );
+      sections = cached->second->sections;
+    }
+    else
+    {
+      if( cached != this->m_Cache.end() )
+      {
+        this->m_Entries.erase( cached->second );
+      }
+      this->m_Entries.push_front( { key, modifiedTime, fileSize, promise.get_future().share() } );
+      this->m_Cache[ key ] = this->m_Entries.begin();
+      ++this->m_NumberOfParses;
+      this->Evict();
+    }
+  }
+  if( sections.valid() )
+  {
+    logger.Log( LogLevel::DBG, "Found {0} in the blueprint file cache", fileName );
+    return sections.get();
+  }
+
+  // Parse outside the lock, other files may be read meanwhile
+  try
+  {
+    SectionsPointer parsed;
+    if( canonicalPath.extension() == BlueprintBinaryFormat::Extension )
+    {
+      parsed = std::make_shared< const BlueprintSections >( BlueprintBinaryFormat::Read( key ) );
+    }
+    else
+    {
+      parsed = std::make_shared< const BlueprintSections >( BlueprintJsonReader( logger ).ReadFile( fileName ) );
+    }
+    promise.set_value( parsed );
+    return parsed;
+  }
+  catch( ... )
+  {
+    promise.set_exception( std::current_exception() );
+    std::lock_guard< std::mutex > lock( this->m_Mutex );
+    auto cached = this->m_Cache.find( key );
+    if( cached != this->m_Cache.end() && cached->second->modifiedTime == modifiedTime && cached->second->fileSize == fileSize )
+    {
+      this->m_Entries.erase( cached->second );
+      this->m_Cache.erase( cached );
+    }
+    throw;
+  }
+}
+
+
+void
+BlueprintFileCache::Clear()
+{
+  std::lock_guard< std::mutex > lock( this->m_Mutex );
+  this->m_Cache.clear();
+  this->m_Entries.clear();
+}
+
+
+std::size_t
+BlueprintFileCache::Size() const
+{
+  std::lock_guard< std::mutex > lock( this->m_Mutex );
+  return this->m_Cache.size();
+}
+
+
+void
+BlueprintFileCache::SetCapacity( std::size_t capacity )
+{
+  std::lock_guard< std::mutex > lock( this->m_Mutex );
+  this->m_Capacity = capacity;
+  this->Evict();
+}
+
+
+std::size_t
+BlueprintFileCache::GetCapacity() const
+{
+  std::lock_guard< std::mutex > lock( this->m_Mutex );
+  return this->m_Capacity;
+}
+
+
+std::size_t
+BlueprintFileCache::GetNumberOfParses() const
+{
+  std::lock_guard< std::mutex > lock( this->m_Mutex );
+  return this->m_NumberOfParses;
+}
+
+
+void
+BlueprintFileCache::Evict()
+{
+  while( this->m_Entries.size() > this->m_Capacity )
+  {
+    this->m_Cache.erase( this->m_Entries.back().key );
+    this->m_Entries.pop_back();
+  }
+}
+} // end namespace selx
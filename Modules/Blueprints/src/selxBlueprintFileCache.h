@@ -0,0 +1,102 @@
+/*=========================================================================
+ *
+ *  Copyright Leiden University Medical Center, Erasmus University Medical
+ *  Center and contributors
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+
+#ifndef selxBlueprintFileCache_h
+#define selxBlueprintFileCache_h
+
+#include "selxBlueprintSections.h"
+#include "selxLoggerImpl.h"
+
+#include <cstdint>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace selx
+{
+/** \class BlueprintFileCache
+ * \brief Process wide cache of the sections of parsed json and compiled blueprint files.
+ *
+ * Batch runs include the same base blueprints, such as elastix_Base.json, over and over. Files are identified by
+ * their canonical path and parsed again only when their size or their modification time, to the nanosecond as far as
+ * the file system records it, changes. Concurrent reads of the same file parse it once, the other readers wait for the
+ * result. Files that fail to parse are not cached. The cache keeps the most recently read files, up to its capacity.
+ * All member functions are thread safe.
+ */
+class BlueprintFileCache
+{
+public:
+
+  typedef std::shared_ptr< const BlueprintSections > SectionsPointer;
+
+  static const std::size_t DefaultCapacity = 1024;
+
+  BlueprintFileCache() : m_Capacity( DefaultCapacity ), m_NumberOfParses( 0 ) {}
+
+  // The cache shared by all blueprints of the process
+  static BlueprintFileCache & GetDefault();
+
+  // The sections of the .json or .selxb file, parsed if it is not in the cache or has changed since. The file then
+  // becomes the most recently read. Throws std::runtime_error if the file cannot be read or parsed.
+  SectionsPointer Read( const std::string & fileName, LoggerImpl & logger );
+
+  void Clear();
+
+  std::size_t Size() const;
+
+  // The maximum number of files, the least recently read are removed beyond it
+  void SetCapacity( std::size_t capacity );
+
+  std::size_t GetCapacity() const;
+
+  // The number of files that were actually parsed, rather than found in the cache
+  std::size_t GetNumberOfParses() const;
+
+private:
+
+  struct EntryType
+  {
+    std::string                          key;
+    std::int64_t                         modifiedTime;
+    std::uintmax_t                       fileSize;
+    std::shared_future< SectionsPointer > sections;
+  };
+
+  typedef std::list< EntryType > EntriesType;
+
+  BlueprintFileCache( const BlueprintFileCache & ); //purposely not implemented
+  void operator=( const BlueprintFileCache & );     //purposely not implemented
+
+  // Remove the least recently read entries beyond the capacity, with the mutex locked
+  void Evict();
+
+  // Most recently read first
+  EntriesType                                             m_Entries;
+  std::unordered_map< std::string, EntriesType::iterator > m_Cache;
+  std::size_t                                             m_Capacity;
+  std::size_t                                             m_NumberOfParses;
+  mutable std::mutex                                      m_Mutex;
+};
+} // end namespace selx
+
+#endif // selxBlueprintFileCache_h
@@ -19,9 +19,14 @@
 
 #include "selxBlueprintImpl.h"
 #include "selxLoggerImpl.h"
+#include <algorithm>
+#include <fstream>
+#include <future>
 #include <ostream>
+#include <sstream>
 
 #include <stdexcept>
+#include <tuple>
 
 namespace selx
 {
@@ -42,77 +47,44 @@ operator<<( std::ostream & out, const BlueprintImpl::ParameterMapType & val )
 }
 
 
-template< class NameType, class ParameterMapType >
-class vertex_label_writer
-{
-public:
-
-  vertex_label_writer( NameType _name, ParameterMapType _parameterMap ) : name( _name ), parameterMap( _parameterMap ) {}
-  template< class VertexOrEdge >
-  void operator()( std::ostream & out, const VertexOrEdge & v ) const
-  {
-    out << "[label=\"" << name[ v ] << "\n" << parameterMap[ v ] << "\"]";
-  }
-
-
-private:
-
-  NameType         name;
-  ParameterMapType parameterMap;
-};
-
-template< class NameType, class ParameterMapType >
-inline vertex_label_writer< NameType, ParameterMapType >
-make_vertex_label_writer( NameType n, ParameterMapType p )
-{
-  return vertex_label_writer< NameType, ParameterMapType >( n, p );
-}
-
-
-template< class ParameterMapType >
-class edge_label_writer
-{
-public:
-
-  edge_label_writer( ParameterMapType _parameterMap ) : parameterMap( _parameterMap ) {}
-  template< class VertexOrEdge >
-  void operator()( std::ostream & out, const VertexOrEdge & v ) const
-  {
-    out << "[label=\"" << parameterMap[ v ] << "\"]";
-  }
-
-
-private:
-
-  ParameterMapType parameterMap;
-};
+const BlueprintImpl::ComponentIndexType  BlueprintImpl::NullComponentIndex;
+const BlueprintImpl::ConnectionIndexType BlueprintImpl::NullConnectionIndex;
 
-template< class ParameterMapType >
-inline edge_label_writer< ParameterMapType >
-make_edge_label_writer( ParameterMapType p )
+BlueprintImpl::BlueprintImpl( LoggerImpl & loggerImpl ) : m_ModifiedTime( 0 ), m_LoggerImpl(&loggerImpl)
 {
-  return edge_label_writer< ParameterMapType >( p );
 }
 
 
-BlueprintImpl::BlueprintImpl( LoggerImpl & loggerImpl ) : m_LoggerImpl(&loggerImpl)
+bool
+BlueprintImpl
+::SetComponent( ComponentNameType name, ParameterMapType parameterMap )
 {
+  return this->SetSharedComponent( std::move( name ), std::make_shared< const ParameterMapType >( std::move( parameterMap ) ) );
 }
 
 
 bool
 BlueprintImpl
-::SetComponent( ComponentNameType name, ParameterMapType parameterMap )
+::SetSharedComponent( ComponentNameType name, ParameterMapPointer parameterMap )
 {
-  if( this->ComponentExists( name ) )
+  const ComponentIndexType index = this->GetComponentIndex( name );
+  if( index != NullComponentIndex )
   {
-    this->m_Graph[ name ].parameterMap = parameterMap;
+    ComponentPropertyType & component = this->m_Graph.components[ index ];
+    if( component.parameterMap != parameterMap && *component.parameterMap != *parameterMap )
+    {
+      component.parameterMap = std::move( parameterMap );
+      component.modifiedTime = this->Modified();
+    }
     return true;
   }
-  else
-  {
-    return this->m_Graph.insert_vertex( name, { name, parameterMap } ).second;
-  }
+
+  this->m_Graph.componentIndices.emplace( name, this->m_Graph.components.size() );
+  this->m_Graph.components.emplace_back( std::move( name ), std::move( parameterMap ), this->Modified() );
+  // A new component has no connections yet
+  this->m_Graph.outputs.offsets.push_back( this->m_Graph.outputs.connections.size() );
+  this->m_Graph.inputs.offsets.push_back( this->m_Graph.inputs.connections.size() );
+  return true;
 }
 
 
@@ -120,7 +92,8 @@ BlueprintImpl::ParameterMapType
 BlueprintImpl
 ::GetComponent( ComponentNameType name ) const
 {
-  if( !this->ComponentExists( name ) )
+  const ComponentIndexType index = this->GetComponentIndex( name );
+  if( index == NullComponentIndex )
   {
     std::stringstream msg;
     msg << "BlueprintImpl does not contain component " << name << std::endl;
@@ -128,7 +101,7 @@ BlueprintImpl
     throw std::runtime_error( msg.str() );
   }
 
-  return this->m_Graph[ name ].parameterMap;
+  return *this->m_Graph.components[ index ].parameterMap;
 }
 
 
@@ -136,13 +109,37 @@ bool
 BlueprintImpl
 ::DeleteComponent( ComponentNameType name )
 {
-  if( !this->ComponentExists( name ) )
+  const ComponentIndexType index = this->GetComponentIndex( name );
+  if( index == NullComponentIndex )
   {
-    this->m_Graph.remove_vertex( name );
-    return true;
+    return false;
   }
 
-  return false;
+  // Delete the connections of the component, and renumber the components after it
+  for( auto connection = this->m_Graph.connections.begin(); connection != this->m_Graph.connections.end(); )
+  {
+    if( connection->upstream == index || connection->downstream == index )
+    {
+      // The components at the other end were configured with this connection
+      const ModifiedTimeType modifiedTime = this->Modified();
+      this->m_Graph.components[ connection->upstream ].modifiedTime = modifiedTime;
+      this->m_Graph.components[ connection->downstream ].modifiedTime = modifiedTime;
+      connection = this->m_Graph.connections.erase( connection );
+      continue;
+    }
+    connection->upstream -= connection->upstream > index ? 1 : 0;
+    connection->downstream -= connection->downstream > index ? 1 : 0;
+    ++connection;
+  }
+  this->m_Graph.components.erase( this->m_Graph.components.begin() + index );
+  this->m_Graph.componentIndices.erase( name );
+  for( auto & componentIndex : this->m_Graph.componentIndices )
+  {
+    componentIndex.second -= componentIndex.second > index ? 1 : 0;
+  }
+  this->RebuildConnectionIndices();
+  this->Modified();
+  return true;
 }
 
 
@@ -151,9 +148,10 @@ BlueprintImpl
 ::GetComponentNames( void ) const
 {
   ComponentNamesType container;
-  for( auto it = boost::vertices( this->m_Graph.graph() ).first; it != boost::vertices( this->m_Graph.graph() ).second; ++it )
+  container.reserve( this->m_Graph.components.size() );
+  for( auto const & component : this->m_Graph.components )
   {
-    container.push_back( this->m_Graph.graph()[ *it ].name );
+    container.push_back( component.name );
   }
   return container;
 }
@@ -163,30 +161,42 @@ bool
 BlueprintImpl
 ::SetConnection( ComponentNameType upstream, ComponentNameType downstream, ParameterMapType parameterMap, ConnectionNameType name )
 {
-  if( !this->ComponentExists( upstream ) || !this->ComponentExists( downstream ) )
+  return this->SetSharedConnection( std::move( upstream ), std::move( downstream ), std::make_shared< const ParameterMapType >( std::move( parameterMap ) ),
+    std::move( name ) );
+}
+
+
+bool
+BlueprintImpl
+::SetSharedConnection( ComponentNameType upstream, ComponentNameType downstream, ParameterMapPointer parameterMap, ConnectionNameType name )
+{
+  const ComponentIndexType upstreamIndex   = this->GetComponentIndex( upstream );
+  const ComponentIndexType downstreamIndex = this->GetComponentIndex( downstream );
+  if( upstreamIndex == NullComponentIndex || downstreamIndex == NullComponentIndex )
   {
     this->m_LoggerImpl->Log(LogLevel::WRN, "Setting a connection between components '{}' and '{}' failed: one or more components do not exist", upstream, downstream);
     return false;
   }
 
   // Multiple parallel connections are allowed. If a connection with the name "name" exists it should be overridden, otherwise just added.
-    
-  boost::graph_traits<GraphType>::out_edge_iterator ei, ei_end;
-  // too bad edge_range_by_label doesn't exist
-  boost::tie(ei, ei_end) = boost::edge_range(this->m_Graph.vertex(upstream), this->m_Graph.vertex(downstream), this->m_Graph.graph());
-
-  for (; ei != ei_end; ++ei) 
+  const ConnectionIndexType index = this->FindConnection( upstream, downstream, name );
+  if( index != NullConnectionIndex )
   {
-    auto existingName = boost::get(&ConnectionPropertyType::name, this->m_Graph.graph(), *ei);
-    if (name == existingName)
+    // override previous parameterMap
+    ConnectionPropertyType & connection = this->m_Graph.connections[ index ];
+    if( connection.parameterMap != parameterMap && *connection.parameterMap != *parameterMap )
     {
-      // override previous parameterMap
-      boost::put(&ConnectionPropertyType::parameterMap, this->m_Graph.graph(), *ei, parameterMap);
-      return true;
+      connection.parameterMap = std::move( parameterMap );
+      connection.modifiedTime = this->Modified();
     }
-  }// no existing connections named "name" were found.
- 
-  boost::add_edge_by_label(upstream, downstream, { name, parameterMap }, this->m_Graph);
+    return true;
+  } // no existing connections named "name" were found.
+
+  const ConnectionIndexType newIndex = this->m_Graph.connections.size();
+  this->m_Graph.connectionIndices.emplace( std::make_tuple( upstreamIndex, downstreamIndex, name ), newIndex );
+  this->m_Graph.connections.emplace_back( std::move( name ), std::move( parameterMap ), this->Modified(), upstreamIndex, downstreamIndex );
+  InsertConnection( this->m_Graph.outputs, upstreamIndex, newIndex, &ConnectionPropertyType::downstream, this->m_Graph.connections );
+  InsertConnection( this->m_Graph.inputs, downstreamIndex, newIndex, &ConnectionPropertyType::upstream, this->m_Graph.connections );
   return true;
 }
 
@@ -195,46 +205,31 @@ BlueprintImpl::ParameterMapType
 BlueprintImpl
 ::GetConnection( ComponentNameType upstream, ComponentNameType downstream, ConnectionNameType name ) const
 {
-  // This function assumes the connection exists.
-
-  boost::graph_traits<GraphType>::out_edge_iterator ei, ei_end;
-  // too bad edge_range_by_label doesn't exist
-  boost::tie(ei, ei_end) = boost::edge_range(this->m_Graph.vertex(upstream), this->m_Graph.vertex(downstream), this->m_Graph.graph());
-
-  for (; ei != ei_end; ++ei)
+  const ConnectionIndexType index = this->FindConnection( upstream, downstream, name );
+  if( index == NullConnectionIndex )
   {
-    auto existingName = boost::get(&ConnectionPropertyType::name, this->m_Graph.graph(), *ei);
-    if (name == existingName)
-    {
-      return boost::get(&ConnectionPropertyType::parameterMap, this->m_Graph.graph(), *ei);
-    }
-  } // no existing connections named "name" were found.
-  
-  throw std::runtime_error( "BlueprintImpl does not contain connection from component " + upstream + " to " + downstream + " by name " + name );
-  // assert(false);
-  return ParameterMapType();
+    throw std::runtime_error( "BlueprintImpl does not contain connection from component " + upstream + " to " + downstream + " by name " + name );
+  }
+  return *this->m_Graph.connections[ index ].parameterMap;
 } 
 
 bool
 BlueprintImpl
 ::DeleteConnection( BlueprintImpl::ComponentNameType upstream, BlueprintImpl::ComponentNameType downstream, ConnectionNameType name )
 {
-  if( this->ConnectionExists( upstream, downstream, name ) )
+  const ConnectionIndexType index = this->FindConnection( upstream, downstream, name );
+  if( index == NullConnectionIndex )
   {
-    boost::graph_traits<GraphType>::out_edge_iterator ei, ei_end;
-    // too bad edge_range_by_label doesn't exist
-    boost::tie(ei, ei_end) = boost::edge_range(this->m_Graph.vertex(upstream), this->m_Graph.vertex(downstream), this->m_Graph.graph());
-    for (; ei != ei_end; ++ei) {
-      auto existingName = boost::get(&ConnectionPropertyType::name, this->m_Graph.graph(), *ei);
-      if (name == existingName)
-      {
-        boost::remove_edge(*ei, this->m_Graph.graph());
-        return true;
-      }
-    }
+    return false;
   }
 
-  return false;
+  // The components at both ends were configured with this connection
+  const ModifiedTimeType modifiedTime = this->Modified();
+  this->m_Graph.components[ this->m_Graph.connections[ index ].upstream ].modifiedTime = modifiedTime;
+  this->m_Graph.components[ this->m_Graph.connections[ index ].downstream ].modifiedTime = modifiedTime;
+  this->m_Graph.connections.erase( this->m_Graph.connections.begin() + index );
+  this->RebuildConnectionIndices();
+  return true;
 }
 
 
@@ -242,7 +237,7 @@ bool
 BlueprintImpl
 ::ComponentExists( ComponentNameType componentName ) const
 {
-  return this->m_Graph.vertex( componentName ) != boost::graph_traits< GraphType >::null_vertex();
+  return this->m_Graph.componentIndices.count( componentName ) > 0;
 }
 
 
@@ -250,32 +245,7 @@ bool
 BlueprintImpl
 ::ConnectionExists( ComponentNameType upstream, ComponentNameType downstream, ConnectionNameType name ) const
 {
-  if( !this->ComponentExists( upstream ) )
-  {
-    return false;
-  }
-  if( !this->ComponentExists( downstream ) )
-  {
-    return false;
-  }
-
-  if (boost::edge_by_label( upstream, downstream, this->m_Graph ).second)
-  {
-    boost::graph_traits<GraphType>::out_edge_iterator ei, ei_end;
-    // too bad edge_range_by_label doesn't exist
-    boost::tie(ei, ei_end) = boost::edge_range(this->m_Graph.vertex(upstream), this->m_Graph.vertex(downstream), this->m_Graph.graph());
-
-    for (; ei != ei_end; ++ei)
-    {
-      auto existingName = boost::get(&ConnectionPropertyType::name, this->m_Graph.graph(), *ei);
-      if (name == existingName)
-      {
-        return true;
-      }
-    }
-  } // no existing connections named "name" were found.
-
-  return false;
+  return this->FindConnection( upstream, downstream, name ) != NullConnectionIndex;
 }
 
 
@@ -283,126 +253,115 @@ bool
 BlueprintImpl
 ::ComposeWith( const BlueprintImpl & other )
 {
-  // Make a backup of the current blueprint status in case composition fails
-  GraphType graph_backup = GraphType( this->m_Graph );
-
-  // Copy-in all components (Nodes)
-  for( auto const & componentName : other.GetComponentNames() )
-  {
-    // Does other blueprint use component with a name that already exists?
-    if( this->ComponentExists( componentName ) )
-    {
-      // Component exists, check if properties can be merged
-      auto ownProperties    = this->GetComponent( componentName );
-      auto othersProperties = other.GetComponent( componentName );
+  // Whether the properties of other can be added to own properties, i.e. other does not redefine any of them
+  auto canCompose = []( const ParameterMapPointer & ownProperties, const ParameterMapPointer & othersProperties ) {
+      if( ownProperties == othersProperties )
+      {
+        return true;
+      }
+      for( auto const & othersEntry : *othersProperties )
+      {
+        auto ownEntry = ownProperties->find( othersEntry.first );
+        if( ownEntry != ownProperties->end() && ownEntry->second != othersEntry.second )
+        {
+          return false;
+        }
+      }
+      return true;
+    };
 
-      for( auto const & othersEntry : othersProperties )
+  // Add the properties of other that own properties do not have yet. Own properties are copied only if other adds any.
+  auto compose = []( ParameterMapPointer & ownProperties, const ParameterMapPointer & othersProperties ) {
+      std::shared_ptr< ParameterMapType > composedProperties;
+      if( ownProperties != othersProperties )
       {
-        // Does other use a property key that already exists in this component?
-        if( ownProperties.count( othersEntry.first ) )
+        for( auto const & othersEntry : *othersProperties )
         {
-          auto && ownValues   = ownProperties[ othersEntry.first ];
-          auto && otherValues = othersEntry.second;
-          // Are the property values equal?
-          if( ownValues.size() != otherValues.size() )
-          {
-            // No, based on the number of values we see that it is different. Blueprints cannot be Composed
-            this->m_Graph = graph_backup;
-            return false;
-          }
-          else
+          if( ownProperties->count( othersEntry.first ) == 0 )
           {
-            ParameterValueType::const_iterator ownValue;
-            ParameterValueType::const_iterator otherValue;
-            for( ownValue = ownValues.begin(), otherValue = otherValues.begin(); ownValue != ownValues.end(); ++ownValue, ++otherValue )
+            if( !composedProperties )
             {
-              if( *otherValue != *ownValue )
-              {
-                // No, at least one value is different. Blueprints cannot be Composed
-                this->m_Graph = graph_backup;
-                return false;
-              }
+              composedProperties = std::make_shared< ParameterMapType >( *ownProperties );
             }
+            composedProperties->insert( othersEntry );
           }
         }
-        else
-        {
-          // Property key doesn't exist yet, add entry to this component
-          auto ownProperties = this->GetComponent( componentName );
-          ownProperties[ othersEntry.first ] = othersEntry.second;
-          this->SetComponent( componentName, ownProperties );
-        }
       }
+      if( !composedProperties )
+      {
+        return false;
+      }
+      ownProperties = std::move( composedProperties );
+      return true;
+    };
+
+  // Check all of other before anything is added, such that a failing composition leaves this blueprint as it was
+  for( auto const & othersReplication : other.m_Replications )
+  {
+    // Replications cannot be redefined either
+    auto ownReplication = this->m_Replications.find( othersReplication.first );
+    if( ownReplication != this->m_Replications.end()
+      && ( ownReplication->second.componentNames != othersReplication.second.componentNames
+      || ownReplication->second.numberOfReplicas != othersReplication.second.numberOfReplicas ) )
+    {
+      return false;
     }
-    else
+  }
+  for( auto const & othersComponent : other.m_Graph.components )
+  {
+    const ComponentIndexType index = this->GetComponentIndex( othersComponent.name );
+    if( index != NullComponentIndex && !canCompose( this->m_Graph.components[ index ].parameterMap, othersComponent.parameterMap ) )
     {
-      // Create Component copying properties of other
-      this->SetComponent( componentName, other.GetComponent( componentName ) );
+      return false;
     }
   }
-  // Copy-in all connections (Edges)
-  for( auto const & componentName : other.GetComponentNames() )
+  for( auto const & othersConnection : other.m_Graph.connections )
   {
-    for( auto incomingName : other.GetInputNames( componentName ) )
+    const ConnectionIndexType index = this->FindConnection( other.m_Graph.components[ othersConnection.upstream ].name,
+      other.m_Graph.components[ othersConnection.downstream ].name, othersConnection.name );
+    if( index != NullConnectionIndex && !canCompose( this->m_Graph.connections[ index ].parameterMap, othersConnection.parameterMap ) )
     {
-      for (auto connectionName : other.GetConnectionNames(incomingName, componentName ) )
-      {
-        // Does other blueprint have a connection that already exists?
-        if (this->ConnectionExists(incomingName, componentName, connectionName ))
-        {
-          // Connection exists, check if properties can be merged
-          auto ownProperties    = this->GetConnection( incomingName, componentName, connectionName );
-          auto othersProperties = other.GetConnection( incomingName, componentName, connectionName );
+      return false;
+    }
+  }
 
-          for( auto const & othersEntry : othersProperties )
-          {
-            // Does other use a property key that already exists in this component?
-            if( ownProperties.count( othersEntry.first ) )
-            {
-              auto && ownValues   = ownProperties[ othersEntry.first ];
-              auto && otherValues = othersEntry.second;
-              // Are the property values equal?
-              if( ownValues.size() != otherValues.size() )
-              {
-                // No, based on the number of values we see that it is different. Blueprints cannot be Composed
-                this->m_Graph = graph_backup;
-                return false;
-              }
-              else
-              {
-                ParameterValueType::const_iterator ownValue;
-                ParameterValueType::const_iterator otherValue;
-                for( ownValue = ownValues.begin(), otherValue = otherValues.begin(); ownValue != ownValues.end(); ++ownValue, ++otherValue )
-                {
-                  if( *otherValue != *ownValue )
-                  {
-                    // No, at least one value is different. Blueprints cannot be Composed
-                    this->m_Graph = graph_backup;
-                    return false;
-                  }
-                }
-              }
-            }
-            else
-            {
-              // Property key doesn't exist yet, add entry to this component
-              auto ownProperties = this->GetConnection( incomingName, componentName, connectionName );
-              ownProperties[ othersEntry.first ] = othersEntry.second;
-              this->SetConnection( incomingName, componentName, ownProperties, connectionName );
-              return true;
-            }
-          } // end loop otherProperties
-        }
-        else // connection with connectionName does not exist
-        {
-          // Create Connection copying properties of other
-          this->SetConnection( incomingName, componentName, other.GetConnection( incomingName, componentName, connectionName ),  connectionName );
-        }
-      }
+  for( auto const & othersReplication : other.m_Replications )
+  {
+    this->SetReplication( othersReplication.first, othersReplication.second.componentNames, othersReplication.second.numberOfReplicas );
+  }
+
+  // Copy-in all components (Nodes)
+  for( auto const & othersComponent : other.m_Graph.components )
+  {
+    const ComponentIndexType index = this->GetComponentIndex( othersComponent.name );
+    if( index == NullComponentIndex )
+    {
+      // Create Component sharing the properties of other
+      this->SetSharedComponent( othersComponent.name, othersComponent.parameterMap );
+    }
+    else if( compose( this->m_Graph.components[ index ].parameterMap, othersComponent.parameterMap ) )
+    {
+      this->m_Graph.components[ index ].modifiedTime = this->Modified();
     }
   }
 
-  
+  // Copy-in all connections (Edges)
+  for( auto const & othersConnection : other.m_Graph.connections )
+  {
+    const ComponentNameType & upstream   = other.m_Graph.components[ othersConnection.upstream ].name;
+    const ComponentNameType & downstream = other.m_Graph.components[ othersConnection.downstream ].name;
+    const ConnectionIndexType index      = this->FindConnection( upstream, downstream, othersConnection.name );
+    if( index == NullConnectionIndex )
+    {
+      // Create Connection sharing the properties of other
+      this->SetSharedConnection( upstream, downstream, othersConnection.parameterMap, othersConnection.name );
+    }
+    else if( compose( this->m_Graph.connections[ index ].parameterMap, othersConnection.parameterMap ) )
+    {
+      this->m_Graph.connections[ index ].modifiedTime = this->Modified();
+    }
+  }
+  return true;
 }
 
 BlueprintImpl::ComponentNamesType
@@ -410,12 +369,9 @@ BlueprintImpl
 ::GetInputNames( const ComponentNameType name ) const
 {
   ComponentNamesType container;
-  //auto vertex = this->m_Graph.vertex(name);
-  //boost::in_edges(vertex, this->m_Graph);
-  InputIteratorPairType inputIteratorPair = boost::in_edges( this->m_Graph.vertex( name ), this->m_Graph );
-  for( auto it = inputIteratorPair.first; it != inputIteratorPair.second; ++it )
+  for( auto const & connection : this->GetInputConnections( this->GetComponentIndex( name ) ) )
   {
-    container.push_back( this->m_Graph.graph()[ it->m_source ].name );
+    container.push_back( this->m_Graph.components[ this->m_Graph.connections[ connection ].upstream ].name );
   }
 
   return container;
@@ -426,29 +382,363 @@ BlueprintImpl::ComponentNamesType
 BlueprintImpl
 ::GetOutputNames( const ComponentNameType name ) const
 {
-  ComponentNamesType     container;
-  OutputIteratorPairType outputIteratorPair = boost::out_edges( this->m_Graph.vertex( name ), this->m_Graph );
-  for( auto it = outputIteratorPair.first; it != outputIteratorPair.second; ++it )
+  ComponentNamesType container;
+  for( auto const & connection : this->GetOutputConnections( this->GetComponentIndex( name ) ) )
   {
-    container.push_back( this->m_Graph.graph()[ it->m_target ].name );
+    container.push_back( this->m_Graph.components[ this->m_Graph.connections[ connection ].downstream ].name );
   }
 
   return container;
 }
 
+BlueprintImpl::ModifiedTimeType
+BlueprintImpl
+::GetComponentModifiedTime( ComponentNameType componentName ) const
+{
+  const ComponentIndexType index = this->GetComponentIndex( componentName );
+  if( index == NullComponentIndex )
+  {
+    throw std::runtime_error( "BlueprintImpl does not contain component " + componentName );
+  }
+  return this->m_Graph.components[ index ].modifiedTime;
+}
+
+
+BlueprintImpl::ModifiedTimeType
+BlueprintImpl
+::GetConnectionModifiedTime( ComponentNameType upstream, ComponentNameType downstream, ConnectionNameType name ) const
+{
+  const ConnectionIndexType index = this->FindConnection( upstream, downstream, name );
+  if( index == NullConnectionIndex )
+  {
+    throw std::runtime_error( "BlueprintImpl does not contain connection from component " + upstream + " to " + downstream + " by name " + name );
+  }
+  return this->m_Graph.connections[ index ].modifiedTime;
+}
+
+
+BlueprintImpl::ComponentIndexType
+BlueprintImpl
+::GetComponentIndex( const ComponentNameType & componentName ) const
+{
+  auto componentIndex = this->m_Graph.componentIndices.find( componentName );
+  return componentIndex == this->m_Graph.componentIndices.end() ? NullComponentIndex : componentIndex->second;
+}
+
+
+BlueprintImpl::ConnectionIndexRangeType
+BlueprintImpl
+::GetInputConnections( ComponentIndexType index ) const
+{
+  if( index >= this->m_Graph.components.size() )
+  {
+    throw std::runtime_error( "BlueprintImpl does not contain component " + std::to_string( index ) );
+  }
+  const ConnectionIndexType * connections = this->m_Graph.inputs.connections.data();
+  return { connections + this->m_Graph.inputs.offsets[ index ], connections + this->m_Graph.inputs.offsets[ index + 1 ] };
+}
+
+
+BlueprintImpl::ConnectionIndexRangeType
+BlueprintImpl
+::GetOutputConnections( ComponentIndexType index ) const
+{
+  if( index >= this->m_Graph.components.size() )
+  {
+    throw std::runtime_error( "BlueprintImpl does not contain component " + std::to_string( index ) );
+  }
+  const ConnectionIndexType * connections = this->m_Graph.outputs.connections.data();
+  return { connections + this->m_Graph.outputs.offsets[ index ], connections + this->m_Graph.outputs.offsets[ index + 1 ] };
+}
+
+
+BlueprintImpl::ConnectionIndexType
+BlueprintImpl
+::FindConnection( const ComponentNameType & upstream, const ComponentNameType & downstream, const ConnectionNameType & name ) const
+{
+  const ComponentIndexType upstreamIndex   = this->GetComponentIndex( upstream );
+  const ComponentIndexType downstreamIndex = this->GetComponentIndex( downstream );
+  if( upstreamIndex == NullComponentIndex || downstreamIndex == NullComponentIndex )
+  {
+    return NullConnectionIndex;
+  }
+  auto connectionIndex = this->m_Graph.connectionIndices.find( std::forward_as_tuple( upstreamIndex, downstreamIndex, name ) );
+  return connectionIndex == this->m_Graph.connectionIndices.end() ? NullConnectionIndex : connectionIndex->second;
+}
+
+
+void
+BlueprintImpl
+::InsertConnection( AdjacencyType & adjacency, ComponentIndexType component, ConnectionIndexType connection,
+  ComponentIndexType ConnectionPropertyType::* otherEnd, const std::deque< ConnectionPropertyType > & connections )
+{
+  // The new connection has the highest index, so it goes after the connections with the same other end
+  auto begin    = adjacency.connections.begin() + adjacency.offsets[ component ];
+  auto end      = adjacency.connections.begin() + adjacency.offsets[ component + 1 ];
+  auto position = std::upper_bound( begin, end, connection, [ &connections, otherEnd ]( ConnectionIndexType first, ConnectionIndexType second ) {
+      return connections[ first ].*otherEnd < connections[ second ].*otherEnd;
+    } );
+  adjacency.connections.insert( position, connection );
+  for( auto offset = adjacency.offsets.begin() + component + 1; offset != adjacency.offsets.end(); ++offset )
+  {
+    ++*offset;
+  }
+}
+
+
+void
+BlueprintImpl
+::RebuildConnectionIndices()
+{
+  // Counting sort of the connections by component, in the order of their other end and their index
+  auto rebuild = [ this ]( AdjacencyType & adjacency, ComponentIndexType ConnectionPropertyType::* end,
+    ComponentIndexType ConnectionPropertyType::* otherEnd ) {
+      const auto & connections = this->m_Graph.connections;
+      std::vector< ConnectionIndexType > connectionsByOtherEnd( connections.size() );
+      for( ConnectionIndexType index = 0; index < connections.size(); ++index )
+      {
+        connectionsByOtherEnd[ index ] = index;
+      }
+      std::stable_sort( connectionsByOtherEnd.begin(), connectionsByOtherEnd.end(), [ &connections, otherEnd ]( ConnectionIndexType first, ConnectionIndexType second ) {
+          return connections[ first ].*otherEnd < connections[ second ].*otherEnd;
+        } );
+
+      adjacency.offsets.assign( this->m_Graph.components.size() + 1, 0 );
+      for( auto const & connection : connections )
+      {
+        ++adjacency.offsets[ connection.*end + 1 ];
+      }
+      for( std::size_t component = 0; component < this->m_Graph.components.size(); ++component )
+      {
+        adjacency.offsets[ component + 1 ] += adjacency.offsets[ component ];
+      }
+      adjacency.connections.resize( connections.size() );
+      std::vector< std::size_t > positions( adjacency.offsets.begin(), adjacency.offsets.end() - 1 );
+      for( auto const & index : connectionsByOtherEnd )
+      {
+        adjacency.connections[ positions[ connections[ index ].*end ]++ ] = index;
+      }
+    };
+  rebuild( this->m_Graph.outputs, &ConnectionPropertyType::upstream, &ConnectionPropertyType::downstream );
+  rebuild( this->m_Graph.inputs, &ConnectionPropertyType::downstream, &ConnectionPropertyType::upstream );
+
+  this->m_Graph.connectionIndices.clear();
+  for( ConnectionIndexType index = 0; index < this->m_Graph.connections.size(); ++index )
+  {
+    const ConnectionPropertyType & connection = this->m_Graph.connections[ index ];
+    this->m_Graph.connectionIndices.emplace( std::make_tuple( connection.upstream, connection.downstream, connection.name ), index );
+  }
+}
+
+
+bool
+BlueprintImpl
+::SetReplication( ReplicationNameType name, ComponentNamesType componentNames, std::size_t numberOfReplicas )
+{
+  if( numberOfReplicas == 0 )
+  {
+    this->m_LoggerImpl->Log( LogLevel::WRN, "Setting replication '{0}' failed: the number of replicas must be at least 1", name );
+    return false;
+  }
+
+  auto replication = this->m_Replications.find( name );
+  if( replication == this->m_Replications.end()
+    || replication->second.componentNames != componentNames || replication->second.numberOfReplicas != numberOfReplicas )
+  {
+    this->m_Replications[ name ] = { componentNames, numberOfReplicas };
+    this->Modified();
+  }
+  return true;
+}
+
+
+bool
+BlueprintImpl
+::DeleteReplication( ReplicationNameType name )
+{
+  if( this->m_Replications.erase( name ) > 0 )
+  {
+    this->Modified();
+    return true;
+  }
+  return false;
+}
+
+
+BlueprintImpl::ComponentNameType
+BlueprintImpl
+::GetReplicaName( const ComponentNameType & componentName, std::size_t index )
+{
+  return componentName + "_" + std::to_string( index );
+}
+
+
+bool
+BlueprintImpl
+::ReplicateInto( BlueprintImpl & replicated ) const
+{
+  // The replication of each replicated component
+  std::map< ComponentNameType, ReplicationsType::const_iterator > replicationOfComponent;
+  for( auto replication = this->m_Replications.begin(); replication != this->m_Replications.end(); ++replication )
+  {
+    for( auto const & componentName : replication->second.componentNames )
+    {
+      if( !this->ComponentExists( componentName ) )
+      {
+        this->m_LoggerImpl->Log( LogLevel::ERR, "Replicating blueprint failed: replication '{0}' refers to component '{1}' that does not exist",
+          replication->first, componentName );
+        return false;
+      }
+      if( !replicationOfComponent.insert( { componentName, replication } ).second )
+      {
+        this->m_LoggerImpl->Log( LogLevel::ERR, "Replicating blueprint failed: component '{0}' is part of more than one replication", componentName );
+        return false;
+      }
+    }
+  }
+
+  // Expand the replications in a separate blueprint, such that replicated is only modified if the expansion succeeds
+  BlueprintImpl expanded( *this->m_LoggerImpl );
+  for( auto const & componentName : this->GetComponentNames() )
+  {
+    auto replication = replicationOfComponent.find( componentName );
+    if( replication == replicationOfComponent.end() )
+    {
+      expanded.SetSharedComponent( componentName, this->m_Graph.components[ this->GetComponentIndex( componentName ) ].parameterMap );
+      continue;
+    }
+    for( std::size_t index = 0; index < replication->second->second.numberOfReplicas; ++index )
+    {
+      const ComponentNameType replicaName = GetReplicaName( componentName, index );
+      if( this->ComponentExists( replicaName ) )
+      {
+        this->m_LoggerImpl->Log( LogLevel::ERR, "Replicating blueprint failed: replica name '{0}' is used by another component", replicaName );
+        return false;
+      }
+      expanded.SetSharedComponent( replicaName, this->m_Graph.components[ this->GetComponentIndex( componentName ) ].parameterMap );
+    }
+  }
+
+  for( auto const & connection : this->m_Graph.connections )
+  {
+    const ComponentNameType &      upstream              = this->m_Graph.components[ connection.upstream ].name;
+    const ComponentNameType &      downstream            = this->m_Graph.components[ connection.downstream ].name;
+    auto                           upstreamReplication   = replicationOfComponent.find( upstream );
+    auto                           downstreamReplication = replicationOfComponent.find( downstream );
+
+    if( upstreamReplication != replicationOfComponent.end()
+      && ( downstreamReplication == replicationOfComponent.end() || downstreamReplication->second != upstreamReplication->second ) )
+    {
+      this->m_LoggerImpl->Log( LogLevel::ERR, "Replicating blueprint failed: connection from '{0}' to '{1}' leaves replication '{2}'",
+        upstream, downstream, upstreamReplication->second->first );
+      return false;
+    }
+
+    if( downstreamReplication == replicationOfComponent.end() )
+    {
+      expanded.SetSharedConnection( upstream, downstream, connection.parameterMap, connection.name );
+    }
+    else
+    {
+      // Connections into the replication are shared by all replicas, connections within it are cloned per replica
+      for( std::size_t index = 0; index < downstreamReplication->second->second.numberOfReplicas; ++index )
+      {
+        const ComponentNameType replicaUpstream = upstreamReplication == replicationOfComponent.end() ? upstream : GetReplicaName( upstream, index );
+        expanded.SetSharedConnection( replicaUpstream, GetReplicaName( downstream, index ), connection.parameterMap, connection.name );
+      }
+    }
+  }
+
+  // Components cannot be removed from the graph one by one, so if any component is removed all components are added
+  // anew. The modified time of replicated keeps increasing.
+  bool isComponentRemoved = false;
+  for( auto const & componentName : replicated.GetComponentNames() )
+  {
+    isComponentRemoved = isComponentRemoved || !expanded.ComponentExists( componentName );
+  }
+  if( isComponentRemoved )
+  {
+    replicated.m_Graph = GraphType();
+    replicated.Modified();
+  }
+  else
+  {
+    std::vector< std::tuple< ComponentNameType, ComponentNameType, ConnectionNameType > > removedConnections;
+    for( auto const & connection : replicated.m_Graph.connections )
+    {
+      const ComponentNameType & upstream   = replicated.m_Graph.components[ connection.upstream ].name;
+      const ComponentNameType & downstream = replicated.m_Graph.components[ connection.downstream ].name;
+      if( !expanded.ConnectionExists( upstream, downstream, connection.name ) )
+      {
+        removedConnections.emplace_back( upstream, downstream, connection.name );
+      }
+    }
+    for( auto const & removedConnection : removedConnections )
+    {
+      replicated.DeleteConnection( std::get< 0 >( removedConnection ), std::get< 1 >( removedConnection ), std::get< 2 >( removedConnection ) );
+    }
+  }
+
+  for( auto const & component : expanded.m_Graph.components )
+  {
+    replicated.SetSharedComponent( component.name, component.parameterMap );
+  }
+  for( auto const & connection : expanded.m_Graph.connections )
+  {
+    replicated.SetSharedConnection( expanded.m_Graph.components[ connection.upstream ].name, expanded.m_Graph.components[ connection.downstream ].name,
+      connection.parameterMap, connection.name );
+  }
+  return true;
+}
+
+
 BlueprintImpl::ComponentNamesType
 BlueprintImpl
 ::GetUpdateOrder() const
 {
-  ComponentNamesType     container;
- 
-  std::vector< ComponentIndexType > indexContainer;
-  
-  boost::topological_sort(this->m_Graph, std::back_inserter(indexContainer));
+  // Reverse postorder of a depth first search from the components in their order, as boost::topological_sort
+  enum class ColorType { White, Gray, Black };
+  std::vector< ColorType > colors( this->m_Graph.components.size(), ColorType::White );
+  std::vector< ComponentIndexType > finished;
+  finished.reserve( this->m_Graph.components.size() );
+  std::vector< std::pair< ComponentIndexType, const ConnectionIndexType * > > stack;
+  for( ComponentIndexType root = 0; root < this->m_Graph.components.size(); ++root )
+  {
+    if( colors[ root ] != ColorType::White )
+    {
+      continue;
+    }
+    colors[ root ] = ColorType::Gray;
+    stack.emplace_back( root, this->GetOutputConnections( root ).begin() );
+    while( !stack.empty() )
+    {
+      const ComponentIndexType component = stack.back().first;
+      const ConnectionIndexType * & next = stack.back().second;
+      if( next == this->GetOutputConnections( component ).end() )
+      {
+        colors[ component ] = ColorType::Black;
+        finished.push_back( component );
+        stack.pop_back();
+        continue;
+      }
+      const ComponentIndexType downstream = this->m_Graph.connections[ *next++ ].downstream;
+      if( colors[ downstream ] == ColorType::Gray )
+      {
+        throw std::invalid_argument( "The graph must be a DAG." );
+      }
+      if( colors[ downstream ] == ColorType::White )
+      {
+        colors[ downstream ] = ColorType::Gray;
+        stack.emplace_back( downstream, this->GetOutputConnections( downstream ).begin() );
+      }
+    }
+  }
 
-  for (std::vector< ComponentIndexType >::reverse_iterator ii = indexContainer.rbegin(); ii != indexContainer.rend(); ++ii)
+  ComponentNamesType container;
+  container.reserve( finished.size() );
+  for( auto component = finished.rbegin(); component != finished.rend(); ++component )
   {
-    container.push_back(boost::get(boost::vertex_all, this->m_Graph, *ii).name);
+    container.push_back( this->m_Graph.components[ *component ].name );
   }
   return container;
 }
@@ -460,13 +750,13 @@ BlueprintImpl
 {
   ConnectionNamesType     container;
 
-  boost::graph_traits<GraphType>::out_edge_iterator ei, ei_end;
-  // too bad edge_range_by_label doesn't exist
-  boost::tie(ei, ei_end) = boost::edge_range(this->m_Graph.vertex(upstream), this->m_Graph.vertex(downstream), this->m_Graph.graph());
-
-  for (; ei != ei_end; ++ei)
+  const ComponentIndexType downstreamIndex = this->GetComponentIndex( downstream );
+  for( auto const & connection : this->GetOutputConnections( this->GetComponentIndex( upstream ) ) )
   {
-    container.push_back(boost::get(&ConnectionPropertyType::name, this->m_Graph.graph(), *ei));
+    if( this->m_Graph.connections[ connection ].downstream == downstreamIndex )
+    {
+      container.push_back( this->m_Graph.connections[ connection ].name );
+    }
   }
   return container;
 }
@@ -477,11 +767,19 @@ void
 BlueprintImpl
 ::Write( const std::string filename )
 {
+  // Graphviz dot file, labeled as by boost::write_graphviz
   std::ofstream dotfile( filename.c_str() );
-  boost::write_graphviz( dotfile, this->m_Graph,
-    make_vertex_label_writer( boost::get( &ComponentPropertyType::name, this->m_Graph ),
-    boost::get( &ComponentPropertyType::parameterMap, this->m_Graph ) ),
-    make_edge_label_writer( boost::get( &ConnectionPropertyType::parameterMap, this->m_Graph ) ) );
+  dotfile << "digraph G {" << std::endl;
+  for( ComponentIndexType index = 0; index < this->m_Graph.components.size(); ++index )
+  {
+    const ComponentPropertyType & component = this->m_Graph.components[ index ];
+    dotfile << index << "[label=\"" << component.name << "\n" << *component.parameterMap << "\"];" << std::endl;
+  }
+  for( auto const & connection : this->m_Graph.connections )
+  {
+    dotfile << connection.upstream << "->" << connection.downstream << " [label=\"" << *connection.parameterMap << "\"];" << std::endl;
+  }
+  dotfile << "}" << std::endl;
 }
 
 BlueprintImpl::ParameterValueType
@@ -507,29 +805,117 @@ BlueprintImpl::VectorizeValues(ComponentOrConnectionTreeType & componentOrConnec
   return propertyMultiValue;
 }
 
+void
+BlueprintImpl
+::WriteBinary( const std::string & filename ) const
+{
+  BlueprintSections sections;
+  for( auto const & component : this->m_Graph.components )
+  {
+    sections.components.push_back( { component.name, component.parameterMap } );
+  }
+  for( auto const & connection : this->m_Graph.connections )
+  {
+    sections.connections.push_back( { this->m_Graph.components[ connection.upstream ].name, this->m_Graph.components[ connection.downstream ].name,
+                                      connection.name, connection.parameterMap } );
+  }
+  for( auto const & replication : this->m_Replications )
+  {
+    sections.replications.push_back( { replication.first, replication.second.componentNames, replication.second.numberOfReplicas } );
+  }
+  BlueprintBinaryFormat::Write( sections, filename );
+}
+
 void
 BlueprintImpl::MergeFromFile(const std::string & fileNameString)
 {
-  PathType fileName(fileNameString);
+  // All files are read before any of them is merged, such that the includes of a file can be read concurrently
+  this->MergeIncludeTree(this->ReadIncludeTree(PathType(fileNameString), PathsType()));
+}
+
+BlueprintImpl::IncludeTreeType
+BlueprintImpl::ReadIncludeTree(const PathType & fileName, const PathsType & includingFiles)
+{
+  boost::system::error_code error;
+  PathType canonicalFileName = boost::filesystem::canonical(fileName, error);
+  if (error)
+  {
+    // Reading the file will fail and tell why
+    canonicalFileName = boost::filesystem::absolute(fileName);
+  }
+  if (std::find(includingFiles.begin(), includingFiles.end(), canonicalFileName) != includingFiles.end())
+  {
+    std::string cycle;
+    for (auto const & includingFile : includingFiles)
+    {
+      cycle += includingFile.string() + " -> ";
+    }
+    cycle += canonicalFileName.string();
+    this->m_LoggerImpl->Log(LogLevel::ERR, "Blueprint files include each other: {0}", cycle);
+    throw std::runtime_error("Blueprint files include each other: " + cycle);
+  }
 
+  IncludeTreeType includeTree;
+  includeTree.fileName = fileName;
+  std::vector< PathType > includePaths;
   this->m_LoggerImpl->Log(LogLevel::INF, "Loading {0} ... ", fileName);
-  auto propertyTree = ReadPropertyTree(fileName);
+  if (fileName.extension() == BlueprintBinaryFormat::Extension || fileName.extension() == ".json")
+  {
+    includeTree.sections = BlueprintFileCache::GetDefault().Read(fileName.string(), *this->m_LoggerImpl);
+    includePaths.assign(includeTree.sections->includes.begin(), includeTree.sections->includes.end());
+  }
+  else
+  {
+    includeTree.propertyTree = this->ReadPropertyTree(fileName);
+    auto includesList = this->FindIncludes(includeTree.propertyTree);
+    includePaths.assign(includesList.begin(), includesList.end());
+  }
   this->m_LoggerImpl->Log(LogLevel::INF, "Loading {0} ... Done", fileName);
 
+  if (includePaths.empty())
+  {
+    return includeTree;
+  }
+
   this->m_LoggerImpl->Log(LogLevel::INF, "Checking {0} for include files ... ", fileName);
-  auto includesList = FindIncludes(propertyTree);
+  PathsType includingFilesAndThis = includingFiles;
+  includingFilesAndThis.push_back(canonicalFileName);
 
-  if (includesList.size() > 0)
+  // The first include is read by this thread, the others each by a thread of their own. If this thread throws, the
+  // destructors of the futures wait for the others.
+  std::vector< std::future< IncludeTreeType > > includeFutures;
+  for (std::size_t include = 1; include < includePaths.size(); ++include)
   {
-    for (auto const & includePath : includesList)
-    {
-      this->m_LoggerImpl->Log(LogLevel::INF, "Including file {0} ... ", includePath);
-      this->MergeFromFile(includePath.string());
-    }
+    this->m_LoggerImpl->Log(LogLevel::INF, "Including file {0} ... ", includePaths[include]);
+    includeFutures.push_back(std::async(std::launch::async, &BlueprintImpl::ReadIncludeTree, this, includePaths[include], includingFilesAndThis));
+  }
+  this->m_LoggerImpl->Log(LogLevel::INF, "Including file {0} ... ", includePaths.front());
+  includeTree.includes.reserve(includePaths.size());
+  includeTree.includes.push_back(this->ReadIncludeTree(includePaths.front(), includingFilesAndThis));
+  for (auto & includeFuture : includeFutures)
+  {
+    includeTree.includes.push_back(includeFuture.get());
   }
   this->m_LoggerImpl->Log(LogLevel::INF, "Checking {0} for include files ... done", fileName);
-  this->MergeProperties(propertyTree);
-  return;
+  return includeTree;
+}
+
+void
+BlueprintImpl::MergeIncludeTree(const IncludeTreeType & includeTree)
+{
+  for (auto const & include : includeTree.includes)
+  {
+    this->MergeIncludeTree(include);
+  }
+  if (includeTree.sections)
+  {
+    // The cached sections are shared, the blueprint shares their parameter maps
+    this->MergeSections(*includeTree.sections);
+  }
+  else
+  {
+    this->MergeProperties(includeTree.propertyTree);
+  }
 }
 
 void
@@ -568,7 +954,7 @@ BlueprintImpl::FindIncludes(const PropertyTreeType & propertyTree)
   {
     if (FoundIncludes)
     {
-      std::runtime_error("Only 1 listing of Includes is allowed per Blueprint file");
+      throw std::runtime_error("Only 1 listing of Includes is allowed per Blueprint file");
     }
 
     auto const pathsStrings = VectorizeValues(v.second);
@@ -581,16 +967,13 @@ BlueprintImpl::FindIncludes(const PropertyTreeType & propertyTree)
   return paths;
 }
 
-
-Blueprint::Pointer
-BlueprintImpl::FromPropertyTree(const PropertyTreeType & pt)
+void
+BlueprintImpl::MergeProperties(const PropertyTreeType & pt)
 {
-  Blueprint::Pointer blueprint = Blueprint::New();
-
   BOOST_FOREACH(const PropertyTreeType::value_type & v, pt.equal_range("Component"))
   {
     std::string      componentName;
-    ParameterMapType componentPropertyMap;
+    ParameterMapType newProperties;
     for (auto const & elm : v.second)
     {
       const std::string & componentKey = elm.first;
@@ -600,24 +983,19 @@ BlueprintImpl::FromPropertyTree(const PropertyTreeType & pt)
         continue;
       }
 
-      ParameterValueType propertyMultiValue = VectorizeValues(elm.second);
-      std::string        propertyKey = elm.first;
-      componentPropertyMap[propertyKey] = propertyMultiValue;
+      newProperties[componentKey] = VectorizeValues(elm.second);
     }
 
-    blueprint->SetComponent(componentName, componentPropertyMap);
+    this->MergeComponent(componentName, std::make_shared< const ParameterMapType >(std::move(newProperties)));
   }
 
   BOOST_FOREACH(const PropertyTreeType::value_type & v, pt.equal_range("Connection"))
   {
     std::string connectionName = v.second.data();
-    if (connectionName != "")
-    {
-      this->m_LoggerImpl->Log(LogLevel::TRC, "Found {0}, but connection names are ignored.", connectionName);
-    }
+
     std::string      outName;
     std::string      inName;
-    ParameterMapType componentPropertyMap;
+    ParameterMapType newProperties;
 
     for (auto const & elm : v.second)
     {
@@ -635,183 +1013,176 @@ BlueprintImpl::FromPropertyTree(const PropertyTreeType & pt)
       }
       else if (connectionKey == "Name")
       {
-        this->m_LoggerImpl->Log(LogLevel::WRN, "Connections with key 'Name' are ignored.");
+        if (connectionName != "")
+        {
+          this->m_LoggerImpl->Log(LogLevel::WRN, "Connection Name '{}' is overridden by '{}'", connectionName, elm.second.data());
+        }
+        connectionName = elm.second.data();
         continue;
       }
       else
       {
-        ParameterValueType propertyMultiValue = VectorizeValues(elm.second);
-        std::string        propertyKey = elm.first;
-        componentPropertyMap[propertyKey] = propertyMultiValue;
+        newProperties[connectionKey] = VectorizeValues(elm.second);
       }
     }
 
-    blueprint->SetConnection(outName, inName, componentPropertyMap);
+    this->MergeConnection(outName, inName, connectionName, std::make_shared< const ParameterMapType >(std::move(newProperties)));
   }
-  return blueprint;
-}
 
-void
-BlueprintImpl::MergeProperties(const PropertyTreeType & pt)
-{
-  BOOST_FOREACH(const PropertyTreeType::value_type & v, pt.equal_range("Component"))
+  BOOST_FOREACH(const PropertyTreeType::value_type & v, pt.equal_range("Replicate"))
   {
-    std::string      componentName;
-    ParameterMapType newProperties;
+    std::string        replicationName;
+    ComponentNamesType componentNames;
+    std::size_t        numberOfReplicas = 0;
     for (auto const & elm : v.second)
     {
-      const std::string & componentKey = elm.first;
-      if (componentKey == "Name")
+      const std::string & replicationKey = elm.first;
+      if (replicationKey == "Name")
       {
-        componentName = elm.second.data();
-        continue;
+        replicationName = elm.second.data();
       }
-
-      ParameterValueType propertyMultiValue = VectorizeValues(elm.second);
-      std::string        propertyKey = elm.first;
-      newProperties[propertyKey] = propertyMultiValue;
-    }
-
-    // Merge newProperies into current blueprint properties
-    // Does blueprint use component with a name that already exists?
-    if (this->ComponentExists(componentName))
-    {
-      // Component exists, check if properties can be merged
-      auto currentProperties = this->GetComponent(componentName);
-
-      for (auto const & othersEntry : newProperties)
+      else if (replicationKey == "Components")
       {
-        // Does other use a property key that already exists in this component?
-        if (currentProperties.count(othersEntry.first))
-        {
-          auto && ownValues = currentProperties[othersEntry.first];
-          auto && otherValues = othersEntry.second;
-          // Are the property values equal?
-          if (ownValues.size() != otherValues.size())
-          {
-            // No, based on the number of values we see that it is different. Blueprints cannot be Composed
-            this->m_LoggerImpl->Log(LogLevel::ERR, "Merging blueprints failed : Component properties cannot be redefined");
-            throw std::invalid_argument("Merging blueprints failed : Component properties cannot be redefined");
-          }
-          else
-          {
-            ParameterValueType::const_iterator ownValue;
-            ParameterValueType::const_iterator otherValue;
-            for (ownValue = ownValues.begin(), otherValue = otherValues.begin(); ownValue != ownValues.end(); ++ownValue, ++otherValue)
-            {
-              if (*otherValue != *ownValue)
-              {
-                // No, at least one value is different. Blueprints cannot be Composed
-                this->m_LoggerImpl->Log(LogLevel::ERR, "Merging blueprints failed : Component properties cannot be redefined");
-                throw std::invalid_argument("Merging blueprints failed: Component properties cannot be redefined");
-              }
-            }
-          }
-        }
-        else
-        {
-          // Property key doesn't exist yet, add entry to this component
-          auto ownProperties = this->GetComponent(componentName);
-          ownProperties[othersEntry.first] = othersEntry.second;
-          this->SetComponent(componentName, ownProperties);
-        }
+        componentNames = VectorizeValues(elm.second);
+      }
+      else if (replicationKey == "NumberOfReplicas")
+      {
+        numberOfReplicas = std::stoul(elm.second.data());
+      }
+      else
+      {
+        this->m_LoggerImpl->Log(LogLevel::WRN, "Replicate key '{0}' is ignored.", replicationKey);
       }
     }
-    else
-    {
-      // Create Component and with the new properties
-      this->SetComponent(componentName, newProperties);
-    }
+
+    this->MergeReplication(replicationName, std::move(componentNames), numberOfReplicas);
   }
+}
 
-  BOOST_FOREACH(const PropertyTreeType::value_type & v, pt.equal_range("Connection"))
+void
+BlueprintImpl::MergeSections(const BlueprintSections & sections)
+{
+  // As MergeProperties, all components before the connections that refer to them
+  for (auto const & component : sections.components)
   {
-    std::string connectionName = v.second.data();
+    this->MergeComponent(component.name, component.parameterMap);
+  }
+  for (auto const & connection : sections.connections)
+  {
+    this->MergeConnection(connection.out, connection.in, connection.name, connection.parameterMap);
+  }
+  for (auto const & replication : sections.replications)
+  {
+    this->MergeReplication(replication.name, ComponentNamesType(replication.componentNames), replication.numberOfReplicas);
+  }
+}
 
-    std::string      outName;
-    std::string      inName;
-    ParameterMapType newProperties;
+void
+BlueprintImpl::MergeComponent(const ComponentNameType & name, const ParameterMapPointer & newProperties)
+{
+  // Does blueprint use component with a name that already exists?
+  const ComponentIndexType index = this->GetComponentIndex(name);
+  if (index == NullComponentIndex)
+  {
+    // Create Component and with the new properties
+    this->SetSharedComponent(name, newProperties);
+    return;
+  }
 
-    for (auto const & elm : v.second)
+  // Component exists, check if properties can be merged. The parameter map of the component may be shared with other
+  // blueprints, so new properties are merged into a copy of it.
+  const ParameterMapType & ownProperties = *this->m_Graph.components[index].parameterMap;
+  std::shared_ptr< ParameterMapType > mergedProperties;
+  for (auto const & othersEntry : *newProperties)
+  {
+    // Does other use a property key that already exists in this component?
+    auto ownEntry = ownProperties.find(othersEntry.first);
+    if (ownEntry != ownProperties.end())
     {
-      const std::string & connectionKey = elm.first;
-
-      if (connectionKey == "Out")
-      {
-        outName = elm.second.data();
-        continue;
-      }
-      else if (connectionKey == "In")
-      {
-        inName = elm.second.data();
-        continue;
-      }
-      else if (connectionKey == "Name")
+      // Are the property values equal? If not, blueprints cannot be composed
+      if (ownEntry->second != othersEntry.second)
       {
-        if (connectionName != "")
-        {
-          this->m_LoggerImpl->Log(LogLevel::WRN, "Connection Name '{}' is overridden by '{}'", connectionName, elm.second.data());
-        }
-        connectionName = elm.second.data();
-        continue;
+        this->m_LoggerImpl->Log(LogLevel::ERR, "Merging blueprints failed : Component properties cannot be redefined");
+        throw std::invalid_argument("Merging blueprints failed: Component properties cannot be redefined");
       }
-      else
+    }
+    else
+    {
+      // Property key doesn't exist yet, add entry to this component
+      if (!mergedProperties)
       {
-        ParameterValueType propertyMultiValue = VectorizeValues(elm.second);
-        std::string        propertyKey = elm.first;
-        newProperties[propertyKey] = propertyMultiValue;
+        mergedProperties = std::make_shared< ParameterMapType >(ownProperties);
       }
+      mergedProperties->insert(othersEntry);
     }
+  }
+  if (mergedProperties)
+  {
+    this->m_Graph.components[index].parameterMap = std::move(mergedProperties);
+    this->m_Graph.components[index].modifiedTime = this->Modified();
+  }
+}
 
-    // Does the blueprint have a connection that already exists?
-    if (this->ConnectionExists(outName, inName, connectionName))
-    {
-      // Connection exists, check if properties can be merged
-      auto ownProperties = this->GetConnection(outName, inName, connectionName);
+void
+BlueprintImpl::MergeConnection(const ComponentNameType & upstream, const ComponentNameType & downstream, const ConnectionNameType & name,
+  const ParameterMapPointer & newProperties)
+{
+  // Does the blueprint have a connection that already exists?
+  const ConnectionIndexType index = this->FindConnection(upstream, downstream, name);
+  if (index == NullConnectionIndex)
+  {
+    // Create Connection with the new properties
+    this->SetSharedConnection(upstream, downstream, newProperties, name);
+    return;
+  }
 
-      for (auto const & othersEntry : newProperties)
+  // Connection exists, check if properties can be merged, into a copy of its parameter map as for components
+  const ParameterMapType & ownProperties = *this->m_Graph.connections[index].parameterMap;
+  std::shared_ptr< ParameterMapType > mergedProperties;
+  for (auto const & othersEntry : *newProperties)
+  {
+    // Does newProperties use a key that already exists in this connection?
+    auto ownEntry = ownProperties.find(othersEntry.first);
+    if (ownEntry != ownProperties.end())
+    {
+      // Are the property values equal? If not, blueprints cannot be composed
+      if (ownEntry->second != othersEntry.second)
       {
-        // Does newProperties use a key that already exists in this component?
-        if (ownProperties.count(othersEntry.first))
-        {
-          auto && ownValues = ownProperties[othersEntry.first];
-          auto && otherValues = othersEntry.second;
-          // Are the property values equal?
-          if (ownValues.size() != otherValues.size())
-          {
-            // No, based on the number of values we see that it is different. Blueprints cannot be Composed
-            this->m_LoggerImpl->Log(LogLevel::ERR, "Merging blueprints failed : Connection properties cannot be redefined");
-            throw std::invalid_argument("Merging blueprints failed: Connection properties cannot be redefined");
-          }
-          else
-          {
-            ParameterValueType::const_iterator ownValue;
-            ParameterValueType::const_iterator otherValue;
-            for (ownValue = ownValues.begin(), otherValue = otherValues.begin(); ownValue != ownValues.end(); ++ownValue, ++otherValue)
-            {
-              if (*otherValue != *ownValue)
-              {
-                // No, at least one value is different. Blueprints cannot be Composed
-                this->m_LoggerImpl->Log(LogLevel::ERR, "Merging blueprints failed : Connection properties cannot be redefined");
-                throw std::invalid_argument("Merging blueprints failed: Connection properties cannot be redefined");
-              }
-            }
-          }
-        }
-        else
-        {
-          // Property key doesn't exist yet, add entry to this component
-          //auto ownProperties = this->GetConnection(incomingName, componentName);
-          ownProperties[othersEntry.first] = othersEntry.second;
-          this->SetConnection(outName, inName, ownProperties, connectionName);
-        }
+        this->m_LoggerImpl->Log(LogLevel::ERR, "Merging blueprints failed : Connection properties cannot be redefined");
+        throw std::invalid_argument("Merging blueprints failed: Connection properties cannot be redefined");
       }
     }
     else
     {
-      // Create Component copying properties of other
-      this->SetConnection(outName, inName, newProperties, connectionName);
+      // Property key doesn't exist yet, add entry to this connection
+      if (!mergedProperties)
+      {
+        mergedProperties = std::make_shared< ParameterMapType >(ownProperties);
+      }
+      mergedProperties->insert(othersEntry);
     }
   }
+  if (mergedProperties)
+  {
+    this->m_Graph.connections[index].parameterMap = std::move(mergedProperties);
+    this->m_Graph.connections[index].modifiedTime = this->Modified();
+  }
+}
+
+void
+BlueprintImpl::MergeReplication(const ReplicationNameType & name, ComponentNamesType && componentNames, std::size_t numberOfReplicas)
+{
+  // Does the blueprint have a replication by this name already?
+  auto replication = this->m_Replications.find(name);
+  if (replication != this->m_Replications.end()
+    && (replication->second.componentNames != componentNames || replication->second.numberOfReplicas != numberOfReplicas))
+  {
+    this->m_LoggerImpl->Log(LogLevel::ERR, "Merging blueprints failed : Replication cannot be redefined");
+    throw std::invalid_argument("Merging blueprints failed: Replication cannot be redefined");
+  }
+  if (!this->SetReplication(name, std::move(componentNames), numberOfReplicas))
+  {
+    throw std::invalid_argument("Merging blueprints failed: Replication " + name + " needs at least 1 replica");
+  }
 }
 } // namespace selx
@@ -20,17 +20,6 @@
 #ifndef selxBlueprintImpl_h
 #define selxBlueprintImpl_h
 
-#include "boost/graph/graphviz.hpp"
-#include "boost/graph/graph_traits.hpp"
-#include "boost/graph/directed_graph.hpp"
-#include "boost/graph/labeled_graph.hpp"
-
-// for UpdateOrder
-#include <boost/graph/topological_sort.hpp>
-
-// for ComposeWith
-#include "boost/graph/copy.hpp"
-
 // for FromFile and MergeFromFile
 #include <boost/property_tree/ptree.hpp>
 #include <boost/property_tree/xml_parser.hpp>
@@ -39,12 +28,23 @@
 #include <boost/foreach.hpp>
 #include <boost/filesystem.hpp>
 
+#include <deque>
+#include <functional>
 #include <string>
 #include <iostream>
+#include <map>
+#include <memory>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 #include <boost/algorithm/string.hpp>
 
 
 #include "selxBlueprint.h"
+#include "selxBlueprintBinaryFormat.h"
+#include "selxBlueprintFileCache.h"
+#include "selxBlueprintJsonReader.h"
 #include "selxLoggerImpl.h"
 
 namespace selx
@@ -58,54 +58,99 @@ public:
   typedef Blueprint::ParameterKeyType ParameterKeyType;
   typedef Blueprint::ParameterValueType ParameterValueType;
   typedef Blueprint::ParameterMapType ParameterMapType;
+
+  // Parameter maps are immutable and shared by the copies of a blueprint, and by the blueprints that were composed with
+  // it, until one of them sets new parameters. Copying or composing blueprints therefore does not copy parameter maps.
+  typedef std::shared_ptr< const ParameterMapType > ParameterMapPointer;
   typedef Blueprint::ComponentNameType ComponentNameType;
   typedef Blueprint::ComponentNamesType ComponentNamesType;
   typedef Blueprint::ConnectionNameType ConnectionNameType;
   typedef Blueprint::ConnectionNamesType ConnectionNamesType;
 
-  
+  // Modifications of the blueprint are stamped by a counter that increases at every modification
+  typedef unsigned long ModifiedTimeType;
+
+  // A named subgraph of components that is cloned numberOfReplicas times by ReplicateInto()
+  struct ReplicationType
+  {
+    ComponentNamesType componentNames;
+    std::size_t        numberOfReplicas;
+  };
+  typedef std::string                                      ReplicationNameType;
+  typedef std::map< ReplicationNameType, ReplicationType > ReplicationsType;
+
+
+  // Components and connections are addressed by their index in the graph
+  typedef std::size_t ComponentIndexType;
+  typedef std::size_t ConnectionIndexType;
+
+  static const ComponentIndexType  NullComponentIndex  = static_cast< ComponentIndexType >( -1 );
+  static const ConnectionIndexType NullConnectionIndex = static_cast< ConnectionIndexType >( -1 );
 
   // Component parameter map that sits on a node in the graph
   // and holds component configuration settings
   struct ComponentPropertyType
   {
-    ComponentPropertyType( ComponentNameType name = "", ParameterMapType parameterMap = {} ) : name( name ), parameterMap( parameterMap ) {}
-    ComponentNameType name;
-    ParameterMapType  parameterMap;
+    ComponentPropertyType( ComponentNameType name, ParameterMapPointer parameterMap, ModifiedTimeType modifiedTime = 0 ) :
+      name( std::move( name ) ), parameterMap( std::move( parameterMap ) ), modifiedTime( modifiedTime ) {}
+    ComponentNameType   name;
+    ParameterMapPointer parameterMap;
+    ModifiedTimeType    modifiedTime;
   };
 
   // Component parameter map that sits on an edge in the graph
   // and holds component connection configuration settings
   struct ConnectionPropertyType
   {
-    ConnectionPropertyType( ConnectionNameType name = "", ParameterMapType parameterMap = {} ) :name( name ),  parameterMap( parameterMap ) {}
-    ConnectionNameType name;
-    ParameterMapType parameterMap;
+    ConnectionPropertyType( ConnectionNameType name, ParameterMapPointer parameterMap, ModifiedTimeType modifiedTime = 0,
+      ComponentIndexType upstream = NullComponentIndex, ComponentIndexType downstream = NullComponentIndex ) :
+      name( std::move( name ) ), parameterMap( std::move( parameterMap ) ), modifiedTime( modifiedTime ), upstream( upstream ),
+      downstream( downstream ) {}
+    ConnectionNameType  name;
+    ParameterMapPointer parameterMap;
+    ModifiedTimeType    modifiedTime;
+    ComponentIndexType  upstream;
+    ComponentIndexType  downstream;
   };
 
-  typedef boost::labeled_graph<
-    boost::adjacency_list<
-    boost::multisetS, //OutEdgeList: allow multiple parallel connections
-    boost::vecS, // VertexList, 
-    boost::bidirectionalS, //Directed: directed graph, but give access to traverse in both directions
-    ComponentPropertyType, //VertexProperties
-    ConnectionPropertyType //GraphProperties
-    >,
-    ComponentNameType > GraphType;
+  // The indices of the connections from or to a component, without copying them
+  class ConnectionIndexRangeType
+  {
+  public:
 
-  typedef boost::graph_traits< GraphType >::vertex_descriptor       ComponentIndexType;
-  typedef boost::graph_traits< GraphType >::vertex_iterator         ComponentIteratorType;
-  typedef std::pair< ComponentIteratorType, ComponentIteratorType > ComponentIteratorPairType;
+    ConnectionIndexRangeType( const ConnectionIndexType * begin, const ConnectionIndexType * end ) : m_Begin( begin ), m_End( end ) {}
+    const ConnectionIndexType * begin() const { return this->m_Begin; }
+    const ConnectionIndexType * end() const { return this->m_End; }
+    std::size_t size() const { return static_cast< std::size_t >( this->m_End - this->m_Begin ); }
+    bool empty() const { return this->m_Begin == this->m_End; }
 
-  typedef boost::graph_traits< GraphType >::edge_descriptor           ConnectionIndexType;
-  typedef boost::graph_traits< GraphType >::edge_iterator             ConnectionIteratorType;
-  typedef std::pair< ConnectionIteratorType, ConnectionIteratorType > ConnectionIteratorPairType;
+  private:
 
-  typedef boost::graph_traits< GraphType >::in_edge_iterator InputIteratorType;
-  typedef std::pair< InputIteratorType, InputIteratorType >  InputIteratorPairType;
+    const ConnectionIndexType * m_Begin;
+    const ConnectionIndexType * m_End;
+  };
 
-  typedef boost::graph_traits< GraphType >::out_edge_iterator OutputIteratorType;
-  typedef std::pair< OutputIteratorType, OutputIteratorType > OutputIteratorPairType;
+  // Compressed sparse row adjacency: the connections of component i are connections[ offsets[ i ] ] up to
+  // connections[ offsets[ i + 1 ] ], ordered by the component at their other end and then by their index.
+  struct AdjacencyType
+  {
+    std::vector< std::size_t >         offsets = std::vector< std::size_t >( 1, 0 );
+    std::vector< ConnectionIndexType > connections;
+  };
+
+  // The components and connections in flat arrays. The deques keep references to the properties stable when components
+  // or connections are added.
+  struct GraphType
+  {
+    typedef std::tuple< ComponentIndexType, ComponentIndexType, ConnectionNameType > ConnectionKeyType;
+
+    std::deque< ComponentPropertyType >                                    components;
+    std::unordered_map< ComponentNameType, ComponentIndexType >            componentIndices;
+    std::deque< ConnectionPropertyType >                                   connections;
+    std::map< ConnectionKeyType, ConnectionIndexType, std::less< > >       connectionIndices;
+    AdjacencyType                                                          outputs;
+    AdjacencyType                                                          inputs;
+  };
 
   BlueprintImpl( LoggerImpl & loggerImpl);
 
@@ -114,6 +159,7 @@ public:
 
   ParameterMapType GetComponent( ComponentNameType componentName ) const;
 
+  // Delete the component and its connections. Returns false if the component does not exist.
   bool DeleteComponent( ComponentNameType componentName );
 
   bool ComponentExists( ComponentNameType componentName ) const;
@@ -131,6 +177,9 @@ public:
 
   bool ConnectionExists( ComponentNameType upstream, ComponentNameType downstream, ConnectionNameType name ) const;
 
+  // Add the components, connections and replications of other. Redefining a property is not allowed and returns false,
+  // in which case this blueprint is left as it was. Other is checked before anything is added, hence composition does
+  // not copy this blueprint, and parameter maps that other adds are shared rather than copied.
   bool ComposeWith( const BlueprintImpl & other );
 
   // Returns a vector of the Component names at the incoming direction
@@ -142,10 +191,69 @@ public:
   // Returns a vector of the connection names between upstream and downstream
   ComponentNamesType GetConnectionNames(const ComponentNameType upstream, const ComponentNameType downstream) const;
 
+  // The components such that every component comes after the components upstream. Throws std::invalid_argument if
+  // the connections form a cycle.
   ComponentNamesType GetUpdateOrder() const;
 
+  // Access to the graph by index, for traversals without lookups by name or copies of names and parameter maps.
+  // Component and connection indices and references to their properties remain valid until a component or
+  // connection is deleted. Ranges of connection indices remain valid until a connection is added or deleted.
+  std::size_t GetNumberOfComponents() const { return this->m_Graph.components.size(); }
+
+  std::size_t GetNumberOfConnections() const { return this->m_Graph.connections.size(); }
+
+  // The index of the component, or NullComponentIndex if it does not exist
+  ComponentIndexType GetComponentIndex( const ComponentNameType & componentName ) const;
+
+  const ComponentPropertyType & GetComponentProperty( ComponentIndexType index ) const { return this->m_Graph.components[ index ]; }
+
+  const ConnectionPropertyType & GetConnectionProperty( ConnectionIndexType index ) const { return this->m_Graph.connections[ index ]; }
+
+  // The connections to the component, ordered by the upstream component
+  ConnectionIndexRangeType GetInputConnections( ComponentIndexType index ) const;
+
+  // The connections from the component, ordered by the downstream component
+  ConnectionIndexRangeType GetOutputConnections( ComponentIndexType index ) const;
+
+  // The time of the latest modification of any component or connection. Setting the parameters that a
+  // component or connection already has is not a modification.
+  ModifiedTimeType GetModifiedTime() const { return this->m_ModifiedTime; }
+
+  // The time at which the component was added or its parameters were set, or at which a connection to or
+  // from the component was deleted. Components that were not modified after a time can keep their configuration.
+  ModifiedTimeType GetComponentModifiedTime( ComponentNameType componentName ) const;
+
+  // The time at which the connection was added or its parameters were set
+  ModifiedTimeType GetConnectionModifiedTime( ComponentNameType upstream, ComponentNameType downstream, ConnectionNameType name ) const;
+
+  // Replicate the components componentNames, and the connections between them, numberOfReplicas times. Connections
+  // from other components into the subgraph are cloned to every replica, such that the replicas share these upstream
+  // components. Connections from the subgraph to other components are not allowed. Setting the same replication again
+  // is not a modification.
+  bool SetReplication( ReplicationNameType name, ComponentNamesType componentNames, std::size_t numberOfReplicas );
+
+  bool DeleteReplication( ReplicationNameType name );
+
+  const ReplicationsType & GetReplications() const { return this->m_Replications; }
+
+  // The name of replica index of a replicated component: <componentName>_<index>, for index 0 to numberOfReplicas - 1
+  static ComponentNameType GetReplicaName( const ComponentNameType & componentName, std::size_t index );
+
+  // Set the components and connections of replicated to those of this blueprint with its replications expanded. The
+  // components and connections of replicated that remain the same keep their modified time. Returns false, leaving
+  // replicated as it was, if a replication refers to a component that does not exist, has a connection to a component
+  // outside the replication or a replica name that is used by another component.
+  bool ReplicateInto( BlueprintImpl & replicated ) const;
+
   void Write( const std::string filename );
 
+  // Write the components, connections and replications to a compiled blueprint file (.selxb), see BlueprintBinaryFormat
+  void WriteBinary( const std::string & filename ) const;
+
+  // Merge the components, connections and replications of a .json, .xml or compiled .selxb file, after those of the
+  // files it includes. Json files are read in a single pass, xml files through boost::property_tree and compiled
+  // blueprints are memory mapped. Json and compiled files are kept in the BlueprintFileCache, the includes of a file
+  // are read concurrently. Throws std::runtime_error if a file includes itself, directly or through other files.
   void MergeFromFile(const std::string & filename);
 
   void SetLoggerImpl( LoggerImpl & loggerImpl );
@@ -163,11 +271,62 @@ private:
   PathsType FindIncludes(const PropertyTreeType &);
   ParameterValueType VectorizeValues(ComponentOrConnectionTreeType componentOrConnectionTree);
 
-  Blueprint::Pointer FromPropertyTree(const PropertyTreeType &);
   void MergeProperties(const PropertyTreeType &);
 
+  void MergeSections(const BlueprintSections & sections);
+
+  // A file with the files it includes, all read before any of them is merged
+  struct IncludeTreeType
+  {
+    PathType fileName;
+    BlueprintFileCache::SectionsPointer sections; // json and compiled files
+    PropertyTreeType propertyTree;                // xml files
+    std::vector< IncludeTreeType > includes;
+  };
+
+  // Read the file and, concurrently, the files it includes. includingFiles are the canonical paths of the files that
+  // include it, by which cycles are detected.
+  IncludeTreeType ReadIncludeTree(const PathType & fileName, const PathsType & includingFiles);
+
+  // Merge the included files in order, then the file itself
+  void MergeIncludeTree(const IncludeTreeType & includeTree);
+
+  // Add the properties to those of the component, or create it sharing them. Throws if a property of the component is
+  // redefined.
+  void MergeComponent(const ComponentNameType & name, const ParameterMapPointer & newProperties);
+
+  // Add the properties to those of the connection, or create it sharing them. Throws if a property of the connection is
+  // redefined.
+  void MergeConnection(const ComponentNameType & upstream, const ComponentNameType & downstream, const ConnectionNameType & name,
+    const ParameterMapPointer & newProperties);
+
+  // Throws if the replication is redefined or has no replicas
+  void MergeReplication(const ReplicationNameType & name, ComponentNamesType && componentNames, std::size_t numberOfReplicas);
+
+  // SetComponent and SetConnection, sharing the parameter map
+  bool SetSharedComponent( ComponentNameType name, ParameterMapPointer parameterMap );
+
+  bool SetSharedConnection( ComponentNameType upstream, ComponentNameType downstream, ParameterMapPointer parameterMap, ConnectionNameType name );
+
+  // The index of the connection, or NullConnectionIndex if it does not exist
+  ConnectionIndexType FindConnection( const ComponentNameType & upstream, const ComponentNameType & downstream, const ConnectionNameType & name ) const;
+
+  // Insert the connection at the end of the adjacency of component, after the connections with the same other end
+  static void InsertConnection( AdjacencyType & adjacency, ComponentIndexType component, ConnectionIndexType connection,
+    ComponentIndexType ConnectionPropertyType::* otherEnd, const std::deque< ConnectionPropertyType > & connections );
+
+  // Rebuild the adjacency and connection indices after connections were deleted
+  void RebuildConnectionIndices();
+
+  // Advance and return the modified time
+  ModifiedTimeType Modified() { return ++this->m_ModifiedTime; }
+
   GraphType m_Graph;
 
+  ReplicationsType m_Replications;
+
+  ModifiedTimeType m_ModifiedTime;
+
   LoggerImpl * m_LoggerImpl;
 };
 } // namespace selx
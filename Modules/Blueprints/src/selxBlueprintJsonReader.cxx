@@ -0,0 +1,482 @@
+/*=========================================================================
+ *
+ *  Copyright Leiden University Medical Center, Erasmus University Medical
+ *  Center and contributors
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "selxBlueprintJsonReader.h"
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace selx
+{
+BlueprintJsonReader::SectionsType
+BlueprintJsonReader::ReadFile( const std::string & fileName )
+{
+  std::ifstream file( fileName, std::ios::in | std::ios::binary );
+  if( !file )
+  {
+    throw std::runtime_error( fileName + ": cannot open file" );
+  }
+  // Read the file at once, the parser scans the buffer without copying it
+  std::string text;
+  file.seekg( 0, std::ios::end );
+  text.resize( static_cast< std::size_t >( file.tellg() ) );
+  file.seekg( 0, std::ios::beg );
+  file.read( &text[ 0 ], static_cast< std::streamsize >( text.size() ) );
+  if( !file )
+  {
+    throw std::runtime_error( fileName + ": cannot read file" );
+  }
+  return this->ReadString( text, fileName );
+}
+
+
+BlueprintJsonReader::SectionsType
+BlueprintJsonReader::ReadString( const std::string & text, const std::string & sourceName )
+{
+  this->m_Begin      = text.data();
+  this->m_Position   = text.data();
+  this->m_End        = text.data() + text.size();
+  this->m_SourceName = sourceName;
+
+  SectionsType sections;
+  this->SkipWhitespace();
+  this->ParseMembers( [ this, &sections ]( const std::string & key ) { this->ParseSection( key, sections ); } );
+  this->SkipWhitespace();
+  if( this->m_Position != this->m_End )
+  {
+    this->Fail( "garbage after data" );
+  }
+  return sections;
+}
+
+
+void
+BlueprintJsonReader::ParseSection( const std::string & key, SectionsType & sections )
+{
+  if( key == "Component" )
+  {
+    this->ParseComponent( sections );
+  }
+  else if( key == "Connection" )
+  {
+    this->ParseConnection( sections );
+  }
+  else if( key == "Replicate" )
+  {
+    this->ParseReplicate( sections );
+  }
+  else if( key == "Include" )
+  {
+    if( !sections.includes.empty() )
+    {
+      this->Fail( "only 1 listing of Includes is allowed per Blueprint file" );
+    }
+    this->ParseValues( sections.includes );
+  }
+  else
+  {
+    // Other sections are not part of the blueprint
+    this->SkipValue();
+  }
+}
+
+
+void
+BlueprintJsonReader::ParseComponent( SectionsType & sections )
+{
+  sections.components.emplace_back();
+  ComponentSectionType & component = sections.components.back();
+  ParameterMapType       parameterMap;
+  this->ParseMembers( [ this, &component, &parameterMap ]( const std::string & key ) {
+      if( key == "Name" )
+      {
+        this->ParseScalar( component.name );
+      }
+      else
+      {
+        ParameterValueType & values = parameterMap[ key ];
+        values.clear();
+        this->ParseValues( values );
+      }
+    } );
+  component.parameterMap = std::make_shared< const ParameterMapType >( std::move( parameterMap ) );
+}
+
+
+void
+BlueprintJsonReader::ParseConnection( SectionsType & sections )
+{
+  sections.connections.emplace_back();
+  ConnectionSectionType & connection = sections.connections.back();
+  ParameterMapType        parameterMap;
+  this->ParseMembers( [ this, &connection, &parameterMap ]( const std::string & key ) {
+      if( key == "Out" )
+      {
+        this->ParseScalar( connection.out );
+      }
+      else if( key == "In" )
+      {
+        this->ParseScalar( connection.in );
+      }
+      else if( key == "Name" )
+      {
+        this->ParseScalar( connection.name );
+      }
+      else
+      {
+        ParameterValueType & values = parameterMap[ key ];
+        values.clear();
+        this->ParseValues( values );
+      }
+    } );
+  connection.parameterMap = std::make_shared< const ParameterMapType >( std::move( parameterMap ) );
+}
+
+
+void
+BlueprintJsonReader::ParseReplicate( SectionsType & sections )
+{
+  sections.replications.push_back( { "", {}, 0 } );
+  ReplicateSectionType & replication = sections.replications.back();
+  this->ParseMembers( [ this, &replication ]( const std::string & key ) {
+      if( key == "Name" )
+      {
+        this->ParseScalar( replication.name );
+      }
+      else if( key == "Components" )
+      {
+        replication.componentNames.clear();
+        this->ParseValues( replication.componentNames );
+      }
+      else if( key == "NumberOfReplicas" )
+      {
+        std::string numberOfReplicas;
+        this->ParseScalar( numberOfReplicas );
+        replication.numberOfReplicas = std::stoul( numberOfReplicas );
+      }
+      else
+      {
+        this->m_LoggerImpl.Log( LogLevel::WRN, "Replicate key '{0}' is ignored.", key );
+        this->SkipValue();
+      }
+    } );
+}
+
+
+template< class ParseMemberType >
+void
+BlueprintJsonReader::ParseMembers( ParseMemberType parseMember )
+{
+  this->Expect( '{' );
+  this->SkipWhitespace();
+  if( this->m_Position != this->m_End && *this->m_Position == '}' )
+  {
+    ++this->m_Position;
+    return;
+  }
+
+  std::string key;
+  while( true )
+  {
+    this->SkipWhitespace();
+    this->ParseString( key );
+    this->SkipWhitespace();
+    this->Expect( ':' );
+    this->SkipWhitespace();
+    parseMember( key );
+    this->SkipWhitespace();
+    if( this->m_Position == this->m_End )
+    {
+      this->Fail( "expected ',' or '}'" );
+    }
+    if( *this->m_Position++ == '}' )
+    {
+      return;
+    }
+    if( this->m_Position[ -1 ] != ',' )
+    {
+      --this->m_Position;
+      this->Fail( "expected ',' or '}'" );
+    }
+  }
+}
+
+
+void
+BlueprintJsonReader::ParseValues( ParameterValueType & values )
+{
+  if( this->IsScalar() )
+  {
+    values.emplace_back();
+    this->ParseScalar( values.back() );
+    return;
+  }
+
+  const bool isObject = *this->m_Position == '{';
+  const char close    = isObject ? '}' : ']';
+  ++this->m_Position;
+  this->SkipWhitespace();
+  if( this->m_Position != this->m_End && *this->m_Position == close )
+  {
+    // As the property tree, an empty array or object is a single empty value
+    ++this->m_Position;
+    values.emplace_back();
+    return;
+  }
+
+  std::string key;
+  while( true )
+  {
+    this->SkipWhitespace();
+    if( isObject )
+    {
+      // The keys of the elements are not part of the values
+      this->ParseString( key );
+      this->SkipWhitespace();
+      this->Expect( ':' );
+      this->SkipWhitespace();
+    }
+    values.emplace_back();
+    if( this->IsScalar() )
+    {
+      this->ParseScalar( values.back() );
+    }
+    else
+    {
+      // Nested arrays and objects have no value of their own
+      this->SkipValue();
+    }
+    this->SkipWhitespace();
+    if( this->m_Position == this->m_End )
+    {
+      this->Fail( std::string( "expected ',' or '" ) + close + "'" );
+    }
+    if( *this->m_Position++ == close )
+    {
+      return;
+    }
+    if( this->m_Position[ -1 ] != ',' )
+    {
+      --this->m_Position;
+      this->Fail( std::string( "expected ',' or '" ) + close + "'" );
+    }
+  }
+}
+
+
+void
+BlueprintJsonReader::ParseScalar( std::string & value )
+{
+  if( this->m_Position == this->m_End )
+  {
+    this->Fail( "expected value" );
+  }
+  if( *this->m_Position == '"' )
+  {
+    this->ParseString( value );
+    return;
+  }
+
+  // Numbers and literals are taken as their text
+  const char * begin = this->m_Position;
+  while( this->m_Position != this->m_End && ( std::isalnum( static_cast< unsigned char >( *this->m_Position ) )
+    || *this->m_Position == '-' || *this->m_Position == '+' || *this->m_Position == '.' ) )
+  {
+    ++this->m_Position;
+  }
+  value.assign( begin, this->m_Position );
+  if( value.empty() )
+  {
+    this->Fail( "expected value" );
+  }
+  if( std::isalpha( static_cast< unsigned char >( value[ 0 ] ) ) && value != "true" && value != "false" && value != "null" )
+  {
+    this->m_Position = begin;
+    this->Fail( "expected value" );
+  }
+}
+
+
+void
+BlueprintJsonReader::ParseString( std::string & value )
+{
+  this->Expect( '"' );
+  value.clear();
+  while( true )
+  {
+    // Copy the runs between escapes at once
+    const char * begin = this->m_Position;
+    while( this->m_Position != this->m_End && *this->m_Position != '"' && *this->m_Position != '\\' )
+    {
+      ++this->m_Position;
+    }
+    value.append( begin, this->m_Position );
+    if( this->m_Position == this->m_End )
+    {
+      this->Fail( "unterminated string" );
+    }
+    if( *this->m_Position++ == '"' )
+    {
+      return;
+    }
+
+    if( this->m_Position == this->m_End )
+    {
+      this->Fail( "unterminated string" );
+    }
+    switch( *this->m_Position++ )
+    {
+      case '"': value += '"'; break;
+      case '\\': value += '\\'; break;
+      case '/': value += '/'; break;
+      case 'b': value += '\b'; break;
+      case 'f': value += '\f'; break;
+      case 'n': value += '\n'; break;
+      case 'r': value += '\r'; break;
+      case 't': value += '\t'; break;
+      case 'u':
+      {
+        auto parseCodeUnit = [ this ]() {
+            if( this->m_End - this->m_Position < 4 )
+            {
+              this->Fail( "invalid escape sequence" );
+            }
+            unsigned long codeUnit = 0;
+            for( int i = 0; i < 4; ++i )
+            {
+              const char digit = *this->m_Position++;
+              if( !std::isxdigit( static_cast< unsigned char >( digit ) ) )
+              {
+                this->Fail( "invalid escape sequence" );
+              }
+              codeUnit = 16 * codeUnit + ( std::isdigit( static_cast< unsigned char >( digit ) ) ? digit - '0' : ( digit | 0x20 ) - 'a' + 10 );
+            }
+            return codeUnit;
+          };
+        unsigned long codePoint = parseCodeUnit();
+        if( codePoint >= 0xD800 && codePoint < 0xDC00 )
+        {
+          // A surrogate pair
+          if( this->m_End - this->m_Position < 2 || this->m_Position[ 0 ] != '\\' || this->m_Position[ 1 ] != 'u' )
+          {
+            this->Fail( "invalid surrogate pair" );
+          }
+          this->m_Position += 2;
+          const unsigned long lowSurrogate = parseCodeUnit();
+          if( lowSurrogate < 0xDC00 || lowSurrogate >= 0xE000 )
+          {
+            this->Fail( "invalid surrogate pair" );
+          }
+          codePoint = 0x10000 + ( ( codePoint - 0xD800 ) << 10 ) + ( lowSurrogate - 0xDC00 );
+        }
+        // Encode as utf-8
+        if( codePoint < 0x80 )
+        {
+          value += static_cast< char >( codePoint );
+        }
+        else if( codePoint < 0x800 )
+        {
+          value += static_cast< char >( 0xC0 | ( codePoint >> 6 ) );
+          value += static_cast< char >( 0x80 | ( codePoint & 0x3F ) );
+        }
+        else if( codePoint < 0x10000 )
+        {
+          value += static_cast< char >( 0xE0 | ( codePoint >> 12 ) );
+          value += static_cast< char >( 0x80 | ( ( codePoint >> 6 ) & 0x3F ) );
+          value += static_cast< char >( 0x80 | ( codePoint & 0x3F ) );
+        }
+        else
+        {
+          value += static_cast< char >( 0xF0 | ( codePoint >> 18 ) );
+          value += static_cast< char >( 0x80 | ( ( codePoint >> 12 ) & 0x3F ) );
+          value += static_cast< char >( 0x80 | ( ( codePoint >> 6 ) & 0x3F ) );
+          value += static_cast< char >( 0x80 | ( codePoint & 0x3F ) );
+        }
+        break;
+      }
+      default:
+        --this->m_Position;
+        this->Fail( "invalid escape sequence" );
+    }
+  }
+}
+
+
+void
+BlueprintJsonReader::SkipValue()
+{
+  if( this->IsScalar() )
+  {
+    std::string value;
+    this->ParseScalar( value );
+  }
+  else if( *this->m_Position == '{' )
+  {
+    this->ParseMembers( [ this ]( const std::string & ) { this->SkipValue(); } );
+  }
+  else
+  {
+    ParameterValueType values;
+    this->ParseValues( values );
+  }
+}
+
+
+void
+BlueprintJsonReader::SkipWhitespace()
+{
+  while( this->m_Position != this->m_End
+    && ( *this->m_Position == ' ' || *this->m_Position == '\n' || *this->m_Position == '\r' || *this->m_Position == '\t' ) )
+  {
+    ++this->m_Position;
+  }
+}
+
+
+void
+BlueprintJsonReader::Expect( char character )
+{
+  if( this->m_Position == this->m_End || *this->m_Position != character )
+  {
+    this->Fail( std::string( "expected '" ) + character + "'" );
+  }
+  ++this->m_Position;
+}
+
+
+bool
+BlueprintJsonReader::IsScalar() const
+{
+  return this->m_Position == this->m_End || ( *this->m_Position != '{' && *this->m_Position != '[' );
+}
+
+
+void
+BlueprintJsonReader::Fail( const std::string & message ) const
+{
+  const auto line = 1 + std::count( this->m_Begin, this->m_Position, '\n' );
+  std::ostringstream msg;
+  msg << this->m_SourceName << "(" << line << "): " << message;
+  this->m_LoggerImpl.Log( LogLevel::ERR, "{0}", msg.str() );
+  throw std::runtime_error( msg.str() );
+}
+} // namespace selx
@@ -0,0 +1,99 @@
+/*=========================================================================
+ *
+ *  Copyright Leiden University Medical Center, Erasmus University Medical
+ *  Center and contributors
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#ifndef selxBlueprintJsonReader_h
+#define selxBlueprintJsonReader_h
+
+#include "selxBlueprint.h"
+#include "selxBlueprintSections.h"
+#include "selxLoggerImpl.h"
+
+#include <string>
+#include <vector>
+
+namespace selx
+{
+// Single pass reader of json blueprint files. The sections of the file are parsed straight into the parameter maps that
+// the blueprint takes over, without an intermediate property tree. Values are read as boost::property_tree::read_json
+// reads them: numbers, true, false and null as their text, arrays and objects as the list of their scalar elements.
+class BlueprintJsonReader
+{
+public:
+
+  typedef Blueprint::ParameterKeyType   ParameterKeyType;
+  typedef Blueprint::ParameterValueType ParameterValueType;
+  typedef Blueprint::ParameterMapType   ParameterMapType;
+  typedef Blueprint::ComponentNameType  ComponentNameType;
+  typedef Blueprint::ComponentNamesType ComponentNamesType;
+  typedef Blueprint::ConnectionNameType ConnectionNameType;
+
+  typedef BlueprintSections                        SectionsType;
+  typedef BlueprintSections::ComponentSectionType  ComponentSectionType;
+  typedef BlueprintSections::ConnectionSectionType ConnectionSectionType;
+  typedef BlueprintSections::ReplicateSectionType  ReplicateSectionType;
+
+  BlueprintJsonReader( LoggerImpl & loggerImpl ) : m_LoggerImpl( loggerImpl ) {}
+
+  // Throws std::runtime_error, with the line of the file, if the file cannot be read or is not valid json
+  SectionsType ReadFile( const std::string & fileName );
+
+  SectionsType ReadString( const std::string & text, const std::string & sourceName = "<string>" );
+
+private:
+
+  void ParseSection( const std::string & key, SectionsType & sections );
+
+  void ParseComponent( SectionsType & sections );
+
+  void ParseConnection( SectionsType & sections );
+
+  void ParseReplicate( SectionsType & sections );
+
+  // Calls parseMember for every key of an object, which must parse the value that follows
+  template< class ParseMemberType >
+  void ParseMembers( ParseMemberType parseMember );
+
+  // A scalar value or the scalar elements of an array or object
+  void ParseValues( ParameterValueType & values );
+
+  // A string, number, true, false or null
+  void ParseScalar( std::string & value );
+
+  void ParseString( std::string & value );
+
+  void SkipValue();
+
+  void SkipWhitespace();
+
+  void Expect( char character );
+
+  bool IsScalar() const;
+
+  [[noreturn]] void Fail( const std::string & message ) const;
+
+  LoggerImpl & m_LoggerImpl;
+
+  const char * m_Begin    = nullptr;
+  const char * m_Position = nullptr;
+  const char * m_End      = nullptr;
+  std::string  m_SourceName;
+};
+} // namespace selx
+
+#endif // #ifndef selxBlueprintJsonReader_h
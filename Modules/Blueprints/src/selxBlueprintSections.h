@@ -0,0 +1,69 @@
+/*=========================================================================
+ *
+ *  Copyright Leiden University Medical Center, Erasmus University Medical
+ *  Center and contributors
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#ifndef selxBlueprintSections_h
+#define selxBlueprintSections_h
+
+#include "selxBlueprint.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace selx
+{
+// The sections of a blueprint file in the order of the file, as read by BlueprintJsonReader and BlueprintBinaryFormat.
+// The blueprint merges the included files first and shares their parameter maps, which are never modified once read.
+struct BlueprintSections
+{
+  typedef Blueprint::ParameterMapType   ParameterMapType;
+  typedef std::shared_ptr< const ParameterMapType > ParameterMapPointer;
+  typedef Blueprint::ComponentNameType  ComponentNameType;
+  typedef Blueprint::ComponentNamesType ComponentNamesType;
+  typedef Blueprint::ConnectionNameType ConnectionNameType;
+
+  struct ComponentSectionType
+  {
+    ComponentNameType   name;
+    ParameterMapPointer parameterMap;
+  };
+
+  struct ConnectionSectionType
+  {
+    ComponentNameType   out;
+    ComponentNameType   in;
+    ConnectionNameType  name;
+    ParameterMapPointer parameterMap;
+  };
+
+  struct ReplicateSectionType
+  {
+    std::string        name;
+    ComponentNamesType componentNames;
+    std::size_t        numberOfReplicas;
+  };
+
+  std::vector< std::string >           includes;
+  std::vector< ComponentSectionType >  components;
+  std::vector< ConnectionSectionType > connections;
+  std::vector< ReplicateSectionType >  replications;
+};
+} // namespace selx
+
+#endif // #ifndef selxBlueprintSections_h
@@ -19,12 +19,52 @@
 
 #include "selxBlueprintImpl.h"
 #include "selxBlueprint.h"
+#include "selxBlueprintJsonReader.h"
 
 #include "selxDataManager.h"
 #include "gtest/gtest.h"
 
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <new>
+#include <thread>
+
+#include <boost/property_tree/json_parser.hpp>
+
 using namespace selx;
 
+// Counts the allocations of the whole test driver, for the benchmark of the blueprint readers
+static std::atomic< std::size_t > numberOfAllocations( 0 );
+
+void *
+operator new( std::size_t size )
+{
+  ++numberOfAllocations;
+  if( void * memory = std::malloc( size > 0 ? size : 1 ) )
+  {
+    return memory;
+  }
+  throw std::bad_alloc();
+}
+
+
+void
+operator delete( void * memory ) noexcept
+{
+  std::free( memory );
+}
+
+
+void
+operator delete( void * memory, std::size_t ) noexcept
+{
+  std::free( memory );
+}
+
+
 class BlueprintTest : public ::testing::Test
 {
 public:
@@ -122,6 +162,37 @@ TEST_F( BlueprintTest, SetGetDeleteConnection )
   EXPECT_THROW( blueprint->GetConnection( "Component0", "Component1" ), std::runtime_error );
 }
 
+TEST_F( BlueprintTest, ModifiedTime )
+{
+  auto blueprint = Blueprint::New();
+  const BlueprintImpl & blueprintImpl = blueprint->GetBlueprintImpl();
+
+  blueprint->SetComponent( "Component0", parameterMap );
+  blueprint->SetComponent( "Component1", parameterMap );
+  blueprint->SetConnection( "Component0", "Component1", parameterMap );
+  auto modifiedTime = blueprintImpl.GetModifiedTime();
+  EXPECT_EQ( blueprintImpl.GetConnectionModifiedTime( "Component0", "Component1", "" ), modifiedTime );
+  EXPECT_LT( blueprintImpl.GetComponentModifiedTime( "Component0" ), blueprintImpl.GetComponentModifiedTime( "Component1" ) );
+
+  // Setting the same properties does not modify the blueprint
+  blueprint->SetComponent( "Component0", parameterMap );
+  blueprint->SetConnection( "Component0", "Component1", parameterMap );
+  EXPECT_EQ( blueprintImpl.GetModifiedTime(), modifiedTime );
+
+  blueprint->SetComponent( "Component0", anotherParameterMap );
+  EXPECT_GT( blueprintImpl.GetComponentModifiedTime( "Component0" ), modifiedTime );
+  EXPECT_LT( blueprintImpl.GetComponentModifiedTime( "Component1" ), modifiedTime );
+
+  // Deleting a connection modifies both components
+  modifiedTime = blueprintImpl.GetModifiedTime();
+  blueprint->DeleteConnection( "Component0", "Component1" );
+  EXPECT_GT( blueprintImpl.GetComponentModifiedTime( "Component0" ), modifiedTime );
+  EXPECT_GT( blueprintImpl.GetComponentModifiedTime( "Component1" ), modifiedTime );
+
+  EXPECT_THROW( blueprintImpl.GetComponentModifiedTime( "Component2" ), std::runtime_error );
+  EXPECT_THROW( blueprintImpl.GetConnectionModifiedTime( "Component0", "Component1", "" ), std::runtime_error );
+}
+
 TEST_F( BlueprintTest, CopyConstuctor )
 {
   auto baseBlueprint = Blueprint::New();
@@ -188,6 +259,90 @@ TEST_F( BlueprintTest, Compose )
 }
 
 
+TEST_F( BlueprintTest, ComposeSharesParameterMaps )
+{
+  LoggerImpl logger;
+  logger.SetLogLevel( LogLevel::OFF );
+  BlueprintImpl base( logger );
+  base.SetComponent( "Registration", parameterMap );
+  base.SetComponent( "FixedImage", {} );
+  base.SetConnection( "FixedImage", "Registration", anotherParameterMap, "" );
+
+  // Copies share the parameter maps, until one of them sets new parameters
+  BlueprintImpl copy( base );
+  const auto registration = base.GetComponentIndex( "Registration" );
+  EXPECT_EQ( base.GetComponentProperty( registration ).parameterMap, copy.GetComponentProperty( registration ).parameterMap );
+  EXPECT_EQ( base.GetConnectionProperty( 0 ).parameterMap, copy.GetConnectionProperty( 0 ).parameterMap );
+  copy.SetComponent( "Registration", anotherParameterMap );
+  EXPECT_EQ( parameterMap, base.GetComponent( "Registration" ) );
+
+  // Composition shares the parameter maps of the components that other adds and copies those that it extends
+  std::vector< std::unique_ptr< BlueprintImpl > > overlays;
+  for( int overlay = 0; overlay < 100; ++overlay )
+  {
+    overlays.push_back( std::make_unique< BlueprintImpl >( logger ) );
+    overlays.back()->SetComponent( "MovingImage" + std::to_string( overlay ), { { "FileName", { std::to_string( overlay ) + ".nii" } } } );
+    overlays.back()->SetComponent( "Registration", { { "Overlay" + std::to_string( overlay ), { "true" } } } );
+    overlays.back()->SetConnection( "MovingImage" + std::to_string( overlay ), "Registration", {}, "" );
+    EXPECT_TRUE( base.ComposeWith( *overlays.back() ) );
+  }
+  EXPECT_EQ( 102, base.GetNumberOfComponents() );
+  EXPECT_EQ( 101, base.GetNumberOfConnections() );
+  EXPECT_EQ( 101, base.GetComponent( "Registration" ).size() );
+  EXPECT_EQ( overlays[ 7 ]->GetComponentProperty( 0 ).parameterMap, base.GetComponentProperty( base.GetComponentIndex( "MovingImage7" ) ).parameterMap );
+  EXPECT_EQ( parameterMap.at( "NameOfClass" ), base.GetComponent( "Registration" ).at( "NameOfClass" ) );
+  EXPECT_EQ( anotherParameterMap, copy.GetComponent( "Registration" ) );
+
+  // A conflicting composition returns false before anything is added
+  BlueprintImpl conflicting( logger );
+  conflicting.SetComponent( "Transform", {} );
+  conflicting.SetReplication( "Batch", { "Transform" }, 2 );
+  conflicting.SetComponent( "Registration", { { "Overlay7", { "false" } } } );
+  const auto modifiedTime = base.GetModifiedTime();
+  EXPECT_FALSE( base.ComposeWith( conflicting ) );
+  EXPECT_FALSE( base.ComponentExists( "Transform" ) );
+  EXPECT_TRUE( base.GetReplications().empty() );
+  EXPECT_EQ( modifiedTime, base.GetModifiedTime() );
+}
+
+TEST_F( BlueprintTest, Replicate )
+{
+  LoggerImpl logger;
+  BlueprintImpl blueprint( logger );
+  blueprint.SetComponent( "FixedImage", parameterMap );
+  blueprint.SetComponent( "MovingImage", parameterMap );
+  blueprint.SetComponent( "Registration", parameterMap );
+  blueprint.SetConnection( "FixedImage", "Registration", parameterMap, "" );
+  blueprint.SetConnection( "MovingImage", "Registration", anotherParameterMap, "" );
+  EXPECT_FALSE( blueprint.SetReplication( "Batch", { "MovingImage", "Registration" }, 0 ) );
+  EXPECT_TRUE( blueprint.SetReplication( "Batch", { "MovingImage", "Registration" }, 2 ) );
+
+  BlueprintImpl replicated( logger );
+  EXPECT_TRUE( blueprint.ReplicateInto( replicated ) );
+  EXPECT_EQ( 5, replicated.GetComponentNames().size() );
+  EXPECT_FALSE( replicated.ComponentExists( "Registration" ) );
+  for( std::size_t index = 0; index < 2; ++index )
+  {
+    // The fixed image is shared by the replicas
+    EXPECT_EQ( parameterMap, replicated.GetConnection( "FixedImage", BlueprintImpl::GetReplicaName( "Registration", index ), "" ) );
+    EXPECT_EQ( anotherParameterMap, replicated.GetConnection( "MovingImage_" + std::to_string( index ), "Registration_" + std::to_string( index ), "" ) );
+  }
+  EXPECT_FALSE( replicated.ConnectionExists( "MovingImage_0", "Registration_1", "" ) );
+
+  // Replicas that remain keep their modified time
+  auto modifiedTime = replicated.GetComponentModifiedTime( "Registration_1" );
+  blueprint.SetReplication( "Batch", { "MovingImage", "Registration" }, 3 );
+  EXPECT_TRUE( blueprint.ReplicateInto( replicated ) );
+  EXPECT_EQ( 7, replicated.GetComponentNames().size() );
+  EXPECT_EQ( modifiedTime, replicated.GetComponentModifiedTime( "Registration_1" ) );
+
+  // Connections out of a replication cannot be replicated
+  blueprint.SetComponent( "Output", parameterMap );
+  blueprint.SetConnection( "Registration", "Output", parameterMap, "" );
+  EXPECT_FALSE( blueprint.ReplicateInto( replicated ) );
+  EXPECT_EQ( 7, replicated.GetComponentNames().size() );
+}
+
 TEST_F(BlueprintTest, ReadXMLWriteDot)
 {
   auto blueprint = Blueprint::New();
@@ -231,4 +386,380 @@ TEST_F(BlueprintTest, ReadParallelConnections) //#150: Let Blueprint reader hand
   auto blueprint = Blueprint::New();
   EXPECT_NO_THROW(blueprint->MergeFromFile(this->dataManager->GetConfigurationFile("ReadParallelConnections.json")));
 
-}
\ No newline at end of file
+}
+
+TEST_F( BlueprintTest, IndexedGraph )
+{
+  LoggerImpl    logger;
+  BlueprintImpl blueprint( logger );
+  blueprint.SetComponent( "Source", parameterMap );
+  blueprint.SetComponent( "Filter", parameterMap );
+  blueprint.SetComponent( "Sink", anotherParameterMap );
+  blueprint.SetConnection( "Filter", "Sink", {}, "" );
+  blueprint.SetConnection( "Source", "Sink", {}, "Second" );
+  blueprint.SetConnection( "Source", "Filter", {}, "" );
+  blueprint.SetConnection( "Source", "Sink", {}, "First" );
+
+  EXPECT_EQ( 3, blueprint.GetNumberOfComponents() );
+  EXPECT_EQ( 4, blueprint.GetNumberOfConnections() );
+  EXPECT_EQ( BlueprintImpl::NullComponentIndex, blueprint.GetComponentIndex( "DoesNotExist" ) );
+
+  const auto source = blueprint.GetComponentIndex( "Source" );
+  const auto sink   = blueprint.GetComponentIndex( "Sink" );
+  EXPECT_EQ( "Sink", blueprint.GetComponentProperty( sink ).name );
+  EXPECT_EQ( anotherParameterMap, *blueprint.GetComponentProperty( sink ).parameterMap );
+
+  // The connections of a component are ordered by the component at their other end, parallel ones by insertion
+  std::vector< std::string > outputs;
+  for( const auto & connection : blueprint.GetOutputConnections( source ) )
+  {
+    EXPECT_EQ( source, blueprint.GetConnectionProperty( connection ).upstream );
+    outputs.push_back( blueprint.GetComponentProperty( blueprint.GetConnectionProperty( connection ).downstream ).name
+      + "/" + blueprint.GetConnectionProperty( connection ).name );
+  }
+  EXPECT_EQ( std::vector< std::string >( { "Filter/", "Sink/Second", "Sink/First" } ), outputs );
+  EXPECT_EQ( 3, blueprint.GetInputConnections( sink ).size() );
+  EXPECT_TRUE( blueprint.GetInputConnections( source ).empty() );
+  EXPECT_EQ( BlueprintImpl::ComponentNamesType( { "Source", "Filter", "Sink" } ), blueprint.GetUpdateOrder() );
+
+  // Deleting a component deletes its connections and renumbers the others
+  EXPECT_TRUE( blueprint.DeleteComponent( "Filter" ) );
+  EXPECT_FALSE( blueprint.ComponentExists( "Filter" ) );
+  EXPECT_EQ( 2, blueprint.GetNumberOfConnections() );
+  EXPECT_EQ( 2, blueprint.GetOutputConnections( blueprint.GetComponentIndex( "Source" ) ).size() );
+  EXPECT_EQ( 2, blueprint.GetInputConnections( blueprint.GetComponentIndex( "Sink" ) ).size() );
+  EXPECT_TRUE( blueprint.ConnectionExists( "Source", "Sink", "First" ) );
+
+  blueprint.SetConnection( "Sink", "Source", {}, "" );
+  EXPECT_THROW( blueprint.GetUpdateOrder(), std::invalid_argument );
+}
+
+TEST_F( BlueprintTest, ReadJsonSections )
+{
+  LoggerImpl          logger;
+  BlueprintJsonReader reader( logger );
+  const auto sections = reader.ReadString( R"({
+    "Include": [ "a.json", "b.json" ],
+    "Comment": { "Ignored": [ 1, { "Nested": true } ] },
+    "Component": {
+      "Name": "Registration",
+      "NumberOfResolutions": 3,
+      "GridSpacing": [ 8.0, -1.5e2 ],
+      "Flags": [ true, false, null ],
+      "Escaped": "\"quoted\"\t\u00e9\ud83d\ude00",
+      "Levels": { "First": "4", "Second": [ "nested" ] },
+      "Empty": [],
+      "Redefined": "1",
+      "Redefined": "2"
+    },
+    "Connection": { "Out": "Fixed", "In": "Registration", "Name": "First", "NameOfInterface": "FixedInterface" },
+    "Replicate": { "Name": "Pairs", "Components": [ "Registration" ], "NumberOfReplicas": "4" }
+  })" );
+
+  EXPECT_EQ( ParameterValueType( { "a.json", "b.json" } ), sections.includes );
+  ASSERT_EQ( 1, sections.components.size() );
+  EXPECT_EQ( "Registration", sections.components[ 0 ].name );
+  const ParameterMapType & parameterMap = *sections.components[ 0 ].parameterMap;
+  EXPECT_EQ( 0, parameterMap.count( "Name" ) );
+  EXPECT_EQ( ParameterValueType( { "3" } ), parameterMap.at( "NumberOfResolutions" ) );
+  EXPECT_EQ( ParameterValueType( { "8.0", "-1.5e2" } ), parameterMap.at( "GridSpacing" ) );
+  EXPECT_EQ( ParameterValueType( { "true", "false", "null" } ), parameterMap.at( "Flags" ) );
+  EXPECT_EQ( ParameterValueType( { "\"quoted\"\t\xc3\xa9\xf0\x9f\x98\x80" } ), parameterMap.at( "Escaped" ) );
+  EXPECT_EQ( ParameterValueType( { "4", "" } ), parameterMap.at( "Levels" ) );
+  EXPECT_EQ( ParameterValueType( { "" } ), parameterMap.at( "Empty" ) );
+  EXPECT_EQ( ParameterValueType( { "2" } ), parameterMap.at( "Redefined" ) );
+
+  ASSERT_EQ( 1, sections.connections.size() );
+  EXPECT_EQ( "Fixed", sections.connections[ 0 ].out );
+  EXPECT_EQ( "Registration", sections.connections[ 0 ].in );
+  EXPECT_EQ( "First", sections.connections[ 0 ].name );
+  EXPECT_EQ( ParameterValueType( { "FixedInterface" } ), sections.connections[ 0 ].parameterMap->at( "NameOfInterface" ) );
+
+  ASSERT_EQ( 1, sections.replications.size() );
+  EXPECT_EQ( "Pairs", sections.replications[ 0 ].name );
+  EXPECT_EQ( ParameterValueType( { "Registration" } ), sections.replications[ 0 ].componentNames );
+  EXPECT_EQ( 4, sections.replications[ 0 ].numberOfReplicas );
+
+  EXPECT_THROW( reader.ReadString( "{ \"Component\": { \"Name\": \"A\" }" ), std::runtime_error );
+  EXPECT_THROW( reader.ReadString( "{ \"Component\": { \"Name\": [ \"A\" ] } }" ), std::runtime_error );
+  EXPECT_THROW( reader.ReadString( "{ \"Include\": \"a.json\", \"Include\": \"b.json\" }" ), std::runtime_error );
+  EXPECT_THROW( reader.ReadString( "{ } { }" ), std::runtime_error );
+  try
+  {
+    reader.ReadString( "{\n  \"Component\": {\n    \"Name\": unquoted\n  }\n}", "test.json" );
+    FAIL() << "Invalid json was read";
+  }
+  catch( const std::runtime_error & error )
+  {
+    EXPECT_EQ( "test.json(3): expected value", std::string( error.what() ) );
+  }
+}
+
+TEST_F( BlueprintTest, ReadJsonBenchmark )
+{
+  // Benchmark of reading a chain of json blueprints that include each other, each with components with large
+  // elastix-like parameter maps, against reading the same files with boost::property_tree only.
+  const int numberOfFiles      = 20;
+  const int numberOfComponents = 10;
+  const int numberOfParameters = 100;
+  const int numberOfValues     = 16;
+
+  std::vector< std::string > fileNames;
+  for( int file = 0; file < numberOfFiles; ++file )
+  {
+    fileNames.push_back( this->dataManager->GetOutputFile( "ReadJsonBenchmark" + std::to_string( file ) + ".json" ) );
+    std::ofstream out( fileNames.back() );
+    out << "{\n";
+    if( file > 0 )
+    {
+      out << "  \"Include\": \"" << fileNames[ file - 1 ] << "\",\n";
+    }
+    for( int component = 0; component < numberOfComponents; ++component )
+    {
+      out << "  \"Component\": {\n    \"Name\": \"Component" << file << "_" << component << "\"";
+      for( int parameter = 0; parameter < numberOfParameters; ++parameter )
+      {
+        out << ",\n    \"Parameter" << parameter << "\": [";
+        for( int value = 0; value < numberOfValues; ++value )
+        {
+          out << ( value > 0 ? ", " : " " ) << "\"" << value * 0.25 << "\"";
+        }
+        out << " ]";
+      }
+      out << "\n  },\n";
+      if( file > 0 )
+      {
+        out << "  \"Connection\": { \"Out\": \"Component" << file - 1 << "_" << component << "\", \"In\": \"Component" << file << "_"
+            << component << "\" },\n";
+      }
+    }
+    out << "  \"Component\": { \"Name\": \"Shared\", \"Parameter" << file << "\": \"" << file << "\" }\n}\n";
+  }
+
+  LoggerImpl logger;
+  logger.SetLogLevel( LogLevel::OFF );
+
+  std::size_t allocations = numberOfAllocations;
+  auto        start       = std::chrono::steady_clock::now();
+  for( const auto & fileName : fileNames )
+  {
+    boost::property_tree::ptree propertyTree;
+    boost::property_tree::read_json( fileName, propertyTree );
+  }
+  const std::chrono::duration< double, std::milli > propertyTreeDuration = std::chrono::steady_clock::now() - start;
+  const std::size_t propertyTreeAllocations = numberOfAllocations - allocations;
+
+  BlueprintImpl blueprint( logger );
+  allocations = numberOfAllocations;
+  start       = std::chrono::steady_clock::now();
+  EXPECT_NO_THROW( blueprint.MergeFromFile( fileNames.back() ) );
+  const std::chrono::duration< double, std::milli > mergeDuration = std::chrono::steady_clock::now() - start;
+  const std::size_t mergeAllocations = numberOfAllocations - allocations;
+
+  RecordProperty( "PropertyTreeMilliseconds", std::to_string( propertyTreeDuration.count() ) );
+  RecordProperty( "PropertyTreeAllocations", std::to_string( propertyTreeAllocations ) );
+  RecordProperty( "MergeMilliseconds", std::to_string( mergeDuration.count() ) );
+  RecordProperty( "MergeAllocations", std::to_string( mergeAllocations ) );
+
+  EXPECT_EQ( numberOfFiles * numberOfComponents + 1, blueprint.GetComponentNames().size() );
+  EXPECT_EQ( numberOfParameters, blueprint.GetComponent( "Component0_0" ).size() );
+  EXPECT_EQ( "0.75", blueprint.GetComponent( "Component7_3" ).at( "Parameter9" )[ 3 ] );
+  EXPECT_EQ( numberOfFiles, blueprint.GetComponent( "Shared" ).size() );
+  EXPECT_TRUE( blueprint.ConnectionExists( "Component0_0", "Component1_0", "" ) );
+  // The parse straight into the parameter maps of the blueprint allocates less than building the property trees alone
+  EXPECT_LT( mergeAllocations, propertyTreeAllocations );
+}
+
+TEST_F( BlueprintTest, IncludeFileCache )
+{
+  LoggerImpl logger;
+  logger.SetLogLevel( LogLevel::OFF );
+  const std::string baseFileName  = this->dataManager->GetOutputFile( "IncludeFileCacheBase.json" );
+  const std::string fixedFileName = this->dataManager->GetOutputFile( "IncludeFileCacheFixed.json" );
+  const std::string mainFileName  = this->dataManager->GetOutputFile( "IncludeFileCacheMain.json" );
+  std::ofstream( baseFileName ) << "{ \"Component\": { \"Name\": \"Registration\", \"NameOfClass\": \"TestClassName\" } }";
+  std::ofstream( fixedFileName ) << "{ \"Include\": \"" << baseFileName << "\", \"Component\": { \"Name\": \"FixedImage\" }, "
+                                 << "\"Connection\": { \"Out\": \"FixedImage\", \"In\": \"Registration\" } }";
+  std::ofstream( mainFileName ) << "{ \"Include\": [ \"" << fixedFileName << "\", \"" << baseFileName << "\" ], "
+                                << "\"Component\": { \"Name\": \"Registration\", \"NumberOfResolutions\": \"3\" } }";
+
+  // The base file is included twice, by the main file and by the file that it includes, but parsed once
+  BlueprintFileCache::GetDefault().Clear();
+  const std::size_t numberOfParses = BlueprintFileCache::GetDefault().GetNumberOfParses();
+  BlueprintImpl blueprint( logger );
+  EXPECT_NO_THROW( blueprint.MergeFromFile( mainFileName ) );
+  EXPECT_EQ( 3, BlueprintFileCache::GetDefault().GetNumberOfParses() - numberOfParses );
+  EXPECT_EQ( 3, BlueprintFileCache::GetDefault().Size() );
+  EXPECT_EQ( ParameterValueType( 1, "TestClassName" ), blueprint.GetComponent( "Registration" ).at( "NameOfClass" ) );
+  EXPECT_EQ( ParameterValueType( 1, "3" ), blueprint.GetComponent( "Registration" ).at( "NumberOfResolutions" ) );
+  EXPECT_TRUE( blueprint.ConnectionExists( "FixedImage", "Registration", "" ) );
+
+  // Another blueprint reads all files from the cache, unless one has changed
+  BlueprintImpl another( logger );
+  EXPECT_NO_THROW( another.MergeFromFile( mainFileName ) );
+  EXPECT_EQ( 3, BlueprintFileCache::GetDefault().GetNumberOfParses() - numberOfParses );
+  EXPECT_EQ( blueprint.GetComponent( "Registration" ), another.GetComponent( "Registration" ) );
+  // A component that no other file adds to shares the parameter map of the cached file
+  EXPECT_EQ( blueprint.GetComponentProperty( blueprint.GetComponentIndex( "FixedImage" ) ).parameterMap,
+    another.GetComponentProperty( another.GetComponentIndex( "FixedImage" ) ).parameterMap );
+
+  // A file that is written again within the same second, with the same size, is parsed again. The wait only exceeds
+  // the tick of the clock by which file systems record the modification time.
+  std::this_thread::sleep_for( std::chrono::milliseconds( 20 ) );
+  std::ofstream( baseFileName ) << "{ \"Component\": { \"Name\": \"Registration\", \"NameOfClass\": \"TestClassNamf\" } }";
+  BlueprintImpl changed( logger );
+  EXPECT_NO_THROW( changed.MergeFromFile( mainFileName ) );
+  EXPECT_EQ( 4, BlueprintFileCache::GetDefault().GetNumberOfParses() - numberOfParses );
+  EXPECT_EQ( ParameterValueType( 1, "TestClassNamf" ), changed.GetComponent( "Registration" ).at( "NameOfClass" ) );
+
+  // The least recently read files are removed beyond the capacity
+  BlueprintFileCache::GetDefault().SetCapacity( 2 );
+  EXPECT_EQ( 2, BlueprintFileCache::GetDefault().Size() );
+  BlueprintImpl evicted( logger );
+  EXPECT_NO_THROW( evicted.MergeFromFile( mainFileName ) );
+  EXPECT_EQ( 2, BlueprintFileCache::GetDefault().Size() );
+  BlueprintFileCache::GetDefault().SetCapacity( BlueprintFileCache::DefaultCapacity );
+
+  // Files that include each other are rejected, rather than read until the stack overflows
+  const std::string cycleFileName = this->dataManager->GetOutputFile( "IncludeFileCacheCycle.json" );
+  std::ofstream( cycleFileName ) << "{ \"Include\": \"" << mainFileName << "\" }";
+  std::ofstream( baseFileName ) << "{ \"Include\": \"" << cycleFileName << "\" }";
+  BlueprintImpl cyclic( logger );
+  EXPECT_THROW( cyclic.MergeFromFile( mainFileName ), std::runtime_error );
+}
+
+TEST_F( BlueprintTest, WriteReadBinary )
+{
+  LoggerImpl logger;
+  logger.SetLogLevel( LogLevel::OFF );
+  BlueprintImpl blueprint( logger );
+  blueprint.SetComponent( "FixedImage", parameterMap );
+  blueprint.SetComponent( "MovingImage", {} );
+  blueprint.SetComponent( "Registration", { { "NumberOfResolutions", { "3" } }, { "GridSpacing", { "8", "8", "" } }, { "NameOfClass", { "TestClassName" } } } );
+  blueprint.SetConnection( "FixedImage", "Registration", anotherParameterMap, "" );
+  blueprint.SetConnection( "MovingImage", "Registration", { { "NameOfInterface", { "FirstInterface" } } }, "First" );
+  blueprint.SetConnection( "MovingImage", "Registration", { { "NameOfInterface", { "SecondInterface" } } }, "Second" );
+  EXPECT_TRUE( blueprint.SetReplication( "Batch", { "MovingImage", "Registration" }, 3 ) );
+
+  const std::string fileName = this->dataManager->GetOutputFile( "WriteReadBinary.selxb" );
+  blueprint.WriteBinary( fileName );
+
+  BlueprintImpl compiled( logger );
+  EXPECT_NO_THROW( compiled.MergeFromFile( fileName ) );
+  EXPECT_EQ( blueprint.GetComponentNames(), compiled.GetComponentNames() );
+  for( const auto & componentName : blueprint.GetComponentNames() )
+  {
+    EXPECT_EQ( blueprint.GetComponent( componentName ), compiled.GetComponent( componentName ) );
+  }
+  EXPECT_EQ( blueprint.GetConnection( "FixedImage", "Registration", "" ), compiled.GetConnection( "FixedImage", "Registration", "" ) );
+  EXPECT_EQ( blueprint.GetConnection( "MovingImage", "Registration", "First" ), compiled.GetConnection( "MovingImage", "Registration", "First" ) );
+  EXPECT_EQ( blueprint.GetConnection( "MovingImage", "Registration", "Second" ), compiled.GetConnection( "MovingImage", "Registration", "Second" ) );
+  ASSERT_EQ( 1, compiled.GetReplications().size() );
+  EXPECT_EQ( ParameterValueType( { "MovingImage", "Registration" } ), compiled.GetReplications().at( "Batch" ).componentNames );
+  EXPECT_EQ( 3, compiled.GetReplications().at( "Batch" ).numberOfReplicas );
+
+  // Loading it again merges without changes
+  const auto modifiedTime = compiled.GetModifiedTime();
+  EXPECT_NO_THROW( compiled.MergeFromFile( fileName ) );
+  EXPECT_EQ( modifiedTime, compiled.GetModifiedTime() );
+
+  // Truncated and foreign files are rejected before any of them is used
+  std::string contents;
+  {
+    std::ifstream file( fileName, std::ios::binary );
+    contents.assign( std::istreambuf_iterator< char >( file ), std::istreambuf_iterator< char >() );
+  }
+  const std::string truncatedFileName = this->dataManager->GetOutputFile( "WriteReadBinaryTruncated.selxb" );
+  std::ofstream( truncatedFileName, std::ios::binary ) << contents.substr( 0, contents.size() - 1 );
+  BlueprintImpl truncated( logger );
+  EXPECT_THROW( truncated.MergeFromFile( truncatedFileName ), std::runtime_error );
+  EXPECT_EQ( 0, truncated.GetComponentNames().size() );
+
+  const std::string foreignFileName = this->dataManager->GetOutputFile( "WriteReadBinaryForeign.selxb" );
+  std::ofstream( foreignFileName, std::ios::binary ) << "{ \"Component\": { \"Name\": \"A\" } }";
+  EXPECT_THROW( truncated.MergeFromFile( foreignFileName ), std::runtime_error );
+}
+
+TEST_F( BlueprintTest, ReadBinaryBenchmark )
+{
+  // Benchmark of loading a compiled blueprint with large elastix-like parameter maps, against reading it from json
+  const int numberOfComponents = 200;
+  const int numberOfParameters = 100;
+  const int numberOfValues     = 16;
+
+  LoggerImpl logger;
+  logger.SetLogLevel( LogLevel::OFF );
+  BlueprintImpl blueprint( logger );
+  for( int component = 0; component < numberOfComponents; ++component )
+  {
+    ParameterMapType componentParameterMap;
+    for( int parameter = 0; parameter < numberOfParameters; ++parameter )
+    {
+      for( int value = 0; value < numberOfValues; ++value )
+      {
+        componentParameterMap[ "Parameter" + std::to_string( parameter ) ].push_back( std::to_string( value * 0.25 ) );
+      }
+    }
+    blueprint.SetComponent( "Component" + std::to_string( component ), componentParameterMap );
+  }
+
+  const std::string jsonFileName = this->dataManager->GetOutputFile( "ReadBinaryBenchmark.json" );
+  {
+    std::ofstream out( jsonFileName );
+    out << "{\n";
+    for( const auto & componentName : blueprint.GetComponentNames() )
+    {
+      out << "  \"Component\": {\n    \"Name\": \"" << componentName << "\"";
+      for( const auto & parameter : blueprint.GetComponent( componentName ) )
+      {
+        out << ",\n    \"" << parameter.first << "\": [";
+        for( std::size_t value = 0; value < parameter.second.size(); ++value )
+        {
+          out << ( value > 0 ? ", " : " " ) << "\"" << parameter.second[ value ] << "\"";
+        }
+        out << " ]";
+      }
+      out << "\n  }" << ( componentName == blueprint.GetComponentNames().back() ? "\n" : ",\n" );
+    }
+    out << "}\n";
+  }
+  const std::string binaryFileName = this->dataManager->GetOutputFile( "ReadBinaryBenchmark.selxb" );
+  blueprint.WriteBinary( binaryFileName );
+
+  // The allocations of the graph itself: the parameter maps with their strings, and the components
+  std::size_t allocations = numberOfAllocations;
+  {
+    BlueprintImpl graph( logger );
+    for( const auto & componentName : blueprint.GetComponentNames() )
+    {
+      graph.SetComponent( componentName, blueprint.GetComponent( componentName ) );
+    }
+  }
+  const std::size_t graphAllocations = numberOfAllocations - allocations;
+
+  allocations = numberOfAllocations;
+  auto start  = std::chrono::steady_clock::now();
+  BlueprintImpl fromJson( logger );
+  fromJson.MergeFromFile( jsonFileName );
+  const std::chrono::duration< double, std::milli > jsonDuration = std::chrono::steady_clock::now() - start;
+  const std::size_t jsonAllocations = numberOfAllocations - allocations;
+
+  allocations = numberOfAllocations;
+  start       = std::chrono::steady_clock::now();
+  BlueprintImpl fromBinary( logger );
+  fromBinary.MergeFromFile( binaryFileName );
+  const std::chrono::duration< double, std::milli > binaryDuration = std::chrono::steady_clock::now() - start;
+  const std::size_t binaryAllocations = numberOfAllocations - allocations;
+
+  RecordProperty( "GraphAllocations", std::to_string( graphAllocations ) );
+  RecordProperty( "JsonMilliseconds", std::to_string( jsonDuration.count() ) );
+  RecordProperty( "JsonAllocations", std::to_string( jsonAllocations ) );
+  RecordProperty( "BinaryMilliseconds", std::to_string( binaryDuration.count() ) );
+  RecordProperty( "BinaryAllocations", std::to_string( binaryAllocations ) );
+
+  EXPECT_EQ( numberOfComponents, fromBinary.GetComponentNames().size() );
+  EXPECT_EQ( fromJson.GetComponent( "Component7" ), fromBinary.GetComponent( "Component7" ) );
+  // Apart from the strings and parameter maps of the graph, loading a compiled blueprint allocates a number of times
+  // that does not depend on its size: the file cache entry, the section arrays and the components of the graph.
+  EXPECT_LE( binaryAllocations, graphAllocations + 128 );
+}
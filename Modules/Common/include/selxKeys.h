@@ -37,6 +37,10 @@ const char * const Dimensionality               = "Dimensionality";
 const char * const PixelType                    = "PixelType";                                // Template POD parameter
 const char * const InternalComputationValueType = "InternalComputationValueType";             // Template POD parameter for transforms or optimizers etc.
 const char * const CoordRepType                = "CoordRepType";
+const char * const NumberOfThreads              = "NumberOfThreads";                          // Supported by all Components, limits their internal multithreading
+const char * const SelectionPolicy              = "SelectionPolicy";                          // Supported by all Components, how to choose if multiple components satisfy all criteria
+const char * const Unique                       = "Unique";                                   // SelectionPolicy (default): more criteria are needed
+const char * const LowestCost                   = "LowestCost";                               // SelectionPolicy: the component with the lowest estimated cost
 
 const char * const SourceInterface                      = "SourceInterface";                      // Special interface that connects to the outside of the SuperElastixFilter
 const char * const SinkInterface                        = "SinkInterface";                        // Special interface that connects to the outside of the SuperElastixFilter
@@ -17,15 +17,14 @@
  *
  *=========================================================================*/
 
-#include "selxNetworkBuilder.h"
-#include "selxNetworkBuilderFactory.h"
+#include "selxModuleDisplacementFieldImageWarper.h"
+#include "selxComponentRegistry.h"
 
 namespace selx
 {
-template< typename ComponentList >
-std::unique_ptr< NetworkBuilderBase >
-NetworkBuilderFactory< ComponentList >::New( LoggerImpl & logger, const BlueprintImpl & blueprint )
+void
+RegisterModuleDisplacementFieldImageWarperComponents( ComponentRegistry & registry )
 {
-  return std::unique_ptr< NetworkBuilderBase >( new NetworkBuilder< ComponentList >( logger, blueprint ) );
+  registry.RegisterComponents< ModuleDisplacementFieldImageWarperComponents >();
 }
 } // end namespace selx
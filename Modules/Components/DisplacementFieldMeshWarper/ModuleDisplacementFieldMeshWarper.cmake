@@ -22,3 +22,15 @@ set(${MODULE}_INCLUDE_DIRS
 
 set( ${MODULE}_TEST_SOURCE_FILES
   ${${MODULE}_SOURCE_DIR}/test/selxDisplacementFieldMeshWarperTest.cxx)
+
+set( ${MODULE}_SOURCE_FILES
+  ${${MODULE}_SOURCE_DIR}/src/selxModuleDisplacementFieldMeshWarper.cxx
+)
+
+set( ${MODULE}_LIBRARIES
+  ${MODULE}
+)
+
+set( ${MODULE}_MODULE_DEPENDENCIES
+  ModuleCore
+)
@@ -34,13 +34,15 @@ set( ${MODULE}_INCLUDE_DIRS
 )
 
 set( ${MODULE}_SOURCE_FILES
+  ${${MODULE}_SOURCE_DIR}/src/selxModuleElastix.cxx
 )
 
 set( ${MODULE}_TEST_SOURCE_FILES 
   ${${MODULE}_SOURCE_DIR}/test/selxElastixComponentTest.cxx
 )
 
-set( ${MODULE}_LIBRARIES 
+set( ${MODULE}_LIBRARIES
+  ${MODULE}
   elastix
   transformix
 )
@@ -55,3 +57,7 @@ set( ${MODULE}_LIBRARY_DIRS
 #
 # add_library( transformix STATIC IMPORTED )
 # set_property( TARGET transformix PROPERTY IMPORTED_LOCATION ${ELASTIX_DIR}/src/bin/transformix.a )
+
+set( ${MODULE}_MODULE_DEPENDENCIES
+  ModuleCore
+)
@@ -111,6 +111,29 @@ template< int Dimensionality, class TPixel >
 void
 MonolithicElastixComponent< Dimensionality, TPixel >::Update( void )
 {
+  // The random samplers of elastix, such as RandomCoordinate, are seeded by the RandomSeed parameter
+  if( this->m_RandomSeed != 0 )
+  {
+    elxParameterObjectPointer elxParameterObject = this->m_elastixFilter->GetParameterObject();
+    elxParameterObjectPointer newParameterObject = elxParameterObjectType::New();
+    for( unsigned int index = 0; index < elxParameterObject->GetNumberOfParameterMaps(); ++index )
+    {
+      typename elxParameterObjectType::ParameterMapType parameterMap = elxParameterObject->GetParameterMap( index );
+      parameterMap[ "RandomSeed" ] = { std::to_string( this->m_RandomSeed ) };
+      newParameterObject->AddParameterMap( parameterMap );
+    }
+    this->m_elastixFilter->SetParameterObject( newParameterObject );
+  }
+
+  // The metrics of elastix sum their values over the threads in the order in which these finish
+  if( this->m_IsDeterministic )
+  {
+    this->m_elastixFilter->SetNumberOfThreads( 1 );
+  }
+  else if( this->m_NumberOfThreads > 0 )
+  {
+    this->m_elastixFilter->SetNumberOfThreads( this->m_NumberOfThreads );
+  }
   this->m_elastixFilter->Update();
 }
 
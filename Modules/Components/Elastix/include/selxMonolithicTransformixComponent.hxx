@@ -157,6 +157,10 @@ MonolithicTransformixComponent< Dimensionality, TPixel >::Update( void )
 {
   // TODO currently, the pipeline with elastix and tranformix can only be created after the update of elastix
   this->m_transformixFilter->SetTransformParameterObject( this->m_TransformParameterObjectInterface->GetTransformParameterObject() );
+  if( this->m_NumberOfThreads > 0 )
+  {
+    this->m_transformixFilter->SetNumberOfThreads( this->m_NumberOfThreads );
+  }
 }
 
 
@@ -23,9 +23,11 @@ set( ${MODULE}_INCLUDE_DIRS
 )
 
 set( ${MODULE}_SOURCE_FILES
+  ${${MODULE}_SOURCE_DIR}/src/selxModuleExample.cxx
 )
 
-set( ${MODULE}_LIBRARIES 
+set( ${MODULE}_LIBRARIES
+  ${MODULE}
 )
 
 set( ${MODULE}_MODULE_DEPENDENCIES 
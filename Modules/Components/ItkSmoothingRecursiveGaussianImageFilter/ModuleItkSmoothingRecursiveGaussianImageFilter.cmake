@@ -21,15 +21,18 @@ set( ${MODULE}_INCLUDE_DIRS
   ${${MODULE}_SOURCE_DIR}/include
 )
 
-# This module is header-only and does not contain any source files
 set( ${MODULE}_SOURCE_FILES
+  ${${MODULE}_SOURCE_DIR}/src/selxModuleItkSmoothingRecursiveGaussianImageFilter.cxx
 )
 
-# This module is header-only and does not export any libraries
-set( ${MODULE}_LIBRARIES 
+set( ${MODULE}_LIBRARIES
+  ${MODULE}
 )
 
 set( ${MODULE}_TEST_SOURCE_FILES
   selxitkImageFilterTest.cxx
 )
 
+set( ${MODULE}_MODULE_DEPENDENCIES
+  ModuleCore
+)
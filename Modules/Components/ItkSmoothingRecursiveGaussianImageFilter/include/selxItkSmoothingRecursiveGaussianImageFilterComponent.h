@@ -65,6 +65,12 @@ public:
 
   virtual ItkImagePointer GetItkImage() override;
 
+  virtual std::size_t GetOutputMemorySize() override;
+
+  virtual ResourceEstimate GetResourceEstimate() override;
+
+  virtual void ReleaseData() override;
+
   //virtual bool MeetsCriteria(const CriteriaType &criteria);
   virtual bool MeetsCriterion( const ComponentBase::CriterionType & criterion ) override;
 
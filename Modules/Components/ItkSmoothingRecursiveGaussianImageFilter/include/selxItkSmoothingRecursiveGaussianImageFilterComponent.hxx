@@ -58,6 +58,42 @@ ItkSmoothingRecursiveGaussianImageFilterComponent< Dimensionality, TPixel >
 }
 
 
+template< int Dimensionality, class TPixel >
+std::size_t
+ItkSmoothingRecursiveGaussianImageFilterComponent< Dimensionality, TPixel >
+::GetOutputMemorySize()
+{
+  // The output has the size of the input, which is known before the filter is updated
+  if( this->m_theItkFilter->GetInput() == nullptr )
+  {
+    return 0;
+  }
+  return this->m_theItkFilter->GetInput()->GetLargestPossibleRegion().GetNumberOfPixels() * sizeof( PixelType );
+}
+
+
+template< int Dimensionality, class TPixel >
+ResourceEstimate
+ItkSmoothingRecursiveGaussianImageFilterComponent< Dimensionality, TPixel >
+::GetResourceEstimate()
+{
+  // The filter smooths along one dimension after the other, keeping the intermediate result in the real type
+  const std::size_t outputMemorySize = this->GetOutputMemorySize();
+  const std::size_t intermediateMemorySize = outputMemorySize / sizeof( PixelType ) * sizeof( typename itk::NumericTraits< PixelType >::RealType );
+  return { ResourceEstimate::RuntimeClass::Linear, outputMemorySize + intermediateMemorySize };
+}
+
+
+template< int Dimensionality, class TPixel >
+void
+ItkSmoothingRecursiveGaussianImageFilterComponent< Dimensionality, TPixel >
+::ReleaseData()
+{
+  // The itk pipeline regenerates the output if it is requested again
+  this->m_theItkFilter->GetOutput()->ReleaseData();
+}
+
+
 template< int Dimensionality, class TPixel >
 bool
 ItkSmoothingRecursiveGaussianImageFilterComponent< Dimensionality, TPixel >
@@ -46,17 +46,23 @@ set( ${MODULE}_INCLUDE_DIRS
 #endif(NOT WIN32)
 
 set( ${MODULE}_SOURCE_FILES
-  )
+  ${${MODULE}_SOURCE_DIR}/src/selxModuleNiftyreg.cxx
+)
 
 set( ${MODULE}_TEST_SOURCE_FILES
   ${${MODULE}_SOURCE_DIR}/test/selxNiftyregComponentTest.cxx
   ${${MODULE}_SOURCE_DIR}/test/selxNiftiItkConversionsTest.cxx
 )
 
-set( ${MODULE}_LIBRARIES 
+set( ${MODULE}_LIBRARIES
+  ${MODULE}
   ${PNG_LIBRARIES} 
   ${ZLIB_LIBRARIES}
   ${Niftyreg_LIBRARIES}
   ${Niftyreg__reg_ReadWriteImage_LIBRARY}
   ${Niftyreg__reg_f3d_LIBRARY}
 )
+
+set( ${MODULE}_MODULE_DEPENDENCIES
+  ModuleCore
+)
@@ -103,11 +103,18 @@ void
 ItkToNiftiImageSourceComponent< Dimensionality, TPixel >
 ::SetMiniPipelineInput( itk::DataObject::Pointer object )
 {
-  this->m_Image = dynamic_cast< ItkImageType * >( object.GetPointer() );
-  if( this->m_Image == nullptr )
+  ItkImageType * image = dynamic_cast< ItkImageType * >( object.GetPointer() );
+  if( image == nullptr )
   {
     throw std::runtime_error( "DataObject passed by the NetworkBuilder is not of the right ImageType or not at all an ImageType" );
   }
+
+  if( this->m_Image != nullptr && this->m_Image != image )
+  {
+    // The nifti images are converted when the components are connected.
+    this->m_Logger.Log( LogLevel::WRN, "ItkToNiftiImageSourceComponent '{0}' got a new input, which is only used after connecting the components again.", this->m_Name );
+  }
+  this->m_Image = image;
   return;
 }
 
@@ -28,6 +28,10 @@
 #include <string.h>
 #include <array>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 namespace selx
 {
 template< class TPixel >
@@ -63,13 +67,27 @@ public:
 
   virtual bool MeetsCriterion( const ComponentBase::CriterionType & criterion ) override;
 
+  virtual std::size_t GetOutputMemorySize() override;
+
+  virtual ResourceEstimate GetResourceEstimate() override;
+
+  virtual void ReleaseData() override;
+
   static const char * GetDescription() { return "NiftyregAladin Component"; }
 
 private:
 
+  // Called by NiftyReg at the end of each level. Reports the progress and aborts the registration by throwing when the
+  // network is cancelled.
+  static void ProgressCallback( float progress, void * component );
+
   reg_aladin< TPixel > *            m_reg_aladin;
   std::shared_ptr< nifti_image > m_reference_image;
   std::shared_ptr< nifti_image > m_floating_image;
+  // The number of levels of the image pyramids, as set by the NumberOfResolutions criterion
+  unsigned int m_NumberOfLevels;
+  // The number of levels that finished during the current Update
+  unsigned int m_NumberOfFinishedLevels;
   std::shared_ptr< nifti_image > m_warped_image;
 
 protected:
@@ -20,12 +20,17 @@
 #include "selxNiftyregAladinComponent.h"
 #include "selxCheckTemplateProperties.h"
 
+#include <limits>
+
 namespace selx
 {
 template< class TPixel >
-NiftyregAladinComponent< TPixel >::NiftyregAladinComponent( const std::string & name, LoggerImpl & logger ) : Superclass( name, logger )
+NiftyregAladinComponent< TPixel >::NiftyregAladinComponent( const std::string & name, LoggerImpl & logger ) : Superclass( name, logger ),
+  m_NumberOfLevels( 3 ), // the default of niftyreg
+  m_NumberOfFinishedLevels( 0 )
 {
   m_reg_aladin = new reg_aladin< TPixel >();
+  this->m_reg_aladin->SetProgressCallbackFunction( &Self::ProgressCallback, this );
 }
 
 
@@ -78,13 +83,50 @@ NiftyregAladinComponent< TPixel >
   return this->m_reg_aladin->GetTransformationMatrix();
 }
 
+template< class TPixel >
+void
+NiftyregAladinComponent< TPixel >
+::ProgressCallback( float /* progress */, void * component )
+{
+  Self * self = static_cast< Self * >( component );
+  self->ReportProgress( self->m_NumberOfFinishedLevels++, 0, std::numeric_limits< double >::quiet_NaN() );
+  self->m_CancellationToken->ThrowIfCancelled();
+}
+
 template< class TPixel >
 void
 NiftyregAladinComponent<  TPixel >
 ::Update()
 {
   this->m_Logger.Log(LogLevel::TRC, "Update: run registration");
-  this->m_reg_aladin->Run();
+  this->m_NumberOfFinishedLevels = 0;
+#ifdef _OPENMP
+  // NiftyReg parallelizes by OpenMP, the number of threads is set for the calling thread only
+  // A deterministic network avoids the OpenMP reductions of NiftyReg, whose sums depend on the number of threads
+  const int numberOfOpenMPThreads = omp_get_max_threads();
+  if( this->m_IsDeterministic )
+  {
+    omp_set_num_threads( 1 );
+  }
+  else if( this->m_NumberOfThreads > 0 )
+  {
+    omp_set_num_threads( this->m_NumberOfThreads );
+  }
+#endif
+  try
+  {
+    this->m_reg_aladin->Run();
+  }
+  catch( ... )
+  {
+#ifdef _OPENMP
+    omp_set_num_threads( numberOfOpenMPThreads );
+#endif
+    throw;
+  }
+#ifdef _OPENMP
+  omp_set_num_threads( numberOfOpenMPThreads );
+#endif
   nifti_image * outputWarpedImage = m_reg_aladin->GetFinalWarpedImage();
   memset( outputWarpedImage->descrip, 0, 80 );
   strcpy( outputWarpedImage->descrip, "Warped image using NiftyReg (reg_aladin)" );
@@ -95,6 +137,44 @@ NiftyregAladinComponent<  TPixel >
 }
 
 
+template< class TPixel >
+std::size_t
+NiftyregAladinComponent< TPixel >
+::GetOutputMemorySize()
+{
+  // The warped image is defined on the reference image
+  return this->m_reference_image ? this->m_reference_image->nvox * sizeof( TPixel ) : 0;
+}
+
+
+template< class TPixel >
+ResourceEstimate
+NiftyregAladinComponent< TPixel >
+::GetResourceEstimate()
+{
+  if( !this->m_reference_image || !this->m_floating_image )
+  {
+    return { ResourceEstimate::RuntimeClass::Iterative, 0 };
+  }
+  // Niftyreg keeps all levels of both image pyramids. At the finest level it warps the floating image by a
+  // deformation field on the reference grid.
+  const std::size_t pyramidsMemorySize
+    = ResourceEstimate::GetPyramidMemorySize( this->m_reference_image->nvox, sizeof( TPixel ), this->m_reference_image->ndim, this->m_NumberOfLevels )
+    + ResourceEstimate::GetPyramidMemorySize( this->m_floating_image->nvox, sizeof( TPixel ), this->m_floating_image->ndim, this->m_NumberOfLevels );
+  const std::size_t deformationFieldMemorySize = this->m_reference_image->nvox * this->m_reference_image->ndim * sizeof( TPixel );
+  return { ResourceEstimate::RuntimeClass::Iterative, pyramidsMemorySize + deformationFieldMemorySize + this->GetOutputMemorySize() };
+}
+
+
+template< class TPixel >
+void
+NiftyregAladinComponent< TPixel >
+::ReleaseData()
+{
+  this->m_warped_image.reset();
+}
+
+
 template< class TPixel >
 bool
 NiftyregAladinComponent<  TPixel >
@@ -134,6 +214,7 @@ NiftyregAladinComponent<  TPixel >
     {
       // try catch?
       this->m_reg_aladin->SetNumberOfLevels(std::stoi(criterion.second[0]));
+      this->m_NumberOfLevels = std::stoi(criterion.second[0]);
     }
     else
     {
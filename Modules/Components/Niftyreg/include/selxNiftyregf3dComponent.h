@@ -28,6 +28,10 @@
 #include <string.h>
 #include <array>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 namespace selx
 {
 template< class TPixel >
@@ -71,15 +75,29 @@ public:
 
   virtual bool MeetsCriterion( const ComponentBase::CriterionType & criterion ) override;
 
+  virtual std::size_t GetOutputMemorySize() override;
+
+  virtual ResourceEstimate GetResourceEstimate() override;
+
+  virtual void ReleaseData() override;
+
   virtual bool ConnectionsSatisfied() override;
 
   static const char * GetDescription() { return "Niftyregf3d Component"; }
 
 private:
 
+  // Called by NiftyReg at the end of each level. Reports the progress and aborts the registration by throwing when the
+  // network is cancelled.
+  static void ProgressCallback( float progress, void * component );
+
   reg_f3d< TPixel > *            m_reg_f3d;
   std::shared_ptr< nifti_image > m_reference_image;
   std::shared_ptr< nifti_image > m_floating_image;
+  // The number of levels of the image pyramids, as set by the NumberOfResolutions criterion
+  unsigned int m_NumberOfLevels;
+  // The number of levels that finished during the current Update
+  unsigned int m_NumberOfFinishedLevels;
   // m_warped_images is an array of 2 nifti images. Depending on the use case, typically only [0] is a valid image
   std::unique_ptr< std::array< std::shared_ptr< nifti_image >, 2 >> m_warped_images;
   std::shared_ptr< nifti_image > m_cpp_image;
@@ -20,12 +20,17 @@
 #include "selxNiftyregf3dComponent.h"
 #include "selxCheckTemplateProperties.h"
 
+#include <limits>
+
 namespace selx
 {
 template< class TPixel >
-Niftyregf3dComponent< TPixel >::Niftyregf3dComponent( const std::string & name, LoggerImpl & logger ) : Superclass( name, logger )
+Niftyregf3dComponent< TPixel >::Niftyregf3dComponent( const std::string & name, LoggerImpl & logger ) : Superclass( name, logger ),
+  m_NumberOfLevels( 3 ), // the default of niftyreg
+  m_NumberOfFinishedLevels( 0 )
 {
   m_reg_f3d = new reg_f3d< TPixel >( 1, 1 );
+  this->m_reg_f3d->SetProgressCallbackFunction( &Self::ProgressCallback, this );
 }
 
 
@@ -73,6 +78,10 @@ std::shared_ptr< nifti_image >
 Niftyregf3dComponent< TPixel >
 ::GetWarpedNiftiImage()
 {
+  if( !this->m_warped_images )
+  {
+    return nullptr;
+  }
   return ( *( this->m_warped_images.get() ) )[ 0 ];
 }
 
@@ -84,19 +93,56 @@ Niftyregf3dComponent< TPixel >
   return this->m_cpp_image;
 }
 
+template< class TPixel >
+void
+Niftyregf3dComponent< TPixel >
+::ProgressCallback( float /* progress */, void * component )
+{
+  Self * self = static_cast< Self * >( component );
+  self->ReportProgress( self->m_NumberOfFinishedLevels++, 0, std::numeric_limits< double >::quiet_NaN() );
+  self->m_CancellationToken->ThrowIfCancelled();
+}
+
 template< class TPixel >
 void
 Niftyregf3dComponent< TPixel >
 ::Update()
 {
   this->m_Logger.Log(LogLevel::TRC, "Update: run registration");
+  this->m_NumberOfFinishedLevels = 0;
   //this->m_reg_f3d->UseSSD( 0, true );
   //this->m_reg_f3d->UseCubicSplineInterpolation();
   if (this->m_NiftyregAffineMatrixInterface)
   {
     this->m_reg_f3d->SetAffineTransformation(this->m_NiftyregAffineMatrixInterface->GetAffineNiftiMatrix());
   }
-  this->m_reg_f3d->Run();
+#ifdef _OPENMP
+  // NiftyReg parallelizes by OpenMP, the number of threads is set for the calling thread only
+  // A deterministic network avoids the OpenMP reductions of NiftyReg, whose sums depend on the number of threads
+  const int numberOfOpenMPThreads = omp_get_max_threads();
+  if( this->m_IsDeterministic )
+  {
+    omp_set_num_threads( 1 );
+  }
+  else if( this->m_NumberOfThreads > 0 )
+  {
+    omp_set_num_threads( this->m_NumberOfThreads );
+  }
+#endif
+  try
+  {
+    this->m_reg_f3d->Run();
+  }
+  catch( ... )
+  {
+#ifdef _OPENMP
+    omp_set_num_threads( numberOfOpenMPThreads );
+#endif
+    throw;
+  }
+#ifdef _OPENMP
+  omp_set_num_threads( numberOfOpenMPThreads );
+#endif
   nifti_image ** outputWarpedImage = m_reg_f3d->GetWarpedImage();
   memset( outputWarpedImage[ 0 ]->descrip, 0, 80 );
   strcpy( outputWarpedImage[ 0 ]->descrip, "Warped image using NiftyReg (reg_f3d) via SuperElastix" );
@@ -138,6 +184,45 @@ Niftyregf3dComponent< TPixel >
   return true;
 }
 
+template< class TPixel >
+std::size_t
+Niftyregf3dComponent< TPixel >
+::GetOutputMemorySize()
+{
+  // The warped image is defined on the reference image
+  return this->m_reference_image ? this->m_reference_image->nvox * sizeof( TPixel ) : 0;
+}
+
+
+template< class TPixel >
+ResourceEstimate
+Niftyregf3dComponent< TPixel >
+::GetResourceEstimate()
+{
+  if( !this->m_reference_image || !this->m_floating_image )
+  {
+    return { ResourceEstimate::RuntimeClass::Iterative, 0 };
+  }
+  // Niftyreg keeps all levels of both image pyramids. At the finest level it warps the floating image and computes a
+  // deformation field and its voxel based gradient on the reference grid.
+  const std::size_t pyramidsMemorySize
+    = ResourceEstimate::GetPyramidMemorySize( this->m_reference_image->nvox, sizeof( TPixel ), this->m_reference_image->ndim, this->m_NumberOfLevels )
+    + ResourceEstimate::GetPyramidMemorySize( this->m_floating_image->nvox, sizeof( TPixel ), this->m_floating_image->ndim, this->m_NumberOfLevels );
+  const std::size_t deformationFieldMemorySize = this->m_reference_image->nvox * this->m_reference_image->ndim * sizeof( TPixel );
+  return { ResourceEstimate::RuntimeClass::Iterative, pyramidsMemorySize + 2 * deformationFieldMemorySize + this->GetOutputMemorySize() };
+}
+
+
+template< class TPixel >
+void
+Niftyregf3dComponent< TPixel >
+::ReleaseData()
+{
+  this->m_warped_images.reset();
+  this->m_cpp_image.reset();
+}
+
+
 /* Niftyreg member functions:
 void SetControlPointGridImage(nifti_image *);
 void SetBendingEnergyWeight(T);
@@ -306,6 +391,7 @@ Niftyregf3dComponent<  TPixel >
     {
       // try catch?
       this->m_reg_f3d->SetLevelNumber( std::stoi( criterion.second[ 0 ] ) );
+      this->m_NumberOfLevels = std::stoi( criterion.second[ 0 ] );
     }
     else
     {
@@ -22,16 +22,17 @@ set( ${MODULE}_INCLUDE_DIRS
   ${${MODULE}_SOURCE_DIR}/interfaces
 )
 
-# This module is header-only and does not contain any source files
 set( ${MODULE}_SOURCE_FILES
+  ${${MODULE}_SOURCE_DIR}/src/selxModuleSinksAndSources.cxx
 )
 
-# This module is header-only and does not export any libraries
-set( ${MODULE}_LIBRARIES 
+set( ${MODULE}_LIBRARIES
+  ${MODULE}
 )
 
 set( ${MODULE}_TEST_SOURCE_FILES )
 
-set( ${MODULE}_MODULE_DEPENDENCIES 
+set( ${MODULE}_MODULE_DEPENDENCIES
+  ModuleCore
 )
 
@@ -67,11 +67,22 @@ void
 ItkDisplacementFieldSourceComponent< Dimensionality, TPixel >
 ::SetMiniPipelineInput( itk::DataObject::Pointer object )
 {
-  this->m_DisplacementField = dynamic_cast< ItkDisplacementFieldType * >( object.GetPointer() );
-  if( this->m_DisplacementField == nullptr )
+  ItkDisplacementFieldType * displacementField = dynamic_cast< ItkDisplacementFieldType * >( object.GetPointer() );
+  if( displacementField == nullptr )
   {
     throw std::runtime_error( "DataObject passed by the NetworkBuilder is not of the right DisplacementFieldType or not at all an DisplacementFieldType" );
   }
+
+  if( this->m_DisplacementField == nullptr || this->m_DisplacementField == displacementField )
+  {
+    this->m_DisplacementField = displacementField;
+  }
+  else
+  {
+    // Rebinding a connected network: graft onto the displacement field the connected components already hold
+    displacementField->Update();
+    this->m_DisplacementField->Graft( displacementField );
+  }
   return;
 }
 
@@ -85,6 +85,10 @@ public:
   virtual void SetMiniPipelineInput( itk::DataObject::Pointer ) override;
   virtual AnyFileReader::Pointer GetInputFileReader( void ) override;
 
+  virtual std::size_t GetOutputMemorySize() override;
+
+  virtual ResourceEstimate GetResourceEstimate() override;
+
   virtual bool MeetsCriterion( const ComponentBase::CriterionType & criterion ) override;
 
   static const char * GetDescription() { return "ItkImageSource Component"; }
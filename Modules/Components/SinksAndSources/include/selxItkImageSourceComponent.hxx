@@ -117,11 +117,23 @@ void
 ItkImageSourceComponent< Dimensionality, TPixel >
 ::SetMiniPipelineInput( itk::DataObject::Pointer object )
 {
-  this->m_Image = dynamic_cast< ItkImageType * >( object.GetPointer() );
-  if( this->m_Image == nullptr )
+  ItkImageType * image = dynamic_cast< ItkImageType * >( object.GetPointer() );
+  if( image == nullptr )
   {
     throw std::runtime_error( "DataObject passed by the NetworkBuilder is not of the right ImageType or not at all an ImageType" );
   }
+
+  if( this->m_Image == nullptr || this->m_Image == image )
+  {
+    this->m_Image = image;
+  }
+  else
+  {
+    // A new input for an already connected network: the connected components hold on to m_Image, hence the new
+    // input is grafted onto it. The pipeline of the new input cannot be reached from there, so it is updated first.
+    image->Update();
+    this->m_Image->Graft( image );
+  }
   return;
 }
 
@@ -135,6 +147,27 @@ ItkImageSourceComponent< Dimensionality, TPixel >::GetInputFileReader()
 }
 
 
+template< int Dimensionality, class TPixel >
+std::size_t
+ItkImageSourceComponent< Dimensionality, TPixel >::GetOutputMemorySize()
+{
+  if( this->m_Image == nullptr )
+  {
+    return 0;
+  }
+  return this->m_Image->GetLargestPossibleRegion().GetNumberOfPixels() * sizeof( TPixel );
+}
+
+
+template< int Dimensionality, class TPixel >
+ResourceEstimate
+ItkImageSourceComponent< Dimensionality, TPixel >::GetResourceEstimate()
+{
+  // The input, e.g. read from file, passes through as is
+  return { ResourceEstimate::RuntimeClass::Linear, this->GetOutputMemorySize() };
+}
+
+
 template< int Dimensionality, class TPixel >
 bool
 ItkImageSourceComponent< Dimensionality, TPixel >
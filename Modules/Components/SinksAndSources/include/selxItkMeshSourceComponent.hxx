@@ -54,11 +54,22 @@ void
 ItkMeshSourceComponent< Dimensionality, TPixel >
 ::SetMiniPipelineInput( itk::DataObject::Pointer object )
 {
-  this->m_Mesh = dynamic_cast< ItkMeshType * >( object.GetPointer() );
-  if( this->m_Mesh == nullptr )
+  ItkMeshType * mesh = dynamic_cast< ItkMeshType * >( object.GetPointer() );
+  if( mesh == nullptr )
   {
     throw std::runtime_error( "DataObject passed by the NetworkBuilder is not of the right MeshType or not at all an MeshType" );
   }
+
+  if( this->m_Mesh == nullptr || this->m_Mesh == mesh )
+  {
+    this->m_Mesh = mesh;
+  }
+  else
+  {
+    // Rebinding a connected network: graft onto the mesh the connected components already hold
+    mesh->Update();
+    this->m_Mesh->Graft( mesh );
+  }
   return;
 }
 
@@ -67,11 +67,22 @@ void
 ItkVectorImageSourceComponent< Dimensionality, TPixel >
 ::SetMiniPipelineInput( itk::DataObject::Pointer object )
 {
-  this->m_VectorImage = dynamic_cast< ItkVectorImageType * >( object.GetPointer() );
-  if( this->m_VectorImage == nullptr )
+  ItkVectorImageType * vectorImage = dynamic_cast< ItkVectorImageType * >( object.GetPointer() );
+  if( vectorImage == nullptr )
   {
     throw std::runtime_error( "DataObject passed by the NetworkBuilder is not of the right VectorImageType or not at all an VectorImageType" );
   }
+
+  if( this->m_VectorImage == nullptr || this->m_VectorImage == vectorImage )
+  {
+    this->m_VectorImage = vectorImage;
+  }
+  else
+  {
+    // Rebinding a connected network: graft onto the vector image the connected components already hold
+    vectorImage->Update();
+    this->m_VectorImage->Graft( vectorImage );
+  }
   return;
 }
 
@@ -33,6 +33,8 @@ set( ${MODULE}_SOURCE_FILES
   ${${MODULE}_SOURCE_DIR}/src/selxSSDMetric4thPartyComponent.cxx
   ${${MODULE}_SOURCE_DIR}/src/selxTransformComponent1.cxx
   ${${MODULE}_SOURCE_DIR}/src/selxMetricComponent1.cxx
+  ${${MODULE}_SOURCE_DIR}/src/selxUpdateComponent1.cxx
+  ${${MODULE}_SOURCE_DIR}/src/selxModuleTest.cxx
 )
 
 set( ${MODULE}_LIBRARIES 
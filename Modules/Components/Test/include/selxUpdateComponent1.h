@@ -0,0 +1,99 @@
+/*=========================================================================
+ *
+ *  Copyright Leiden University Medical Center, Erasmus University Medical
+ *  Center and contributors
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#ifndef selxUpdateComponent1_h
+#define selxUpdateComponent1_h
+
+#include "selxSuperElastixComponent.h"
+
+#include "selxExamplesInterfaces.h"
+
+#include <atomic>
+#include <chrono>
+
+namespace selx
+{
+/** \class UpdateComponent1
+ * \brief A configurable component that is updated by the network, to test the execution of networks.
+ *
+ * The tests configure its public members: the size of its output, its resource estimate, whether its update throws,
+ * and the number of iterations of its update. At each iteration the update polls its cancellation token and reports
+ * progress, like an optimizer. The number of updates is checkpointed.
+ */
+class UpdateComponent1 :
+  public SuperElastixComponent<
+  Accepting< TransformedImageInterface >,
+  Providing< TransformedImageInterface, UpdateInterface >
+  >
+{
+public:
+
+  /** Standard class typedefs. */
+  typedef UpdateComponent1              Self;
+  typedef ComponentBase                 Superclass;
+  typedef std::shared_ptr< Self >       Pointer;
+  typedef std::shared_ptr< const Self > ConstPointer;
+
+  typedef Superclass::CriteriaType  CriteriaType;
+  typedef Superclass::CriterionType CriterionType;
+
+  UpdateComponent1( const std::string & name, LoggerImpl & logger ) : SuperElastixComponent( name, logger ) {}
+  virtual ~UpdateComponent1() {}
+
+  virtual int Accept( TransformedImageInterface::Pointer ) override { return 0; }
+
+  virtual int GetTransformedImage() override { return 0; }
+
+  virtual void Update() override;
+
+  virtual std::size_t GetOutputMemorySize() override { return this->m_OutputMemorySize; }
+
+  virtual void ReleaseData() override { ++this->m_NumberOfReleases; }
+
+  virtual ResourceEstimate GetResourceEstimate() override { return this->m_Estimate; }
+
+  virtual bool WriteCheckpoint( const std::string & directory ) override;
+
+  virtual bool ReadCheckpoint( const std::string & directory ) override;
+
+  virtual bool MeetsCriterion( const CriterionType & criterion ) override;
+
+  static const char * GetDescription() { return "Example Update Component 1"; }
+
+  // Configuration
+  std::size_t               m_OutputMemorySize = 0;
+  ResourceEstimate          m_Estimate = { ResourceEstimate::RuntimeClass::Unknown, 0 };
+  bool                      m_Throw = false;
+  unsigned int              m_NumberOfLevels = 1;
+  std::size_t               m_NumberOfIterations = 0;
+  std::chrono::milliseconds m_IterationDuration = std::chrono::milliseconds( 0 );
+
+  // Observations
+  std::atomic< unsigned int > m_NumberOfUpdates{ 0 };
+  unsigned int                m_NumberOfReleases = 0;
+  unsigned int                m_Result = 0;
+
+private:
+
+  UpdateComponent1( const Self & ); // purposely not implemented
+  void operator=( const Self & );   // purposely not implemented
+};
+} // end namespace selx
+
+#endif // selxUpdateComponent1_h
@@ -0,0 +1,84 @@
+/*=========================================================================
+ *
+ *  Copyright Leiden University Medical Center, Erasmus University Medical
+ *  Center and contributors
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "selxUpdateComponent1.h"
+
+#include <fstream>
+#include <stdexcept>
+#include <thread>
+
+namespace selx
+{
+void
+UpdateComponent1::Update()
+{
+  ++this->m_NumberOfUpdates;
+  if( this->m_Throw )
+  {
+    throw std::runtime_error( "Update of " + this->m_Name + " failed" );
+  }
+  for( unsigned int level = 0; level < this->m_NumberOfLevels; ++level )
+  {
+    for( std::size_t iteration = 0; iteration < this->m_NumberOfIterations; ++iteration )
+    {
+      if( this->m_CancellationToken )
+      {
+        this->m_CancellationToken->ThrowIfCancelled();
+      }
+      this->ReportProgress( level, iteration, 1.0 / ( iteration + 1 ) );
+      std::this_thread::sleep_for( this->m_IterationDuration );
+    }
+  }
+  this->m_Result = this->m_NumberOfUpdates;
+}
+
+
+bool
+UpdateComponent1::WriteCheckpoint( const std::string & directory )
+{
+  std::ofstream file( directory + "/Result.txt" );
+  return static_cast< bool >( file << this->m_Result );
+}
+
+
+bool
+UpdateComponent1::ReadCheckpoint( const std::string & directory )
+{
+  std::ifstream file( directory + "/Result.txt" );
+  return static_cast< bool >( file >> this->m_Result );
+}
+
+
+bool
+UpdateComponent1::MeetsCriterion( const CriterionType & criterion )
+{
+  if( criterion.first == "NameOfClass" )
+  {
+    for( auto const & criterionValue : criterion.second )
+    {
+      if( criterionValue != "UpdateComponent1" )
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+  return false;
+}
+} // end namespace selx
@@ -46,27 +46,38 @@ ItkGaussianExponentialDiffeomorphicTransformParametersAdaptorsContainerComponent
 
   for( unsigned int level = 0; level < m_shrinkFactorsPerLevel.Size(); level++ )
   {
-    // We use the shrink image filter to calculate the fixed parameters of the virtual
-    // domain at each level.  To speed up calculation and avoid unnecessary memory
-    // usage, we could calculate these fixed parameters directly.
-
-    typedef itk::Image< TransformInternalComputationValueType, Dimensionality > FixedImageType;
-
-    typename FixedImageType::Pointer fixedImage = FixedImageType::New();
-    fixedImage->CopyInformation( fixedImageDomain );
-    //fixedImage->Allocate();
-
-    typedef itk::ShrinkImageFilter< FixedImageType, FixedImageType > ShrinkFilterType;
-    typename ShrinkFilterType::Pointer shrinkFilter = ShrinkFilterType::New();
-    shrinkFilter->SetShrinkFactors( m_shrinkFactorsPerLevel[ level ] );
-    shrinkFilter->SetInput( fixedImage );
-    shrinkFilter->UpdateOutputInformation();
+    // The shrunk domain of a level is computed once per network, e.g. for all replicas of a registration
+    // that share the fixed image.
+    const auto shrinkFactor = m_shrinkFactorsPerLevel[ level ];
+    typename FixedImageDomainType::Pointer shrunkDomain = this->m_DerivedDataCache->template Get< FixedImageDomainType >(
+      fixedImageDomain, "ShrinkImageDomain", { std::to_string( shrinkFactor ) }, [ &fixedImageDomain, shrinkFactor ]()
+      {
+        // We use the shrink image filter to calculate the fixed parameters of the virtual
+        // domain at each level.  To speed up calculation and avoid unnecessary memory
+        // usage, we could calculate these fixed parameters directly.
+
+        typedef itk::Image< TransformInternalComputationValueType, Dimensionality > FixedImageType;
+
+        typename FixedImageType::Pointer fixedImage = FixedImageType::New();
+        fixedImage->CopyInformation( fixedImageDomain );
+        //fixedImage->Allocate();
+
+        typedef itk::ShrinkImageFilter< FixedImageType, FixedImageType > ShrinkFilterType;
+        typename ShrinkFilterType::Pointer shrinkFilter = ShrinkFilterType::New();
+        shrinkFilter->SetShrinkFactors( shrinkFactor );
+        shrinkFilter->SetInput( fixedImage );
+        shrinkFilter->UpdateOutputInformation();
+
+        typename FixedImageType::Pointer shrunkImage = shrinkFilter->GetOutput();
+        shrunkImage->DisconnectPipeline();
+        return shrunkImage;
+      } );
 
     typename TransformParametersAdaptorType::Pointer transformAdaptor = TransformParametersAdaptorType::New();
-    transformAdaptor->SetRequiredSpacing( shrinkFilter->GetOutput()->GetSpacing() );
-    transformAdaptor->SetRequiredSize( shrinkFilter->GetOutput()->GetLargestPossibleRegion().GetSize() );
-    transformAdaptor->SetRequiredDirection( shrinkFilter->GetOutput()->GetDirection() );
-    transformAdaptor->SetRequiredOrigin( shrinkFilter->GetOutput()->GetOrigin() );
+    transformAdaptor->SetRequiredSpacing( shrunkDomain->GetSpacing() );
+    transformAdaptor->SetRequiredSize( shrunkDomain->GetLargestPossibleRegion().GetSize() );
+    transformAdaptor->SetRequiredDirection( shrunkDomain->GetDirection() );
+    transformAdaptor->SetRequiredOrigin( shrunkDomain->GetOrigin() );
 
     m_adaptors.push_back( transformAdaptor.GetPointer() ); // Implicit cast back to TransformParametersAdaptorBase<itk::Transform<...>>
   }
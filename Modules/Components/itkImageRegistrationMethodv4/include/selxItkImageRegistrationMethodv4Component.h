@@ -119,6 +119,13 @@ public:
 
   virtual bool ConnectionsSatisfied() override;
 
+  virtual ResourceEstimate GetResourceEstimate() override;
+
+  // The optimized transform is written to and read from an HDF5 transform file in the checkpoint directory
+  virtual bool WriteCheckpoint( const std::string & directory ) override;
+
+  virtual bool ReadCheckpoint( const std::string & directory ) override;
+
   //static const char * GetName() { return "ItkImageRegistrationMethodv4"; } ;
   static const char * GetDescription() { return "ItkImageRegistrationMethodv4 Component"; }
 
@@ -131,6 +138,9 @@ private:
   std::string m_NumberOfLevelsLastSetBy;
   typename TransformParametersAdaptorsContainerInterfaceType::Pointer m_TransformAdaptorsContainerInterface;
 
+  // The transform read by ReadCheckpoint, provided instead of the result of the filter until the next Update
+  TransformPointer m_CheckpointTransform;
+
 protected:
 
   // return the class name and the template arguments to uniquely identify this component.
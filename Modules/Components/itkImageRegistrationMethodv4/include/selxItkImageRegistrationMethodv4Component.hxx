@@ -24,7 +24,16 @@
 #include "itkANTSNeighborhoodCorrelationImageToImageMetricv4.h"
 #include "itkGradientDescentOptimizerv4.h"
 #include "itkImageFileWriter.h"
+#include "itkTransformFileReader.h"
+#include "itkConstantVelocityFieldTransform.h"
+#include "itkDisplacementFieldTransform.h"
+#include "itkTransformFileWriter.h"
 #include "selxCheckTemplateProperties.h"
+#include "selxItkCancellationCommand.h"
+#include "selxItkObserverGuard.h"
+
+#include <sstream>
+
 namespace selx
 {
 template< typename TFilter >
@@ -40,9 +49,17 @@ public:
   typedef itk::GradientDescentOptimizerv4 OptimizerType;
   typedef   const OptimizerType *         OptimizerPointer;
 
+  /** The component that logs the settings of each level and reports the progress of each iteration. The command
+   * observes the iteration events of the filter and, to observe each iteration of the optimization, of its optimizer. */
+  void SetComponent( ComponentBase * component, const TFilter * filter )
+  {
+    this->m_Component = component;
+    this->m_Filter    = filter;
+  }
+
 protected:
 
-  CommandIterationUpdate() {}
+  CommandIterationUpdate() : m_Component( nullptr ), m_Filter( nullptr ) {}
 
 public:
 
@@ -54,59 +71,54 @@ public:
 
   virtual void Execute( const itk::Object * object, const itk::EventObject & event ) ITK_OVERRIDE
   {
-    const TFilter * filter = static_cast< const TFilter * >( object );
+    if( this->m_Component == nullptr )
+    {
+      return;
+    }
+    const TFilter * filter = this->m_Filter;
     if( typeid( event ) == typeid( itk::MultiResolutionIterationEvent ) )
     {
       unsigned int currentLevel = filter->GetCurrentLevel();
       typename TFilter::ShrinkFactorsPerDimensionContainerType shrinkFactors = filter->GetShrinkFactorsPerDimension( currentLevel );
       typename TFilter::SmoothingSigmasArrayType smoothingSigmas             = filter->GetSmoothingSigmasPerLevel();
-      typename TFilter::TransformParametersAdaptorsContainerType adaptors    = filter->GetTransformParametersAdaptorsPerLevel();
+
+      std::ostringstream levelSettings;
+      levelSettings << "Level " << currentLevel << ": shrink factors " << shrinkFactors << ", smoothing sigma " << smoothingSigmas[ currentLevel ];
 
       // TODO optimizer is can be ObjectToObjectOptimizerBaseTemplate<double> or ObjectToObjectOptimizerBaseTemplate<float>
       // dynamic cast will fail on <float>, since GradientDescentOptimizerv4Type is by default <double>
-      auto * optimizerBase = filter->GetOptimizer();
       typedef itk::GradientDescentOptimizerv4 GradientDescentOptimizerv4Type;
-      typename GradientDescentOptimizerv4Type::ConstPointer optimizer = dynamic_cast< const GradientDescentOptimizerv4Type * >( optimizerBase );
-      if( !optimizer )
-      {
-        itkGenericExceptionMacro( "Error dynamic_cast failed" );
-      }
-      typename GradientDescentOptimizerv4Type::DerivativeType gradient = optimizer->GetGradient();
-
-      //debug:
-      std::cout << "  CL Current level:           " << currentLevel << std::endl;
-      std::cout << "   SF Shrink factor:          " << shrinkFactors << std::endl;
-      std::cout << "   SS Smoothing sigma:        " << smoothingSigmas[ currentLevel ] << std::endl;
-      //std::cout << "   RFP Required fixed params: " << adaptors[ currentLevel ]->GetRequiredFixedParameters() << std::endl;
-      std::cout << "   LR Final learning rate:    " << optimizer->GetLearningRate() << std::endl;
-      std::cout << "   FM Final metric value:     " << optimizer->GetCurrentMetricValue() << std::endl;
-      std::cout << "   SC Optimizer scales:       " << optimizer->GetScales() << std::endl;
-      std::cout << "   FG Final metric gradient (sample of values): ";
-      if( gradient.GetSize() < 16 )
+      typename GradientDescentOptimizerv4Type::ConstPointer optimizer = dynamic_cast< const GradientDescentOptimizerv4Type * >( filter->GetOptimizer() );
+      if( optimizer )
       {
-        std::cout << gradient;
+        levelSettings << ", learning rate " << optimizer->GetLearningRate() << ", metric value " << optimizer->GetCurrentMetricValue()
+                      << ", optimizer scales " << optimizer->GetScales();
       }
-      else
-      {
-        for( itk::SizeValueType i = 0; i < gradient.GetSize(); i += ( gradient.GetSize() / 16 ) )
-        {
-          std::cout << gradient[ i ] << " ";
-        }
-      }
-      std::cout << std::endl;
+      this->m_Component->Debug( "{0}: {1}", this->m_Component->m_Name, levelSettings.str() );
     }
     else if( !( itk::IterationEvent().CheckEvent( &event ) ) )
     {
       return;
     }
+    else if( object == filter )
+    {
+      // Filters that iterate by themselves, such as SyN, invoke an iteration event at each iteration
+      this->m_Component->ReportProgress( filter->GetCurrentLevel(), filter->GetCurrentIteration(), filter->GetCurrentMetricValue() );
+    }
     else
     {
-      // OptimizerPointer optimizer = static_cast< OptimizerPointer >( object );
-      //std::cout << optimizer->GetCurrentIteration() << ": ";
-      //std::cout << optimizer->GetCurrentMetricValue() << std::endl;
-      //std::cout << optimizer->GetInfinityNormOfProjectedGradient() << std::endl;
+      const typename TFilter::OptimizerType * optimizer = dynamic_cast< const typename TFilter::OptimizerType * >( object );
+      if( optimizer )
+      {
+        this->m_Component->ReportProgress( filter->GetCurrentLevel(), optimizer->GetCurrentIteration(), optimizer->GetCurrentMetricValue() );
+      }
     }
   }
+
+private:
+
+  ComponentBase * m_Component;
+  const TFilter * m_Filter;
 };
 
 template< int Dimensionality, class TPixel, class InternalComputationValueType >
@@ -204,10 +216,41 @@ ItkImageRegistrationMethodv4Component< Dimensionality, TPixel, InternalComputati
 }
 
 
+template< int Dimensionality, class TPixel, class InternalComputationValueType >
+ResourceEstimate
+ItkImageRegistrationMethodv4Component< Dimensionality, TPixel, InternalComputationValueType >::GetResourceEstimate()
+{
+  typename FixedImageType::ConstPointer fixedImage   = this->m_theItkFilter->GetFixedImage();
+  typename MovingImageType::ConstPointer movingImage = this->m_theItkFilter->GetMovingImage();
+  if( fixedImage.IsNull() || movingImage.IsNull() )
+  {
+    return { ResourceEstimate::RuntimeClass::Iterative, 0 };
+  }
+
+  // At each level the filter smooths the fixed and moving images at their full size and shrinks the virtual domain, i.e.
+  // the fixed image domain, on which the metric computes its gradient of Dimensionality values per pixel. The finest
+  // level, with the smallest shrink factors, needs the most memory.
+  const unsigned int finestLevel = std::max< std::size_t >( this->m_theItkFilter->GetNumberOfLevels(), 1 ) - 1;
+  const auto shrinkFactors = this->m_theItkFilter->GetShrinkFactorsPerDimension( finestLevel );
+  const std::size_t fixedNumberOfPixels  = fixedImage->GetLargestPossibleRegion().GetNumberOfPixels();
+  const std::size_t movingNumberOfPixels = movingImage->GetLargestPossibleRegion().GetNumberOfPixels();
+  std::size_t virtualNumberOfPixels = fixedNumberOfPixels;
+  for( unsigned int dimension = 0; dimension < Dimensionality; ++dimension )
+  {
+    virtualNumberOfPixels /= std::max< std::size_t >( shrinkFactors[ dimension ], 1 );
+  }
+  return { ResourceEstimate::RuntimeClass::Iterative,
+           ( fixedNumberOfPixels + movingNumberOfPixels ) * sizeof( TPixel )
+           + virtualNumberOfPixels * Dimensionality * sizeof( InternalComputationValueType ) };
+}
+
+
 template< int Dimensionality, class TPixel, class InternalComputationValueType >
 void
 ItkImageRegistrationMethodv4Component< Dimensionality, TPixel, InternalComputationValueType >::Update( void )
 {
+  this->m_CheckpointTransform = nullptr;
+
   typename FixedImageType::ConstPointer fixedImage   = this->m_theItkFilter->GetFixedImage();
   typename MovingImageType::ConstPointer movingImage = this->m_theItkFilter->GetMovingImage();
 
@@ -249,20 +292,132 @@ ItkImageRegistrationMethodv4Component< Dimensionality, TPixel, InternalComputati
       );
   }
 
+  // All observers are removed when this update ends, also when it is cancelled
+  ItkObserverGuard observerGuard;
+
   typedef CommandIterationUpdate< TheItkFilterType > RegistrationCommandType;
   typename RegistrationCommandType::Pointer registrationObserver = RegistrationCommandType::New();
-  this->m_theItkFilter->AddObserver( itk::IterationEvent(), registrationObserver );
+  registrationObserver->SetComponent( this, this->m_theItkFilter );
+  observerGuard.AddObserver( this->m_theItkFilter, itk::IterationEvent(), registrationObserver );
+
+  // Cancelling the network aborts the registration at the next iteration of the optimizer
+  ItkCancellationCommand::Pointer cancellationCommand = ItkCancellationCommand::New();
+  cancellationCommand->SetCancellationToken( this->m_CancellationToken );
+  cancellationCommand->SetProcessObject( this->m_theItkFilter );
+  observerGuard.AddObserver( optimizer, itk::IterationEvent(), cancellationCommand );
+
+  // Observing each iteration of the optimizer is only worth its overhead when somebody listens to the progress
+  if( this->m_ProgressEventBuffer )
+  {
+    observerGuard.AddObserver( optimizer, itk::IterationEvent(), registrationObserver );
+  }
+
+  // Random sampling of the metric follows the seed of the network. A deterministic network reduces the metric values and
+  // gradients over the threads in a fixed order, which the filter, its metric and its optimizer only do on one thread.
+  if( this->m_RandomSeed != 0 )
+  {
+    this->m_theItkFilter->MetricSamplingReinitializeSeed( static_cast< int >( this->m_RandomSeed ) );
+  }
+  if( this->m_IsDeterministic )
+  {
+    this->m_theItkFilter->SetNumberOfThreads( 1 );
+    theMetric->SetMaximumNumberOfThreads( 1 );
+    optimizer->SetNumberOfThreads( 1 );
+  }
+  else if( this->m_NumberOfThreads > 0 )
+  {
+    this->m_theItkFilter->SetNumberOfThreads( this->m_NumberOfThreads );
+  }
 
   // perform the actual registration
   this->m_theItkFilter->Update();
 }
 
 
+template< int Dimensionality, class TPixel, class InternalComputationValueType >
+bool
+ItkImageRegistrationMethodv4Component< Dimensionality, TPixel, InternalComputationValueType >
+::WriteCheckpoint( const std::string & directory )
+{
+  typedef itk::TransformFileWriterTemplate< InternalComputationValueType > TransformWriterType;
+  typename TransformWriterType::Pointer writer = TransformWriterType::New();
+  writer->SetInput( this->GetItkTransform() );
+  writer->SetFileName( directory + "/Transform.h5" );
+  try
+  {
+    writer->Update();
+  }
+  catch( itk::ExceptionObject & exception )
+  {
+    this->Warning( "{0}: writing checkpoint failed: {1}", this->m_Name, exception.what() );
+    return false;
+  }
+  return true;
+}
+
+
+template< int Dimensionality, class TPixel, class InternalComputationValueType >
+bool
+ItkImageRegistrationMethodv4Component< Dimensionality, TPixel, InternalComputationValueType >
+::ReadCheckpoint( const std::string & directory )
+{
+  typedef itk::TransformFileReaderTemplate< InternalComputationValueType > TransformReaderType;
+  typename TransformReaderType::Pointer reader = TransformReaderType::New();
+  reader->SetFileName( directory + "/Transform.h5" );
+  try
+  {
+    reader->Update();
+  }
+  catch( itk::ExceptionObject & exception )
+  {
+    this->Warning( "{0}: reading checkpoint failed: {1}", this->m_Name, exception.what() );
+    return false;
+  }
+
+  // The filter registers in place, i.e. its result is the initial transform. The checkpoint must hold a transform of
+  // that type and, for parametric transforms, with its numbers of fixed and other parameters. Dense field transforms,
+  // e.g. of a deformable registration, may get their field only during registration, hence their numbers of parameters
+  // are not compared.
+  const TransformType * initialTransform = this->m_theItkFilter->GetInitialTransform();
+  const auto & transforms = *reader->GetTransformList();
+  if( initialTransform == nullptr || transforms.size() != 1
+    || std::string( transforms.front()->GetNameOfClass() ) != initialTransform->GetNameOfClass() )
+  {
+    this->Warning( "{0}: checkpoint holds another type of transform", this->m_Name );
+    return false;
+  }
+  auto checkpointTransform = dynamic_cast< TransformType * >( transforms.front().GetPointer() );
+
+  typedef itk::ConstantVelocityFieldTransform< InternalComputationValueType, Dimensionality > VelocityFieldTransformType;
+  typedef itk::DisplacementFieldTransform< InternalComputationValueType, Dimensionality >    DisplacementFieldTransformType;
+  if( auto velocityFieldTransform = dynamic_cast< VelocityFieldTransformType * >( checkpointTransform ) )
+  {
+    // A transform file stores the velocity field only
+    velocityFieldTransform->IntegrateVelocityField();
+  }
+  else if( dynamic_cast< DisplacementFieldTransformType * >( checkpointTransform ) == nullptr
+    && ( checkpointTransform->GetFixedParameters().Size() != initialTransform->GetFixedParameters().Size()
+    || checkpointTransform->GetNumberOfParameters() != initialTransform->GetNumberOfParameters() ) )
+  {
+    this->Warning( "{0}: checkpoint holds a transform with another number of parameters", this->m_Name );
+    return false;
+  }
+
+  // Components downstream get the transform when they update, the checkpoint is adopted until the next registration
+  this->m_CheckpointTransform = checkpointTransform;
+  return true;
+}
+
+
 template< int Dimensionality, class TPixel, class InternalComputationValueType >
 typename ItkImageRegistrationMethodv4Component< Dimensionality, TPixel, InternalComputationValueType >::TransformPointer
 ItkImageRegistrationMethodv4Component< Dimensionality, TPixel, InternalComputationValueType >
 ::GetItkTransform()
 {
+  if( this->m_CheckpointTransform.IsNotNull() )
+  {
+    return this->m_CheckpointTransform;
+  }
   return this->m_theItkFilter->GetModifiableTransform();
 }
 
@@ -52,11 +52,23 @@ void
 ItkTransformSourceComponent< Dimensionality, InternalComputationValueType >
 ::SetMiniPipelineInput( itk::DataObject::Pointer object )
 {
-  this->m_DecoratedTransform = dynamic_cast< DecoratedTransformType * >(object.GetPointer());
-  if (this->m_DecoratedTransform == nullptr)
+  DecoratedTransformType * decoratedTransform = dynamic_cast< DecoratedTransformType * >(object.GetPointer());
+  if (decoratedTransform == nullptr)
   {
     throw std::runtime_error( "DataObject passed by the NetworkBuilder is not of the right DecoratedTransformType or not at all an DecoratedTransformType" );
   }
+
+  if( this->m_DecoratedTransform == nullptr || this->m_DecoratedTransform == decoratedTransform )
+  {
+    this->m_DecoratedTransform = decoratedTransform;
+  }
+  else
+  {
+    // Rebinding a connected network: the connected components hold on to the transform itself, hence the
+    // parameters of the new transform are copied into it.
+    this->m_DecoratedTransform->GetModifiable()->SetFixedParameters( decoratedTransform->Get()->GetFixedParameters() );
+    this->m_DecoratedTransform->GetModifiable()->SetParameters( decoratedTransform->Get()->GetParameters() );
+  }
   return;
 }
 
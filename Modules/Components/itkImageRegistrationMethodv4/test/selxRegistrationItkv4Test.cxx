@@ -861,4 +861,56 @@ TEST_F(RegistrationItkv4Test, TransformSource)
   EXPECT_NO_THROW(resultImageWriter->Update());
   EXPECT_NO_THROW(resultDisplacementWriter->Update());
 }
+
+TEST_F( RegistrationItkv4Test, CheckpointDisplacementField )
+{
+  typedef ItkImageRegistrationMethodv4Component< 2, float, double >        RegistrationComponentType;
+  typedef ItkGaussianExponentialDiffeomorphicTransformComponent< double, 2 > TransformComponentType;
+  typedef ItkAffineTransformComponent< double, 2 >                           AffineTransformComponentType;
+  typedef TransformComponentType::GaussianExponentialDiffeomorphicTransformType DiffeomorphicTransformType;
+  typedef DiffeomorphicTransformType::ConstantVelocityFieldType               VelocityFieldType;
+
+  // A checkpoint of a deformable registration holds a field, which the fresh transform of the component lacks
+  VelocityFieldType::SizeType size;
+  size.Fill( 8 );
+  VelocityFieldType::Pointer velocityField = VelocityFieldType::New();
+  velocityField->SetRegions( size );
+  velocityField->Allocate();
+  VelocityFieldType::PixelType velocity;
+  velocity[ 0 ] = 0.5;
+  velocity[ 1 ] = -0.25;
+  velocityField->FillBuffer( velocity );
+
+  DiffeomorphicTransformType::Pointer checkpointTransform = DiffeomorphicTransformType::New();
+  checkpointTransform->SetConstantVelocityField( velocityField );
+  checkpointTransform->IntegrateVelocityField();
+
+  itk::TransformFactoryBase::RegisterDefaultTransforms();
+  TransformWriterType::Pointer transformWriter = TransformWriterType::New();
+  transformWriter->SetInput( checkpointTransform );
+  transformWriter->SetFileName( dataManager->GetOutputFile( "Transform.h5" ) );
+  EXPECT_NO_THROW( transformWriter->Update() );
+
+  auto transformComponent = std::make_shared< TransformComponentType >( "Transform", logger->GetLoggerImpl() );
+  EXPECT_EQ( 0u, transformComponent->GetItkTransform()->GetNumberOfParameters() );
+  auto registration = std::make_shared< RegistrationComponentType >( "Registration", logger->GetLoggerImpl() );
+  registration->Accept( transformComponent );
+  EXPECT_TRUE( registration->ReadCheckpoint( dataManager->GetOutputDirectory() ) );
+
+  auto restoredTransform = registration->GetItkTransform();
+  EXPECT_STREQ( "GaussianExponentialDiffeomorphicTransform", restoredTransform->GetNameOfClass() );
+  DiffeomorphicTransformType::InputPointType point;
+  point[ 0 ] = 3.0;
+  point[ 1 ] = 4.0;
+  const auto expectedPoint = checkpointTransform->TransformPoint( point );
+  const auto restoredPoint = restoredTransform->TransformPoint( point );
+  EXPECT_NEAR( expectedPoint[ 0 ], restoredPoint[ 0 ], 1e-6 );
+  EXPECT_NEAR( expectedPoint[ 1 ], restoredPoint[ 1 ], 1e-6 );
+
+  // A registration of another type of transform does not restore the checkpoint
+  auto affineTransformComponent = std::make_shared< AffineTransformComponentType >( "AffineTransform", logger->GetLoggerImpl() );
+  auto affineRegistration = std::make_shared< RegistrationComponentType >( "AffineRegistration", logger->GetLoggerImpl() );
+  affineRegistration->Accept( affineTransformComponent );
+  EXPECT_FALSE( affineRegistration->ReadCheckpoint( dataManager->GetOutputDirectory() ) );
+}
 } // namespace selx
@@ -97,6 +97,11 @@ public:
   //BaseClass methods
   virtual bool MeetsCriterion( const ComponentBase::CriterionType & criterion ) override;
 
+  // The forward and inverse displacement fields are written to and read from an HDF5 transform file in the checkpoint directory
+  virtual bool WriteCheckpoint( const std::string & directory ) override;
+
+  virtual bool ReadCheckpoint( const std::string & directory ) override;
+
   //static const char * GetName() { return "ItkSyNImageRegistrationMethod"; } ;
   static const char * GetDescription() { return "ItkSyNImageRegistrationMethod Component"; }
 
@@ -19,11 +19,17 @@
 
 #include "selxItkSyNImageRegistrationMethodComponent.h"
 #include "selxItkImageRegistrationMethodv4Component.h"
+#include "selxItkCancellationCommand.h"
+#include "selxItkObserverGuard.h"
 
 #include "itkDisplacementFieldTransformParametersAdaptor.h"
+#include "itkTransformFileReader.h"
+#include "itkTransformFileWriter.h"
 //TODO: get rid of these
 #include "itkGradientDescentOptimizerv4.h"
 
+#include <algorithm>
+
 namespace selx
 {
 template< int Dimensionality, class TPixel , class InternalComputationValueType >
@@ -170,21 +176,32 @@ ItkSyNImageRegistrationMethodComponent< Dimensionality, TPixel, InternalComputat
 
   for( unsigned int level = 0; level < shrinkFactorsPerLevel.Size(); level++ )
   {
-    // We use the shrink image filter to calculate the fixed parameters of the virtual
-    // domain at each level.  To speed up calculation and avoid unnecessary memory
-    // usage, we could calculate these fixed parameters directly.
-
-    typedef itk::ShrinkImageFilter< FixedImageType, FixedImageType > ShrinkFilterType;
-    typename ShrinkFilterType::Pointer shrinkFilter = ShrinkFilterType::New();
-    shrinkFilter->SetShrinkFactors( shrinkFactorsPerLevel[ level ] );
-    shrinkFilter->SetInput( fixedImage );
-    shrinkFilter->Update();
+    // Only the domain of the shrunk fixed image is needed, which other components of the network
+    // may have derived already.
+    typedef itk::ImageBase< Dimensionality > ImageDomainType;
+    const auto shrinkFactor = shrinkFactorsPerLevel[ level ];
+    typename ImageDomainType::Pointer shrunkDomain = this->m_DerivedDataCache->template Get< ImageDomainType >(
+      fixedImage, "ShrinkImageDomain", { std::to_string( shrinkFactor ) }, [ &fixedImage, shrinkFactor ]()
+      {
+        // We use the shrink image filter to calculate the fixed parameters of the virtual
+        // domain at each level, without shrinking the pixel data.
+
+        typedef itk::ShrinkImageFilter< FixedImageType, FixedImageType > ShrinkFilterType;
+        typename ShrinkFilterType::Pointer shrinkFilter = ShrinkFilterType::New();
+        shrinkFilter->SetShrinkFactors( shrinkFactor );
+        shrinkFilter->SetInput( fixedImage );
+        shrinkFilter->UpdateOutputInformation();
+
+        typename FixedImageType::Pointer shrunkImage = shrinkFilter->GetOutput();
+        shrunkImage->DisconnectPipeline();
+        return shrunkImage;
+      } );
 
     typename DisplacementFieldTransformAdaptorType::Pointer fieldTransformAdaptor = DisplacementFieldTransformAdaptorType::New();
-    fieldTransformAdaptor->SetRequiredSpacing( shrinkFilter->GetOutput()->GetSpacing() );
-    fieldTransformAdaptor->SetRequiredSize( shrinkFilter->GetOutput()->GetBufferedRegion().GetSize() );
-    fieldTransformAdaptor->SetRequiredDirection( shrinkFilter->GetOutput()->GetDirection() );
-    fieldTransformAdaptor->SetRequiredOrigin( shrinkFilter->GetOutput()->GetOrigin() );
+    fieldTransformAdaptor->SetRequiredSpacing( shrunkDomain->GetSpacing() );
+    fieldTransformAdaptor->SetRequiredSize( shrunkDomain->GetLargestPossibleRegion().GetSize() );
+    fieldTransformAdaptor->SetRequiredDirection( shrunkDomain->GetDirection() );
+    fieldTransformAdaptor->SetRequiredOrigin( shrunkDomain->GetOrigin() );
 
     adaptors.push_back( fieldTransformAdaptor.GetPointer() );
   }
@@ -200,15 +217,119 @@ ItkSyNImageRegistrationMethodComponent< Dimensionality, TPixel, InternalComputat
   */
   this->m_theItkFilter->SetTransformParametersAdaptorsPerLevel( adaptors );
 
+  // All observers are removed when this update ends, also when it is cancelled
+  ItkObserverGuard observerGuard;
+
   typedef CommandIterationUpdate< TheItkFilterType > RegistrationCommandType;
   typename RegistrationCommandType::Pointer registrationObserver = RegistrationCommandType::New();
-  this->m_theItkFilter->AddObserver( itk::IterationEvent(), registrationObserver );
+  registrationObserver->SetComponent( this, this->m_theItkFilter );
+  observerGuard.AddObserver( this->m_theItkFilter, itk::IterationEvent(), registrationObserver );
+
+  // Cancelling the network aborts the registration at the next iteration, SyN iterates without an optimizer object
+  ItkCancellationCommand::Pointer cancellationCommand = ItkCancellationCommand::New();
+  cancellationCommand->SetCancellationToken( this->m_CancellationToken );
+  cancellationCommand->SetProcessObject( this->m_theItkFilter );
+  observerGuard.AddObserver( this->m_theItkFilter, itk::IterationEvent(), cancellationCommand );
+
+  // Random sampling of the metric follows the seed of the network. A deterministic network reduces the metric values over
+  // the threads in a fixed order, which the filter and its metric only do on one thread.
+  if( this->m_RandomSeed != 0 )
+  {
+    this->m_theItkFilter->MetricSamplingReinitializeSeed( static_cast< int >( this->m_RandomSeed ) );
+  }
+  if( this->m_IsDeterministic )
+  {
+    this->m_theItkFilter->SetNumberOfThreads( 1 );
+    theMetric->SetMaximumNumberOfThreads( 1 );
+  }
+  else if( this->m_NumberOfThreads > 0 )
+  {
+    this->m_theItkFilter->SetNumberOfThreads( this->m_NumberOfThreads );
+  }
 
   // perform the actual registration
   this->m_theItkFilter->Update();
 }
 
 
+template< int Dimensionality, class TPixel, class InternalComputationValueType >
+bool
+ItkSyNImageRegistrationMethodComponent< Dimensionality, TPixel, InternalComputationValueType >
+::WriteCheckpoint( const std::string & directory )
+{
+  typedef typename TheItkFilterType::OutputTransformType OutputTransformType;
+  auto transform = dynamic_cast< OutputTransformType * >( this->m_theItkFilter->GetModifiableTransform() );
+  if( transform == nullptr || transform->GetDisplacementField() == nullptr )
+  {
+    this->Warning( "{0}: writing checkpoint failed: the transform has no displacement field", this->m_Name );
+    return false;
+  }
+
+  // A transform file stores the displacement field only, the inverse field is stored as a second transform
+  typedef itk::TransformFileWriterTemplate< InternalComputationValueType > TransformWriterType;
+  typename TransformWriterType::Pointer writer = TransformWriterType::New();
+  writer->SetInput( transform );
+  if( transform->GetInverseDisplacementField() != nullptr )
+  {
+    typename OutputTransformType::Pointer inverseTransform = OutputTransformType::New();
+    inverseTransform->SetDisplacementField( transform->GetModifiableInverseDisplacementField() );
+    writer->AddTransform( inverseTransform );
+  }
+  writer->SetFileName( directory + "/Transform.h5" );
+  try
+  {
+    writer->Update();
+  }
+  catch( itk::ExceptionObject & exception )
+  {
+    this->Warning( "{0}: writing checkpoint failed: {1}", this->m_Name, exception.what() );
+    return false;
+  }
+  return true;
+}
+
+
+template< int Dimensionality, class TPixel, class InternalComputationValueType >
+bool
+ItkSyNImageRegistrationMethodComponent< Dimensionality, TPixel, InternalComputationValueType >
+::ReadCheckpoint( const std::string & directory )
+{
+  typedef itk::TransformFileReaderTemplate< InternalComputationValueType > TransformReaderType;
+  typename TransformReaderType::Pointer reader = TransformReaderType::New();
+  reader->SetFileName( directory + "/Transform.h5" );
+  try
+  {
+    reader->Update();
+  }
+  catch( itk::ExceptionObject & exception )
+  {
+    this->Warning( "{0}: reading checkpoint failed: {1}", this->m_Name, exception.what() );
+    return false;
+  }
+
+  // Components downstream get the transform of the filter when they update. Before registration it has no field, it
+  // adopts the fields of the checkpoint, and is left untouched unless the checkpoint holds one or two displacement fields.
+  typedef typename TheItkFilterType::OutputTransformType OutputTransformType;
+  auto transform = dynamic_cast< OutputTransformType * >( this->m_theItkFilter->GetModifiableTransform() );
+  const auto & transforms = *reader->GetTransformList();
+  std::vector< OutputTransformType * > checkpointTransforms;
+  for( const auto & checkpointTransform : transforms )
+  {
+    checkpointTransforms.push_back( dynamic_cast< OutputTransformType * >( checkpointTransform.GetPointer() ) );
+  }
+  if( transform == nullptr || checkpointTransforms.empty() || checkpointTransforms.size() > 2
+    || std::find( checkpointTransforms.begin(), checkpointTransforms.end(), nullptr ) != checkpointTransforms.end() )
+  {
+    this->Warning( "{0}: checkpoint holds another type of transform", this->m_Name );
+    return false;
+  }
+  transform->SetDisplacementField( checkpointTransforms.front()->GetModifiableDisplacementField() );
+  transform->SetInverseDisplacementField(
+    checkpointTransforms.size() == 2 ? checkpointTransforms.back()->GetModifiableDisplacementField() : nullptr );
+  return true;
+}
+
+
 template< int Dimensionality, class TPixel, class InternalComputationValueType >
 typename ItkSyNImageRegistrationMethodComponent< Dimensionality, TPixel, InternalComputationValueType >::TransformPointer
 ItkSyNImageRegistrationMethodComponent< Dimensionality, TPixel, InternalComputationValueType >
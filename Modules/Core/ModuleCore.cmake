@@ -23,9 +23,25 @@ set( ${MODULE}_INCLUDE_DIRS
 
 # Module source files
 set( ${MODULE}_SOURCE_FILES
+  ${${MODULE}_SOURCE_DIR}/src/selxComponentAssignmentCache.cxx
   ${${MODULE}_SOURCE_DIR}/src/selxComponentBase.cxx
+  ${${MODULE}_SOURCE_DIR}/src/selxCancellationToken.cxx
   ${${MODULE}_SOURCE_DIR}/src/selxCheckTemplateProperties.cxx
+  ${${MODULE}_SOURCE_DIR}/src/selxCheckpoint.cxx
+  ${${MODULE}_SOURCE_DIR}/src/selxComponentDescriptor.cxx
+  ${${MODULE}_SOURCE_DIR}/src/selxComponentRegistry.cxx
+  ${${MODULE}_SOURCE_DIR}/src/selxComponentSelector.cxx
+  ${${MODULE}_SOURCE_DIR}/src/selxConnectionConstraintSolver.cxx
+  ${${MODULE}_SOURCE_DIR}/src/selxDerivedDataCache.cxx
+  ${${MODULE}_SOURCE_DIR}/src/selxInterfaceCompatibilityTable.cxx
+  ${${MODULE}_SOURCE_DIR}/src/selxMemoryPlanner.cxx
+  ${${MODULE}_SOURCE_DIR}/src/selxNetworkBuilder.cxx
   ${${MODULE}_SOURCE_DIR}/src/selxNetworkContainer.cxx
+  ${${MODULE}_SOURCE_DIR}/src/selxProgressEventBuffer.cxx
+  ${${MODULE}_SOURCE_DIR}/src/selxProvidedInterfaceTable.cxx
+  ${${MODULE}_SOURCE_DIR}/src/selxResourceEstimate.cxx
+  ${${MODULE}_SOURCE_DIR}/src/selxSymbolTable.cxx
+  ${${MODULE}_SOURCE_DIR}/src/selxUpdateScheduler.cxx
 )
 
 # Export tests
@@ -37,6 +53,7 @@ set( ${MODULE}_TEST_SOURCE_FILES
 
 set( ${MODULE}_LIBRARIES
   ModuleCore
+  ${Boost_LIBRARIES}
 )
 
 set( ${MODULE}_MODULE_DEPENDENCIES
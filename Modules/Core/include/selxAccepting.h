@@ -24,6 +24,7 @@
 #include "selxLoggerImpl.h"
 #include "selxComponentBase.h"
 #include "selxInterfaceAcceptor.h"
+#include "selxSymbolTable.h"
 
 namespace selx
 {
@@ -40,17 +41,17 @@ public:
 
   Accepting( LoggerImpl & logger ) {};
 
-  static unsigned int CountMeetsCriteria( const ComponentBase::InterfaceCriteriaType ) { return 0; }
+  static unsigned int CountMeetsCriteria( const InternedProperties & ) { return 0; }
   //no interface called interfacename ;
-  int ConnectFromImpl( ComponentBase::Pointer other, const ComponentBase::InterfaceCriteriaType interfaceCriteria ) { return 0; }
-  InterfaceStatus CanAcceptConnectionFrom( ComponentBase::ConstPointer, const ComponentBase::InterfaceCriteriaType interfaceCriteria )
+  int ConnectFromImpl( ComponentBase::Pointer other, const InternedProperties & interfaceCriteria, const std::string & acceptorName ) { return 0; }
+  InterfaceStatus CanAcceptConnectionFrom( ComponentBase::ConstPointer, const InternedProperties & interfaceCriteria )
   {
     return InterfaceStatus::noaccepter;
   }
 
 
   //Empty RestInterfaces does 0 successful connects ;
-  int ConnectFromImpl( ComponentBase::Pointer ) { return 0; }
+  int ConnectFromImpl( ComponentBase::Pointer, const std::string & acceptorName ) { return 0; }
 
   bool AreAllAccepted() { return true; }
 
@@ -70,13 +71,14 @@ public:
 
   Accepting( LoggerImpl & logger );
 
-  static unsigned int CountMeetsCriteria( const ComponentBase::InterfaceCriteriaType );
+  static unsigned int CountMeetsCriteria( const InternedProperties & interfaceCriteria );
 
-  int ConnectFromImpl( ComponentBase::Pointer other, const ComponentBase::InterfaceCriteriaType interfaceCriteria );
+  // acceptorName is the name of the component with these accepting interfaces
+  int ConnectFromImpl( ComponentBase::Pointer other, const InternedProperties & interfaceCriteria, const std::string & acceptorName );
 
-  InterfaceStatus CanAcceptConnectionFrom( ComponentBase::ConstPointer other, const ComponentBase::InterfaceCriteriaType interfaceCriteria );
+  InterfaceStatus CanAcceptConnectionFrom( ComponentBase::ConstPointer other, const InternedProperties & interfaceCriteria );
 
-  int ConnectFromImpl( ComponentBase::Pointer );
+  int ConnectFromImpl( ComponentBase::Pointer, const std::string & acceptorName );
 
   // Helper function by which a component can check if all its Accepting interfaces have been set after the handshakes
   bool AreAllAccepted();
@@ -40,7 +40,7 @@ Accepting< FirstInterface, RestInterfaces ... >::Accepting( LoggerImpl & logger
 template< typename FirstInterface, typename ... RestInterfaces >
 int
 Accepting< FirstInterface, RestInterfaces ... >::ConnectFromImpl( ComponentBase::Pointer other,
-  const ComponentBase::InterfaceCriteriaType interfaceCriteria )
+  const InternedProperties & interfaceCriteria, const std::string & acceptorName )
 {
   // Does our component have an accepting interface sufficing the right criteria (e.g interfaceName)?
   if( Count< FirstInterface >::MeetsCriteria( interfaceCriteria ) == 1 )   // We use the FirstInterface only (of each recursion level), thus the count can be 0 or 1
@@ -48,32 +48,32 @@ Accepting< FirstInterface, RestInterfaces ... >::ConnectFromImpl( ComponentBase:
     // cast always succeeds since we know via the template arguments of the component which InterfaceAcceptors its base classes are.
     InterfaceAcceptor< FirstInterface > * acceptIF = this;
     // Make the connection to the other component by this interface and add the number of successes.
-    return acceptIF->Connect( other ) + Accepting< RestInterfaces ... >::ConnectFromImpl( other, interfaceCriteria );
+    return acceptIF->Connect( other, acceptorName ) + Accepting< RestInterfaces ... >::ConnectFromImpl( other, interfaceCriteria, acceptorName );
   }
   else
   {
-    return Accepting< RestInterfaces ... >::ConnectFromImpl( other, interfaceCriteria );
+    return Accepting< RestInterfaces ... >::ConnectFromImpl( other, interfaceCriteria, acceptorName );
   }
 }
 
 
 template< typename FirstInterface, typename ... RestInterfaces >
 int
-Accepting< FirstInterface, RestInterfaces ... >::ConnectFromImpl( ComponentBase::Pointer other )
+Accepting< FirstInterface, RestInterfaces ... >::ConnectFromImpl( ComponentBase::Pointer other, const std::string & acceptorName )
 {
   // cast always succeeds since we know via the template arguments of the component which InterfaceAcceptors its base classes are.
   InterfaceAcceptor< FirstInterface > * acceptIF = ( this );
 
   // See if the other component has the right interface and try to connect them
   // count the number of successes
-  return acceptIF->Connect( other ) + Accepting< RestInterfaces ... >::ConnectFromImpl( other );
+  return acceptIF->Connect( other, acceptorName ) + Accepting< RestInterfaces ... >::ConnectFromImpl( other, acceptorName );
 }
 
 
 template< typename FirstInterface, typename ... RestInterfaces >
 InterfaceStatus
 Accepting< FirstInterface, RestInterfaces ... >::CanAcceptConnectionFrom( ComponentBase::ConstPointer other,
-  const ComponentBase::InterfaceCriteriaType interfaceCriteria )
+  const InternedProperties & interfaceCriteria )
 {
   InterfaceStatus restInterfacesStatus = Accepting< RestInterfaces ... >::CanAcceptConnectionFrom( other, interfaceCriteria );
   // if multiple interfaces were a success we do not have to check any further interfaces.
@@ -117,7 +117,7 @@ Accepting< FirstInterface, RestInterfaces ... >::CanAcceptConnectionFrom( Compon
 
 template< typename FirstInterface, typename ... RestInterfaces >
 unsigned int
-Accepting< FirstInterface, RestInterfaces ... >::CountMeetsCriteria( const ComponentBase::InterfaceCriteriaType interfaceCriteria )
+Accepting< FirstInterface, RestInterfaces ... >::CountMeetsCriteria( const InternedProperties & interfaceCriteria )
 {
   return Count< FirstInterface, RestInterfaces ... >::MeetsCriteria( interfaceCriteria );
 }
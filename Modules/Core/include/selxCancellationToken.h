@@ -0,0 +1,75 @@
+/*=========================================================================
+ *
+ *  Copyright Leiden University Medical Center, Erasmus University Medical
+ *  Center and contributors
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+
+#ifndef selxCancellationToken_h
+#define selxCancellationToken_h
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+
+namespace selx
+{
+/** \class CancellationToken
+ * \brief Requests a running network to stop, from any thread or by a deadline.
+ *
+ * Cancellation is cooperative: the UpdateScheduler does not start any further updates once the token is cancelled, and
+ * components that run long updates check IsCancelled() regularly, e.g. at each iteration of their optimizer, and abort
+ * by throwing. The token stays cancelled until it is Reset().
+ */
+class CancellationToken
+{
+public:
+
+  typedef std::shared_ptr< CancellationToken > Pointer;
+  typedef std::chrono::steady_clock            ClockType;
+
+  /** Thrown by ThrowIfCancelled() and by NetworkContainer::Execute() when the network was cancelled */
+  class CancelledError : public std::runtime_error
+  {
+  public:
+
+    CancelledError() : std::runtime_error( "The execution of the network was cancelled." ) {}
+  };
+
+  CancellationToken();
+
+  void Cancel();
+
+  /** Cancel when timeout has elapsed from now on */
+  void CancelAfter( ClockType::duration timeout );
+
+  /** Undo Cancel() and remove the deadline of CancelAfter() */
+  void Reset();
+
+  /** Whether Cancel() was called or the deadline has passed. Lock free, cheap enough to call at each iteration. */
+  bool IsCancelled() const;
+
+  void ThrowIfCancelled() const;
+
+private:
+
+  std::atomic< bool >           m_IsCancelled;
+  std::atomic< ClockType::rep > m_Deadline;
+};
+} // end namespace selx
+
+#endif // selxCancellationToken_h
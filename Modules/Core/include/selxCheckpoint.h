@@ -0,0 +1,72 @@
+/*=========================================================================
+ *
+ *  Copyright Leiden University Medical Center, Erasmus University Medical
+ *  Center and contributors
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+
+#ifndef selxCheckpoint_h
+#define selxCheckpoint_h
+
+#include <mutex>
+#include <set>
+#include <string>
+
+namespace selx
+{
+/** \class Checkpoint
+ * \brief Records in a directory which components of a network have completed their update, such that an
+ * interrupted execution of the network can be resumed.
+ *
+ * The directory holds a manifest with the hash of the key of the network and the names of the components that
+ * completed, one per line, and a subdirectory per component to which the component writes its outputs by
+ * ComponentBase::WriteCheckpoint(). A component is added to the manifest only after its outputs were written. A
+ * manifest with a different key, i.e. of another blueprint or other inputs, is discarded.
+ */
+class Checkpoint
+{
+public:
+
+  /** Opens the manifest in directory, which is created if it does not exist */
+  Checkpoint( const std::string & directory, const std::string & key );
+
+  /** The names of the components that completed in an earlier execution with the same key */
+  std::set< std::string > GetCompletedComponentNames() const;
+
+  /** The directory to which the component writes its outputs, which is created if it does not exist */
+  std::string GetComponentDirectory( const std::string & componentName ) const;
+
+  /** Record that the outputs of the component were written. Thread safe. */
+  void Completed( const std::string & componentName );
+
+  /** Discard the components that completed */
+  void Reset();
+
+  /** A hash that is stable across platforms and runs, 16 hexadecimal digits */
+  static std::string GetHash( const std::string & string );
+
+private:
+
+  std::string GetManifestFileName() const;
+
+  const std::string       m_Directory;
+  const std::string       m_Hash;
+  std::set< std::string > m_CompletedComponentNames;
+  mutable std::mutex      m_Mutex;
+};
+} // end namespace selx
+
+#endif // selxCheckpoint_h
@@ -0,0 +1,93 @@
+/*=========================================================================
+ *
+ *  Copyright Leiden University Medical Center, Erasmus University Medical
+ *  Center and contributors
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#ifndef selxComponentAssignmentCache_h
+#define selxComponentAssignmentCache_h
+
+#include "selxInterfaceCompatibilityTable.h"
+#include "selxBlueprintImpl.h"
+
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace selx
+{
+/** \class ComponentAssignmentCache
+ * \brief Cache of the component type that was selected at each node of a blueprint.
+ *
+ * Blueprints are identified by a canonical key, a 64 bit digest which is independent of the order in which components
+ * and connections were added. The component types are ids in the InterfaceCompatibilityTable of a ComponentRegistry,
+ * hence each ComponentRegistry owns a cache. A NetworkBuilder that finds its blueprint in the cache does not
+ * need to evaluate the criteria against all other component types, nor to solve the connection constraints.
+ * The cache keeps the most recently used assignments, up to its capacity. All member functions are thread safe.
+ */
+class ComponentAssignmentCache
+{
+public:
+
+  typedef BlueprintImpl::ComponentNameType                           ComponentNameType;
+  typedef InterfaceCompatibilityTable::ComponentIdType               ComponentIdType;
+  typedef std::map< ComponentNameType, ComponentIdType >             ComponentAssignmentType;
+  typedef std::string                                                KeyType;
+  typedef std::list< std::pair< KeyType, ComponentAssignmentType > > EntriesType;
+  typedef std::unordered_map< KeyType, EntriesType::iterator >       CacheType;
+
+  static const std::size_t DefaultCapacity = 1024;
+
+  ComponentAssignmentCache() : m_Capacity( DefaultCapacity ) {}
+
+  /** The canonical key of a blueprint: the digest, in hexadecimal, of all components and connections with their
+   * properties, sorted by name. The blueprint is digested as it is serialized, without building the serialization. */
+  static KeyType GetKey( const BlueprintImpl & blueprint );
+
+  /** Find the assignment of key, which then becomes the most recently used */
+  bool Find( const KeyType & key, ComponentAssignmentType & componentAssignment );
+
+  /** Insert the assignment of key, removing the least recently used assignment if the cache is full */
+  void Insert( const KeyType & key, const ComponentAssignmentType & componentAssignment );
+
+  void Clear();
+
+  std::size_t Size() const;
+
+  /** The maximum number of assignments, the least recently used are removed beyond it */
+  void SetCapacity( std::size_t capacity );
+
+  std::size_t GetCapacity() const;
+
+private:
+
+  ComponentAssignmentCache( const ComponentAssignmentCache & ); //purposely not implemented
+  void operator=( const ComponentAssignmentCache & );           //purposely not implemented
+
+  // Remove the least recently used entries beyond the capacity, with the mutex locked
+  void Evict();
+
+  // Most recently used first
+  EntriesType        m_Entries;
+  CacheType          m_Cache;
+  std::size_t        m_Capacity;
+  mutable std::mutex m_Mutex;
+};
+} // end namespace selx
+
+#endif // selxComponentAssignmentCache_h
@@ -20,7 +20,12 @@
 #ifndef ComponentBase_h
 #define ComponentBase_h
 
+#include "selxCancellationToken.h"
+#include "selxDerivedDataCache.h"
+#include "selxProgressEventBuffer.h"
 #include "selxInterfaceStatus.h"
+#include "selxProvidedInterfaceTable.h"
+#include "selxResourceEstimate.h"
 #include <list>
 #include <iostream>
 #include <fstream>
@@ -54,17 +59,51 @@ public:
 
   typedef std::map< std::string, std::string > InterfaceCriteriaType;
 
-  virtual int AcceptConnectionFrom( Pointer, const InterfaceCriteriaType ) = 0;
+  virtual int AcceptConnectionFrom( Pointer, const InterfaceCriteriaType & ) = 0;
 
   virtual int AcceptConnectionFrom( Pointer ) = 0;
 
   virtual bool MeetsCriterion( const CriterionType & criterion ) = 0;
 
-  virtual InterfaceStatus CanAcceptConnectionFrom( ConstPointer, const InterfaceCriteriaType ) = 0;
+  virtual InterfaceStatus CanAcceptConnectionFrom( ConstPointer, const InterfaceCriteriaType & ) = 0;
 
-  virtual unsigned int CountAcceptingInterfaces( const InterfaceCriteriaType ) = 0;
+  virtual unsigned int CountAcceptingInterfaces( const InterfaceCriteriaType & ) = 0;
 
-  virtual unsigned int CountProvidingInterfaces( const InterfaceCriteriaType ) = 0;
+  virtual unsigned int CountProvidingInterfaces( const InterfaceCriteriaType & ) = 0;
+
+  // The providing interfaces of the type of the component, by which it is cast to these without dynamic_cast
+  virtual const ProvidedInterfaceTable & GetProvidedInterfaceTable() const = 0;
+
+  // The interface InterfaceT of component, sharing ownership with component, or nullptr if component does not provide it
+  template< class InterfaceT >
+  static std::shared_ptr< InterfaceT > GetProvidedInterface( const Pointer & component )
+  {
+    const ProvidedInterfaceTable::EntryType * entry = component->GetProvidedInterfaceTable().Find( InterfaceId< InterfaceT >::Get() );
+    if( entry == nullptr )
+    {
+      return nullptr;
+    }
+    return std::shared_ptr< InterfaceT >( component, static_cast< InterfaceT * >( entry->toInterface( component.get() ) ) );
+  }
+
+  // The ConnectionInfo of the interface InterfaceT of component, or nullptr if component does not provide it
+  template< class InterfaceT >
+  static std::shared_ptr< ConnectionInfo< InterfaceT >> GetConnectionInfo( const Pointer & component )
+  {
+    const ProvidedInterfaceTable::EntryType * entry = component->GetProvidedInterfaceTable().Find( InterfaceId< InterfaceT >::Get() );
+    if( entry == nullptr )
+    {
+      return nullptr;
+    }
+    return std::shared_ptr< ConnectionInfo< InterfaceT >>( component,
+      static_cast< ConnectionInfo< InterfaceT > * >( entry->toConnectionInfo( component.get() ) ) );
+  }
+
+  template< class InterfaceT >
+  bool IsProviding() const
+  {
+    return this->GetProvidedInterfaceTable().Find( InterfaceId< InterfaceT >::Get() ) != nullptr;
+  }
 
   //virtual const std::map< std::string, std::string >  TemplateProperties(); //TODO should be overridden
 
@@ -72,6 +111,36 @@ public:
   // SuperElastixComponent provides a default implementation which may be overridden by the component developer
   virtual bool ConnectionsSatisfied() = 0;
 
+  // The estimated size in bytes of the bulk data that the component outputs, 0 if unknown. It is used to report the
+  // peak memory of a network before it is executed.
+  virtual std::size_t GetOutputMemorySize() { return 0; }
+
+  // Release the bulk data that the component outputs. It is called when all components downstream have been updated and
+  // may be called repeatedly. Components that do not own their data, such as sources, keep the default implementation.
+  virtual void ReleaseData() {}
+
+  // The estimated runtime class and peak memory of the update of the component, given the image domains of its
+  // connected inputs. It is used to plan the execution of a network before it runs. By default the runtime class is
+  // unknown and the peak memory is the output memory.
+  virtual ResourceEstimate GetResourceEstimate() { return { ResourceEstimate::RuntimeClass::Unknown, this->GetOutputMemorySize() }; }
+
+  // Write the results of the update of the component to directory, such that an interrupted execution of the network can
+  // be resumed from it. Returns false if the component has no checkpoint, in which case it is updated again on resume.
+  virtual bool WriteCheckpoint( const std::string & /* directory */ ) { return false; }
+
+  // Restore the results of an earlier update of the component from directory, instead of updating. Returns false if they
+  // cannot be restored, in which case the component is updated.
+  virtual bool ReadCheckpoint( const std::string & /* directory */ ) { return false; }
+
+  // Stream the progress of the optimization of the component to the listener of the network, if any
+  void ReportProgress( unsigned int level, std::size_t iteration, double metricValue )
+  {
+    if( this->m_ProgressEventBuffer )
+    {
+      this->m_ProgressEventBuffer->Push( { this->m_Name, level, iteration, metricValue, this->m_ProgressEventBuffer->GetElapsedTime() } );
+    }
+  }
+
   void Cite()
   {
     if(!this->m_HowToCite.empty()) {
@@ -118,6 +187,30 @@ public:
   std::string m_HowToCite;
   LoggerImpl & m_Logger;
 
+  // The number of threads for the internal multithreading of the component, 0 means not limited.
+  unsigned int m_NumberOfThreads;
+
+  // The NumberOfThreads criterion of the blueprint, 0 if none. It takes precedence over the share of the threads of the network.
+  unsigned int m_NumberOfThreadsCriterion;
+
+  // Data derived from the inputs of the component, such as shrunk images, that it shares with the other components of
+  // its network. A component that is not part of a network has a cache of its own.
+  DerivedDataCache::Pointer m_DerivedDataCache;
+
+  // Set when the network that the component is part of is cancelled. A component with a long running Update() checks it
+  // regularly and aborts by throwing, see ItkCancellationCommand for itk filters.
+  CancellationToken::Pointer m_CancellationToken;
+
+  // Set when somebody listens to the progress of the network, nullptr otherwise
+  ProgressEventBuffer::Pointer m_ProgressEventBuffer;
+
+  // The seed of the random number generators of the component, such as image samplers. 0 leaves it to the backend.
+  unsigned int m_RandomSeed;
+
+  // Whether the results of the component must be reproducible bit by bit. The component then avoids internal
+  // multithreading whose outcome depends on the order in which the threads finish, such as reductions of metric values.
+  bool m_IsDeterministic;
+
 };
 } // end namespace selx
 
@@ -0,0 +1,144 @@
+/*=========================================================================
+ *
+ *  Copyright Leiden University Medical Center, Erasmus University Medical
+ *  Center and contributors
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#ifndef selxComponentDescriptor_h
+#define selxComponentDescriptor_h
+
+#include "selxComponentBase.h"
+#include "selxInterfaceStatus.h"
+#include "selxCheckTemplateProperties.h"
+#include "selxLoggerImpl.h"
+#include "selxSymbolTable.h"
+
+#include <map>
+#include <string>
+#include <vector>
+#include <typeindex>
+
+namespace selx
+{
+/** \class ComponentDescriptor
+ * \brief Static, per component type description that is used for component selection.
+ *
+ * A ComponentDescriptor holds everything the ComponentSelector needs to know about a
+ * component type without constructing an object of that type: its template properties,
+ * the properties of its accepting and providing interfaces and a factory function.
+ * Only components that survive selection are instantiated by New(). All properties are interned, such that
+ * selection compares integer symbols instead of strings.
+ */
+class ComponentDescriptor
+{
+public:
+
+  typedef ComponentBase::CriterionType         CriterionType;
+  typedef ComponentBase::InterfaceCriteriaType InterfaceCriteriaType;
+  typedef std::map< std::string, std::string > PropertiesType;
+  typedef SymbolTable::SymbolType              SymbolType;
+  typedef ComponentBase::Pointer ( *FactoryFunctionType )( const std::string &, LoggerImpl & );
+
+  // An accepting or providing interface of a component, identified by its (acceptor independent) interface type.
+  struct InterfaceDescriptorType
+  {
+    std::type_index    interfaceType;
+    InternedProperties properties;
+  };
+
+  // A criterion of which the key and values are interned once, to be checked against the template properties of
+  // many component types.
+  struct InternedCriterionType
+  {
+    SymbolType                key;
+    std::vector< SymbolType > values;
+    // Criteria such as NumberOfThreads are decided equally for all component types when they are interned
+    bool                      isDecided;
+    CriterionStatus           status;
+  };
+
+  typedef std::vector< InterfaceDescriptorType > InterfaceDescriptorsType;
+
+  /** Get the descriptor of ComponentType. The descriptor is created once and lives for the duration of the process. */
+  template< typename ComponentType >
+  static const ComponentDescriptor & Get();
+
+  /** Check a criterion against the template properties. Returns CriterionStatus::Unknown if the criterion can
+   * only be decided by the MeetsCriterion() of an instantiated component. The NumberOfThreads criterion is
+   * satisfied by all component types if it is a positive integer, the SelectionPolicy criterion if it is a
+   * known policy. */
+  CriterionStatus CheckCriterion( const CriterionType & criterion ) const;
+
+  /** Same as CheckCriterion( const CriterionType & ), for a criterion interned by InternCriterion() */
+  CriterionStatus CheckCriterion( const InternedCriterionType & criterion ) const;
+
+  unsigned int CountAcceptingInterfaces( const InterfaceCriteriaType & interfaceCriteria ) const;
+
+  unsigned int CountAcceptingInterfaces( const InternedProperties & interfaceCriteria ) const;
+
+  unsigned int CountProvidingInterfaces( const InterfaceCriteriaType & interfaceCriteria ) const;
+
+  unsigned int CountProvidingInterfaces( const InternedProperties & interfaceCriteria ) const;
+
+  /** Equivalent of ComponentBase::CanAcceptConnectionFrom, but decided on the interface types of both component types. */
+  InterfaceStatus CanAcceptConnectionFrom( const ComponentDescriptor & provider, const InterfaceCriteriaType & interfaceCriteria ) const;
+
+  InterfaceStatus CanAcceptConnectionFrom( const ComponentDescriptor & provider, const InternedProperties & interfaceCriteria ) const;
+
+  /** Instantiate the described component */
+  ComponentBase::Pointer New( const std::string & name, LoggerImpl & logger ) const;
+
+  const PropertiesType & GetTemplateProperties() const { return this->m_TemplateProperties; }
+
+  /** A relative estimate of the memory and compute of the component type, by which the LowestCost SelectionPolicy
+   * chooses: the size in bytes of its largest PixelType, InternalComputationValueType or CoordRepType, times its
+   * Dimensionality. Template properties that are absent count as 1. */
+  double GetEstimatedCost() const { return this->m_EstimatedCost; }
+
+  const InterfaceDescriptorsType & GetAcceptingInterfaces() const { return this->m_AcceptingInterfaces; }
+
+  const InterfaceDescriptorsType & GetProvidingInterfaces() const { return this->m_ProvidingInterfaces; }
+
+  /** Look up the key and values of criterion once, for checking it against many component types */
+  static InternedCriterionType InternCriterion( const CriterionType & criterion );
+
+  /** True if the value of a NumberOfThreads criterion is a single positive integer */
+  static bool IsValidNumberOfThreads( const CriterionType::second_type & value );
+
+  /** True if the value of a SelectionPolicy criterion is a single known policy */
+  static bool IsValidSelectionPolicy( const CriterionType::second_type & value );
+
+private:
+
+  ComponentDescriptor( const PropertiesType & templateProperties,
+    const InterfaceDescriptorsType & acceptingInterfaces,
+    const InterfaceDescriptorsType & providingInterfaces,
+    FactoryFunctionType factory );
+
+  const PropertiesType           m_TemplateProperties;
+  const InternedProperties       m_InternedTemplateProperties;
+  const InterfaceDescriptorsType m_AcceptingInterfaces;
+  const InterfaceDescriptorsType m_ProvidingInterfaces;
+  const FactoryFunctionType      m_Factory;
+  double                         m_EstimatedCost;
+};
+} // end namespace selx
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "selxComponentDescriptor.hxx"
+#endif
+
+#endif // selxComponentDescriptor_h
@@ -0,0 +1,88 @@
+/*=========================================================================
+ *
+ *  Copyright Leiden University Medical Center, Erasmus University Medical
+ *  Center and contributors
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#ifndef selxComponentDescriptor_hxx
+#define selxComponentDescriptor_hxx
+
+#include "selxComponentDescriptor.h"
+#include "selxInterfaceTraits.h"
+
+namespace selx
+{
+// Collects the type and properties of each interface in Accepting< Interfaces ... > or Providing< Interfaces ... >
+template< typename >
+struct DescribeInterfaces;
+
+template< template< typename ... > class InterfacesList, typename ... Interfaces >
+struct DescribeInterfaces< InterfacesList< Interfaces ... >>
+{
+  static ComponentDescriptor::InterfaceDescriptorsType Get()
+  {
+    return { { std::type_index( typeid( Interfaces ) ), PropertiesTable< Interfaces >::Get() } ... };
+  }
+};
+
+// Components declare their static TemplateProperties() as protected. Deriving from the component gives
+// access to it without constructing the component. Components without TemplateProperties() get an empty
+// map, such that all their criteria are decided by MeetsCriterion().
+template< typename ComponentType >
+struct StaticTemplateProperties : public ComponentType
+{
+  template< typename T >
+  static auto GetImpl( int ) -> decltype( T::TemplateProperties() )
+  {
+    return T::TemplateProperties();
+  }
+
+
+  template< typename T >
+  static ComponentDescriptor::PropertiesType GetImpl( ... )
+  {
+    return {};
+  }
+
+
+  static ComponentDescriptor::PropertiesType Get()
+  {
+    return GetImpl< ComponentType >( 0 );
+  }
+};
+
+template< typename ComponentType >
+ComponentBase::Pointer
+NewComponent( const std::string & name, LoggerImpl & logger )
+{
+  return std::make_shared< ComponentType >( name, logger );
+}
+
+
+template< typename ComponentType >
+const ComponentDescriptor &
+ComponentDescriptor::Get()
+{
+  static const ComponentDescriptor descriptor(
+    StaticTemplateProperties< ComponentType >::Get(),
+    DescribeInterfaces< typename ComponentType::AcceptingInterfacesTypeList >::Get(),
+    DescribeInterfaces< typename ComponentType::ProvidingInterfacesTypeList >::Get(),
+    &NewComponent< ComponentType > );
+  return descriptor;
+}
+} // end namespace selx
+
+#endif // selxComponentDescriptor_hxx
@@ -0,0 +1,96 @@
+/*=========================================================================
+ *
+ *  Copyright Leiden University Medical Center, Erasmus University Medical
+ *  Center and contributors
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#ifndef selxComponentRegistry_h
+#define selxComponentRegistry_h
+
+#include "selxComponentDescriptor.h"
+#include "selxComponentAssignmentCache.h"
+#include "selxInterfaceCompatibilityTable.h"
+#include "selxTypeList.h"
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace selx
+{
+/** \class ComponentRegistry
+ * \brief The set of component types from which a NetworkBuilder selects, without templates in its interface.
+ *
+ * Each entry is the type-erased ComponentDescriptor of a component type, which holds its properties, its interfaces
+ * and a factory function. Component modules register their components by RegisterComponents< Module...Components >()
+ * in a function of their own library, such that the component templates are instantiated in the module that
+ * defines them, and only there. The InterfaceCompatibilityTable and the ComponentAssignmentCache of the registered
+ * components are shared by all NetworkBuilders of the registry. The compatibility table is computed once, at the
+ * first network that is configured after a registration.
+ *
+ * Components must not be registered while networks of the registry are being configured.
+ */
+class ComponentRegistry
+{
+public:
+
+  typedef InterfaceCompatibilityTable::DescriptorsType DescriptorsType;
+  typedef InterfaceCompatibilityTable::ConstPointer    CompatibilityTablePointer;
+
+  ComponentRegistry() {}
+
+  /** The registry of the components that are compiled into the library, see RegisterCompiledLibraryComponents() */
+  static ComponentRegistry & GetDefault();
+
+  /** Get the registry of exactly the components in ComponentList. The registry is created once and lives for the
+   * duration of the process. */
+  template< typename ComponentList >
+  static ComponentRegistry & Get();
+
+  /** Add a component type. Registering a component type twice has no effect. */
+  void Register( const ComponentDescriptor & descriptor );
+
+  template< typename ComponentType >
+  void Register();
+
+  /** Add all component types of a TypeList */
+  template< typename ComponentList >
+  void RegisterComponents();
+
+  std::size_t GetNumberOfComponents() const;
+
+  /** The compatibility table of all registered component types, which are identified by their registration order */
+  CompatibilityTablePointer GetCompatibilityTable() const;
+
+  ComponentAssignmentCache & GetComponentAssignmentCache() { return this->m_ComponentAssignmentCache; }
+
+private:
+
+  ComponentRegistry( const ComponentRegistry & ); //purposely not implemented
+  void operator=( const ComponentRegistry & );    //purposely not implemented
+
+  DescriptorsType                   m_Descriptors;
+  mutable CompatibilityTablePointer m_CompatibilityTable;
+  ComponentAssignmentCache          m_ComponentAssignmentCache;
+  mutable std::mutex                m_Mutex;
+};
+} // end namespace selx
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "selxComponentRegistry.hxx"
+#endif
+
+#endif // selxComponentRegistry_h
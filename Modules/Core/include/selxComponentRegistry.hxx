@@ -0,0 +1,78 @@
+/*=========================================================================
+ *
+ *  Copyright Leiden University Medical Center, Erasmus University Medical
+ *  Center and contributors
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#ifndef selxComponentRegistry_hxx
+#define selxComponentRegistry_hxx
+
+#include "selxComponentRegistry.h"
+
+namespace selx
+{
+template< typename >
+struct RegisterComponentsFromTypeList;
+
+template< >
+struct RegisterComponentsFromTypeList< TypeList< >>
+{
+  static void Register( ComponentRegistry & /* registry */ )
+  {
+  }
+};
+
+template< typename ComponentType, typename ... Rest >
+struct RegisterComponentsFromTypeList< TypeList< ComponentType, Rest ... >>
+{
+  static void Register( ComponentRegistry & registry )
+  {
+    registry.Register( ComponentDescriptor::Get< ComponentType >() );
+    RegisterComponentsFromTypeList< TypeList< Rest ... >>::Register( registry );
+  }
+};
+
+template< typename ComponentList >
+ComponentRegistry &
+ComponentRegistry::Get()
+{
+  struct ComponentListRegistry : public ComponentRegistry
+  {
+    ComponentListRegistry() { this->template RegisterComponents< ComponentList >(); }
+  };
+
+  static ComponentListRegistry registry;
+  return registry;
+}
+
+
+template< typename ComponentType >
+void
+ComponentRegistry::Register()
+{
+  this->Register( ComponentDescriptor::Get< ComponentType >() );
+}
+
+
+template< typename ComponentList >
+void
+ComponentRegistry::RegisterComponents()
+{
+  RegisterComponentsFromTypeList< ComponentList >::Register( *this );
+}
+} // end namespace selx
+
+#endif // selxComponentRegistry_hxx
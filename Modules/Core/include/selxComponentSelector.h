@@ -21,24 +21,32 @@
 
 #include "itkObjectFactory.h"
 #include "selxComponentBase.h"
+#include "selxComponentDescriptor.h"
+#include "selxInterfaceCompatibilityTable.h"
 #include "selxLogger.h"
-#include "selxTypeList.h"
+
+#include <list>
+#include <memory>
+#include <vector>
 
 namespace selx
 {
 /** \class ComponentSelector
  * \brief A Component factory that accepts criteria, possibly in multiple passes, to construct and return the right Component
+ *
+ * Selection is done on the static ComponentDescriptor of each type in the InterfaceCompatibilityTable of a ComponentRegistry.
+ * Criteria that cannot be decided by the template properties are deferred and applied by MeetsCriterion() to instances of the remaining
+ * candidates only, i.e. a component is not constructed before it survived all criteria that can be checked statically.
  */
 
-template< class ComponentList >
 class ComponentSelector
 {
 public:
 
   /** Standard class typedefs. */
-  typedef ComponentSelector< ComponentList > Self;
-  typedef std::shared_ptr< Self >            Pointer;
-  typedef std::shared_ptr< const Self >      ConstPointer;
+  typedef ComponentSelector             Self;
+  typedef std::shared_ptr< Self >       Pointer;
+  typedef std::shared_ptr< const Self > ConstPointer;
 
   /** Convenient typedefs. */
   typedef ComponentBase::Pointer               ComponentBasePointer;
@@ -46,11 +54,25 @@ public:
   typedef ComponentBase::CriterionType         CriterionType;
   typedef ComponentBase::InterfaceCriteriaType InterfaceCriteriaType;
 
-  typedef std::list< ComponentBasePointer > ComponentListType;
+  typedef InterfaceCompatibilityTable::ComponentIdType  ComponentIdType;
+  typedef InterfaceCompatibilityTable::ComponentIdsType ComponentIdsType;
+  typedef InterfaceCompatibilityTable::ConstPointer     CompatibilityTablePointer;
+
+  // A candidate component type, which is instantiated lazily.
+  struct CandidateType
+  {
+    ComponentIdType             id;
+    const ComponentDescriptor * descriptor;
+    ComponentBasePointer        component;
+    std::size_t                 numberOfAppliedCriteria;
+  };
+
+  typedef std::list< CandidateType >        ComponentListType;
   typedef ComponentListType::size_type      NumberOfComponentsType;
   /** set selection criteria for possibleComponents*/
 
-  ComponentSelector( const std::string & name, LoggerImpl & logger );
+  /** The candidates are all component types in compatibilityTable */
+  ComponentSelector( const std::string & name, LoggerImpl & logger, CompatibilityTablePointer compatibilityTable );
 
   /** Narrow selection criteria*/
   void AddCriterion( const CriterionType & criterion );
@@ -59,33 +81,52 @@ public:
 
   void AddProvidingInterfaceCriteria( const InterfaceCriteriaType & interfaceCriteria );
 
+  /** The number of remaining components. The deferred criteria are applied first, which instantiates the candidates. */
   unsigned int NumberOfComponents( void );
 
-  unsigned int RequireAcceptingInterfaceFrom( ComponentBasePointer other, const InterfaceCriteriaType & interfaceCriteria );
+  /** The number of candidates that satisfy all criteria that can be checked statically, without instantiating any
+   * component. Candidates are not yet checked against the deferred criteria. */
+  unsigned int NumberOfCandidates( void ) const;
 
-  unsigned int RequireProvidingInterfaceTo( ComponentBasePointer other, const InterfaceCriteriaType & interfaceCriteria );
+  /** Keep only the components with an id in componentIds, e.g. as found by the ConnectionConstraintSolver */
+  void RestrictToComponentIds( const ComponentIdsType & componentIds );
 
-  /** Return Component or Nullptr*/
+  /** Return the ids in the InterfaceCompatibilityTable of the remaining components */
+  ComponentIdsType GetComponentIds( void );
+
+  /** Return the ids of the candidates counted by NumberOfCandidates(), e.g. as the domain of the ConnectionConstraintSolver */
+  ComponentIdsType GetCandidateIds( void ) const;
+
+  const InterfaceCompatibilityTable & GetCompatibilityTable( void ) const { return *this->m_CompatibilityTable; }
+
+  /** Return Component or Nullptr. The component is instantiated at the first call. */
   ComponentBasePointer GetComponent( void );
 
+  /** Return the descriptor of the uniquely selected Component or Nullptr, without instantiating the component */
+  const ComponentDescriptor * GetComponentDescriptor( void );
+
   void PrintComponents( void );
 
 protected:
 
+  /** Instantiate the remaining candidates and apply the deferred criteria by MeetsCriterion() */
+  void UpdatePossibleComponents( void );
+
+  const CompatibilityTablePointer m_CompatibilityTable;
+
   ComponentListType m_PossibleComponents;
 
+  // Criteria that could not be decided by the template properties of all candidates.
+  std::vector< CriterionType > m_DeferredCriteria;
+
+  const std::string m_Name;
+  LoggerImpl &      m_Logger;
+
 private:
 
   ComponentSelector( const Self & ); //purposely not implemented
   void operator=( const Self & );    //purposely not implemented
 };
-
-template< typename >
-struct ContructComponentsFromTypeList;
 } // end namespace selx
 
-#ifndef ITK_MANUAL_INSTANTIATION
-#include "selxComponentSelector.hxx"
-#endif
-
 #endif
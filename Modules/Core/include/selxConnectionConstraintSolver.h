@@ -0,0 +1,138 @@
+/*=========================================================================
+ *
+ *  Copyright Leiden University Medical Center, Erasmus University Medical
+ *  Center and contributors
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#ifndef selxConnectionConstraintSolver_h
+#define selxConnectionConstraintSolver_h
+
+#include "selxInterfaceCompatibilityTable.h"
+
+#include <deque>
+#include <vector>
+
+namespace selx
+{
+/** \class ConnectionConstraintSolver
+ * \brief Narrows the component selection of all nodes of a network by the constraints on its connections.
+ *
+ * Each node has a domain: a bitset over the component ids of an InterfaceCompatibilityTable. Each connection
+ * constrains the pair of its providing and accepting node to component types that can be connected by an
+ * interface satisfying the connection criteria. Solve() first removes the component types that do not have a
+ * providing or accepting interface that satisfies the criteria of a connection (node consistency) and then
+ * makes all connections arc consistent by AC-3: a component type remains in a domain only if it can be
+ * connected to at least one component type in the domain at the other end of each of its connections. This
+ * converges in O( connections x domain size^3 ) and does not require any of the nodes to be unique.
+ *
+ * Arc consistency does not guarantee that a unique component type can be chosen for each node independently.
+ * SelectLowestCost() enumerates the assignments of single component types to a set of nodes by backtracking search,
+ * propagating each choice by AC-3, and keeps the consistent assignment with the lowest total cost.
+ */
+class ConnectionConstraintSolver
+{
+public:
+
+  typedef InterfaceCompatibilityTable::ComponentIdType       ComponentIdType;
+  typedef InterfaceCompatibilityTable::ComponentIdsType      ComponentIdsType;
+  typedef InterfaceCompatibilityTable::InterfaceCriteriaType InterfaceCriteriaType;
+  typedef std::size_t                                        NodeIdType;
+  typedef std::size_t                                        ConnectionIdType;
+  typedef std::vector< bool >                                DomainType;
+  typedef std::vector< NodeIdType >                          NodeIdsType;
+  typedef std::vector< double >                              CostsType;
+
+  ConnectionConstraintSolver( const InterfaceCompatibilityTable & compatibilityTable );
+
+  /** Add a node with the component types that satisfy its component criteria */
+  NodeIdType AddNode( const ComponentIdsType & componentIds );
+
+  ConnectionIdType AddConnection( NodeIdType providingNode, NodeIdType acceptingNode, const InterfaceCriteriaType & interfaceCriteria );
+
+  /** Returns false if the domain of any node became empty. GetConflictingNode() and GetConflictingConnection()
+   * tell which node and by which connection. */
+  bool Solve();
+
+  /** After Solve(), restrict each node in nodes to a single component type, such that all connections remain arc
+   * consistent and the sum of costs[ componentId ] over these nodes is the lowest. Costs must not be negative. Ties are
+   * broken by the lowest component ids. Returns false, leaving all domains unchanged, if no such assignment exists. */
+  bool SelectLowestCost( const NodeIdsType & nodes, const CostsType & costs );
+
+  ComponentIdsType GetComponentIds( NodeIdType node ) const;
+
+  std::size_t GetDomainSize( NodeIdType node ) const;
+
+  NodeIdType GetConflictingNode() const { return this->m_ConflictingNode; }
+
+  ConnectionIdType GetConflictingConnection() const { return this->m_ConflictingConnection; }
+
+private:
+
+  struct ConnectionType
+  {
+    NodeIdType                                     providingNode;
+    NodeIdType                                     acceptingNode;
+    InternedProperties                             interfaceCriteria;
+    InterfaceCompatibilityTable::InterfaceMaskType acceptingInterfaceMask;
+  };
+
+  // An arc revises the domain of one end of a connection against the domain at the other end.
+  struct ArcType
+  {
+    ConnectionIdType connection;
+    bool             reviseProvidingNode;
+  };
+
+  // The arcs to be revised, each at most once in the queue
+  struct ArcQueueType
+  {
+    std::deque< ArcType > arcs;
+    std::vector< bool >   isQueued;
+  };
+
+  bool ApplyNodeConsistency();
+
+  bool Revise( const ArcType & arc );
+
+  void Enqueue( ArcQueueType & queue, const ArcType & arc ) const;
+
+  /** Enqueue the arcs that revise the neighbours of node, except by connection */
+  void EnqueueNeighbours( ArcQueueType & queue, NodeIdType node, ConnectionIdType connection ) const;
+
+  /** AC-3 on the arcs in queue. Returns false if a domain became empty. */
+  bool Propagate( ArcQueueType & queue );
+
+  /** Depth first search over the component types of nodes[ depth ], ... for SelectLowestCost */
+  void SearchLowestCost( const NodeIdsType & nodes, const CostsType & costs, std::size_t depth, double cost );
+
+  void SetConflict( NodeIdType node, ConnectionIdType connection );
+
+  const InterfaceCompatibilityTable & m_CompatibilityTable;
+
+  std::vector< DomainType >                      m_Domains;
+  std::vector< ConnectionType >                  m_Connections;
+  std::vector< std::vector< ConnectionIdType > > m_ConnectionsOfNode;
+
+  NodeIdType       m_ConflictingNode;
+  ConnectionIdType m_ConflictingConnection;
+
+  // The best assignment found by SearchLowestCost, empty if none
+  std::vector< DomainType > m_LowestCostDomains;
+  double                    m_LowestCost;
+};
+} // end namespace selx
+
+#endif // selxConnectionConstraintSolver_h
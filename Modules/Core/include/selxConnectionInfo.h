@@ -20,6 +20,9 @@
 #ifndef ConnectionInfo_h
 #define ConnectionInfo_h
 
+#include <string>
+#include <vector>
+
 namespace selx
 {
 template< class InterfaceT >
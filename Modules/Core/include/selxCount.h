@@ -20,6 +20,8 @@
 #ifndef Count_h
 #define Count_h
 
+#include "selxSymbolTable.h"
+
 namespace selx
 {
 // helper class for SuperElastixComponent::CountAcceptingInterfaces and SuperElastixComponent::CountProvidingInterfaces to loop over a set of interfaces
@@ -30,13 +32,13 @@ struct Count;
 template< >
 struct Count< >
 {
-  static unsigned int MeetsCriteria( const ComponentBase::InterfaceCriteriaType ) { return 0; }
+  static unsigned int MeetsCriteria( const InternedProperties & ) { return 0; }
 };
 
 template< typename FirstInterface, typename ... RestInterfaces >
 struct Count< FirstInterface, RestInterfaces ... >
 {
-  static unsigned int MeetsCriteria( const ComponentBase::InterfaceCriteriaType );
+  static unsigned int MeetsCriteria( const InternedProperties & interfaceCriteria );
 };
 } //end namespace selx
 
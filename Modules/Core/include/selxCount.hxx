@@ -26,18 +26,13 @@ namespace selx
 {
 template< typename FirstInterface, typename ... RestInterfaces >
 unsigned int
-Count< FirstInterface, RestInterfaces ... >::MeetsCriteria( const ComponentBase::InterfaceCriteriaType interfaceCriteria )
+Count< FirstInterface, RestInterfaces ... >::MeetsCriteria( const InternedProperties & interfaceCriteria )
 {
-  auto interfaceProperies = Properties< FirstInterface >::Get();
-  for( const auto keyAndValue : interfaceCriteria )
+  // The properties of each interface are interned once, the criteria are interned once by the caller
+  if( !PropertiesTable< FirstInterface >::Get().MeetsCriteria( interfaceCriteria ) )
   {
-    auto && key   = keyAndValue.first;
-    auto && value = keyAndValue.second;
-    if( interfaceProperies.count( key ) != 1 || interfaceProperies[ key ].compare( value ) != 0 )
-    {
-      // as soon as any of the criteria fails we break the loop and test the RestInterfaces
-      return Count< RestInterfaces ... >::MeetsCriteria( interfaceCriteria );
-    }
+    // as soon as any of the criteria fails we test the RestInterfaces
+    return Count< RestInterfaces ... >::MeetsCriteria( interfaceCriteria );
   }
   // if all criteria are met for this Interface we add 1 to the count and continue with the RestInterfaces
   return 1 + Count< RestInterfaces ... >::MeetsCriteria( interfaceCriteria );
@@ -0,0 +1,97 @@
+/*=========================================================================
+ *
+ *  Copyright Leiden University Medical Center, Erasmus University Medical
+ *  Center and contributors
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+
+#ifndef selxDerivedDataCache_h
+#define selxDerivedDataCache_h
+
+#include "itkDataObject.h"
+
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace selx
+{
+/** \class DerivedDataCache
+ * \brief Shares the data that components derive from the same source, such as the smoothed or shrunk levels of an
+ * image, among all components of a network.
+ *
+ * Derived data is identified by its source, the modified time of the source, the name of the operation by which it is
+ * derived and the parameters of that operation. The first component that requests the data computes it, all other
+ * components get the same data object, which they must not modify. Concurrent requests for the same data wait for this
+ * single computation. The cache holds a reference to each source, such that the address of a source is not reused
+ * while the data derived from it is cached. Data derived from a source is dropped once data is derived from a newer
+ * version of that source.
+ */
+class DerivedDataCache
+{
+public:
+
+  typedef std::shared_ptr< DerivedDataCache >  Pointer;
+  typedef itk::DataObject::Pointer             DataObjectPointer;
+  typedef std::vector< std::string >           ParametersType;
+  typedef std::function< DataObjectPointer() > ComputeFunctionType;
+
+  DerivedDataCache();
+
+  /** The data derived from source by operation with parameters. If it is not cached, it is computed by compute. An
+   * exception thrown by compute is rethrown to all requests that wait for it, and the data is not cached. */
+  DataObjectPointer GetOrCompute( const itk::DataObject * source, const std::string & operation, const ParametersType & parameters,
+    const ComputeFunctionType & compute );
+
+  /** GetOrCompute for a compute function that returns an itk::SmartPointer to DataObjectT */
+  template< class DataObjectT, class ComputeFunctionT >
+  typename DataObjectT::Pointer Get( const itk::DataObject * source, const std::string & operation, const ParametersType & parameters,
+    ComputeFunctionT compute )
+  {
+    DataObjectPointer dataObject = this->GetOrCompute( source, operation, parameters,
+      [ &compute ]() -> DataObjectPointer { return compute().GetPointer(); } );
+    return dynamic_cast< DataObjectT * >( dataObject.GetPointer() );
+  }
+
+  std::size_t GetNumberOfEntries() const;
+
+  /** The number of requests that were served without computing the data */
+  std::size_t GetNumberOfHits() const;
+
+  void Clear();
+
+private:
+
+  typedef std::tuple< const itk::DataObject *, itk::ModifiedTimeType, std::string, ParametersType > KeyType;
+
+  struct EntryType
+  {
+    itk::DataObject::ConstPointer           source;
+    std::shared_future< DataObjectPointer > data;
+  };
+
+  std::map< KeyType, EntryType > m_Entries;
+  std::size_t                    m_NumberOfHits;
+  mutable std::mutex             m_Mutex;
+};
+} // end namespace selx
+
+#endif // selxDerivedDataCache_h
@@ -38,8 +38,9 @@ public:
   // The implementation of Accept() must be provided by component developers.
   virtual int Accept( typename InterfaceT::Pointer ) = 0;
 
-  // Connect tries to connect this accepting interface with all interfaces of the provider component.
-  int Connect( ComponentBase::Pointer );
+  // Connect tries to connect this accepting interface with all interfaces of the provider component. acceptorName is
+  // the name of the component of this accepting interface.
+  int Connect( ComponentBase::Pointer, const std::string & acceptorName );
 
   bool CanAcceptConnectionFrom( ComponentBase::ConstPointer );
 
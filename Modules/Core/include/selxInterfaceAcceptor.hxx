@@ -26,17 +26,17 @@ namespace selx
 {
 template< class InterfaceT >
 int
-InterfaceAcceptor< InterfaceT >::Connect( ComponentBase::Pointer providerComponent )
+InterfaceAcceptor< InterfaceT >::Connect( ComponentBase::Pointer providerComponent, const std::string & acceptorName )
 {
   // Here the core of the handshake mechanism takes place: One specific 
-  // interface of the Providing Component is taken (by dynamic_cast) and 
-  // passed to the accepting Component.
+  // interface of the Providing Component is taken (by its provided interface
+  // table) and passed to the accepting Component.
   // The function returns the number of successful connects (1 or 0)
 
-  std::shared_ptr< InterfaceT > providerInterface = std::dynamic_pointer_cast< InterfaceT >( providerComponent );
+  std::shared_ptr< InterfaceT > providerInterface = ComponentBase::GetProvidedInterface< InterfaceT >( providerComponent );
   if( !providerInterface )
   {
-    // casting failed: this Providing Component does not have the specific interface. 
+    // this Providing Component does not have the specific interface. 
     return 0;
   }
   // connect value interfaces
@@ -44,27 +44,8 @@ InterfaceAcceptor< InterfaceT >::Connect( ComponentBase::Pointer providerCompone
   // store the interface for access by the user defined component 
   this->m_AcceptedInterface = providerInterface;
 
-  // TODO: see if we can get rid of all (dynamic) casts below. Perhaps a "static_cast in release mode"?
-  auto providerConnectionInfo = std::dynamic_pointer_cast<ConnectionInfo< InterfaceT >>( providerComponent);
-  if (!providerConnectionInfo) 
-  {
-    // By definition should not fail, since providerComponent always is a base 
-    // class pointer of an SuperElastixComponent object and 
-    // SuperElastixComponents that are derived from InterfaceT (checked 
-    // previously) also derive from ConnectionInfo< InterfaceT>
-    throw std::runtime_error( "std::dynamic_pointer_cast<ConnectionInfo< InterfaceT > should not fail by definition " );
-  }
-
-  ComponentBase* AcceptorBaseComponent = dynamic_cast<ComponentBase*>( this );
-  if (!AcceptorBaseComponent)
-  {
-    // By definition should not fail, since 'this', the AcceptorInterface, and 
-    // ComponentBase are both base classes from the SuperElastixComponent 
-    // object on which this functionality is called.
-    throw std::runtime_error("dynamic_cast<ComponentBase*> should not fail by definition ");
-  }
-
-  providerConnectionInfo->SetProvidedTo(AcceptorBaseComponent->m_Name);
+  // SuperElastixComponents that provide InterfaceT also derive from ConnectionInfo< InterfaceT >
+  ComponentBase::GetConnectionInfo< InterfaceT >( providerComponent )->SetProvidedTo( acceptorName );
   return 1;
 }
 
@@ -73,8 +54,7 @@ template< class InterfaceT >
 bool
 InterfaceAcceptor< InterfaceT >::CanAcceptConnectionFrom( ComponentBase::ConstPointer providerComponent )
 {
-  std::shared_ptr< const InterfaceT > providerInterface = std::dynamic_pointer_cast< const InterfaceT >( providerComponent );
-  return bool(providerInterface);
+  return providerComponent->IsProviding< InterfaceT >();
 }
 } //end namespace selx
 #endif // InterfaceAcceptor_hxx
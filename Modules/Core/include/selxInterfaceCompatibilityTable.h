@@ -0,0 +1,84 @@
+/*=========================================================================
+ *
+ *  Copyright Leiden University Medical Center, Erasmus University Medical
+ *  Center and contributors
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#ifndef selxInterfaceCompatibilityTable_h
+#define selxInterfaceCompatibilityTable_h
+
+#include "selxComponentDescriptor.h"
+#include "selxInterfaceStatus.h"
+
+#include <memory>
+#include <vector>
+
+namespace selx
+{
+/** \class InterfaceCompatibilityTable
+ * \brief Dense table of which component types can accept which interface from which other component types.
+ *
+ * Component types are identified by the index of their ComponentDescriptor. Each accepting interface of each
+ * component type occupies one row of the table, holding for every component type whether it provides that
+ * interface. The rows are computed from the interface types of the descriptors: a component provides an interface
+ * if it is in its Providing< ... > list, which is exactly the condition under which InterfaceAcceptor::Connect
+ * succeeds. The handshakes during network configuration then are lookups over integer ids, without any component
+ * being instantiated or any dynamic_cast.
+ */
+class InterfaceCompatibilityTable
+{
+public:
+
+  typedef std::shared_ptr< const InterfaceCompatibilityTable > ConstPointer;
+  typedef ComponentDescriptor::InterfaceCriteriaType           InterfaceCriteriaType;
+  typedef std::size_t                                          ComponentIdType;
+  typedef std::vector< ComponentIdType >                       ComponentIdsType;
+  typedef std::vector< const ComponentDescriptor * >           DescriptorsType;
+
+  // Per accepting interface row: does it satisfy the criteria of a connection.
+  typedef std::vector< bool > InterfaceMaskType;
+
+  /** Compute the table of the component types in descriptors, which are identified by their index in descriptors */
+  InterfaceCompatibilityTable( const DescriptorsType & descriptors );
+
+  ComponentIdType GetNumberOfComponents() const { return this->m_Descriptors.size(); }
+
+  const ComponentDescriptor & GetDescriptor( ComponentIdType componentId ) const { return *this->m_Descriptors[ componentId ]; }
+
+  /** Evaluate the interface criteria of a connection once for all accepting interfaces in the table */
+  InterfaceMaskType GetAcceptingInterfaceMask( const InterfaceCriteriaType & interfaceCriteria ) const;
+
+  InterfaceMaskType GetAcceptingInterfaceMask( const InternedProperties & interfaceCriteria ) const;
+
+  /** Equivalent of ComponentBase::CanAcceptConnectionFrom for the component types acceptorId and providerId */
+  InterfaceStatus CanAcceptConnectionFrom( ComponentIdType acceptorId, ComponentIdType providerId, const InterfaceMaskType & acceptingInterfaceMask ) const;
+
+  /** True if acceptorId accepts at least one interface from providerId, i.e. the status is success or multiple */
+  bool CanConnect( ComponentIdType acceptorId, ComponentIdType providerId, const InterfaceMaskType & acceptingInterfaceMask ) const;
+
+private:
+
+  const DescriptorsType m_Descriptors;
+
+  // The rows of component type c are [ m_RowOffsets[ c ], m_RowOffsets[ c + 1 ] ), in the order of its Accepting< ... > list.
+  std::vector< std::size_t > m_RowOffsets;
+
+  // m_IsProvidedBy[ row * GetNumberOfComponents() + providerId ]
+  std::vector< bool > m_IsProvidedBy;
+};
+} // end namespace selx
+
+#endif // selxInterfaceCompatibilityTable_h
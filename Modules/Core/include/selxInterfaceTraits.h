@@ -27,6 +27,7 @@
 #include "selxStaticErrorMessageRevealT.h"
 #include "selxPodString.h"
 #include "selxKeys.h"
+#include "selxSymbolTable.h"
 //#include <type_traits>
 
 namespace selx
@@ -51,6 +52,18 @@ struct Properties< InterfaceAcceptor< InterfaceType >>
   }
 };
 
+// Properties<T>::Get() builds a new map at each call. PropertiesTable<T>::Get() interns these properties once, for
+// matching interface criteria during component selection and handshakes.
+template< typename T >
+struct PropertiesTable
+{
+  static const InternedProperties & Get()
+  {
+    static const InternedProperties properties = InternedProperties::Intern( Properties< T >::Get() );
+    return properties;
+  }
+};
+
 // The specializations for each type of Interface supported by the toolbox
 
 template< >
@@ -71,6 +71,10 @@ public:
 
   // This method is implemented in the SuperElastixComponent class and does not need to be implemented by each component individually.
   virtual const typename std::string GetComponentName() = 0; 
+
+  // The number of threads the component may use internally during Update(), 0 leaves it to the component. Like GetComponentName,
+  // this method is implemented in the SuperElastixComponent class.
+  virtual void SetNumberOfThreads( unsigned int numberOfThreads ) = 0;
 };
 
 } // end namespace selx
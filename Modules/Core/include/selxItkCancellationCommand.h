@@ -0,0 +1,83 @@
+/*=========================================================================
+ *
+ *  Copyright Leiden University Medical Center, Erasmus University Medical
+ *  Center and contributors
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+
+#ifndef selxItkCancellationCommand_h
+#define selxItkCancellationCommand_h
+
+#include "selxCancellationToken.h"
+
+#include "itkCommand.h"
+#include "itkProcessObject.h"
+
+namespace selx
+{
+/** \class ItkCancellationCommand
+ * \brief Aborts an itk filter when the cancellation token of its component is cancelled.
+ *
+ * Observe the iteration events of the filter, or of its optimizer, by this command. When the token is cancelled, the
+ * command sets AbortGenerateData of the filter and throws an itk::ProcessAborted exception, by which the filter resets
+ * its pipeline and the exception leaves the Update() of the component.
+ */
+class ItkCancellationCommand : public itk::Command
+{
+public:
+
+  typedef ItkCancellationCommand    Self;
+  typedef itk::Command              Superclass;
+  typedef itk::SmartPointer< Self > Pointer;
+  itkNewMacro( Self );
+
+  void SetCancellationToken( CancellationToken::Pointer cancellationToken ) { this->m_CancellationToken = cancellationToken; }
+
+  /** The filter to abort, which is not owned by the command, as the command is owned by the filter or its optimizer */
+  void SetProcessObject( itk::ProcessObject * processObject ) { this->m_ProcessObject = processObject; }
+
+  virtual void Execute( itk::Object * caller, const itk::EventObject & event ) ITK_OVERRIDE
+  {
+    this->Execute( (const itk::Object *)caller, event );
+  }
+
+
+  virtual void Execute( const itk::Object *, const itk::EventObject & ) ITK_OVERRIDE
+  {
+    if( this->m_CancellationToken && this->m_CancellationToken->IsCancelled() )
+    {
+      if( this->m_ProcessObject )
+      {
+        this->m_ProcessObject->SetAbortGenerateData( true );
+      }
+      itk::ProcessAborted exception( __FILE__, __LINE__ );
+      exception.SetDescription( "Cancelled" );
+      throw exception;
+    }
+  }
+
+protected:
+
+  ItkCancellationCommand() : m_ProcessObject( nullptr ) {}
+
+private:
+
+  CancellationToken::Pointer m_CancellationToken;
+  itk::ProcessObject *       m_ProcessObject;
+};
+} // end namespace selx
+
+#endif // selxItkCancellationCommand_h
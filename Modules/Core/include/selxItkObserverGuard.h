@@ -0,0 +1,68 @@
+/*=========================================================================
+ *
+ *  Copyright Leiden University Medical Center, Erasmus University Medical
+ *  Center and contributors
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#ifndef selxItkObserverGuard_h
+#define selxItkObserverGuard_h
+
+#include "itkCommand.h"
+#include "itkObject.h"
+
+#include <utility>
+#include <vector>
+
+namespace selx
+{
+/** \class ItkObserverGuard
+ * \brief Removes the observers that a component added to its itk filter, or to the optimizer of the filter, for one
+ * Update().
+ *
+ * The observers are removed when the guard goes out of scope, also when the Update() of the filter throws, e.g. an
+ * itk::ProcessAborted exception by an ItkCancellationCommand. A filter that is updated again therefore never holds
+ * the observers of an earlier update.
+ */
+class ItkObserverGuard
+{
+public:
+
+  ItkObserverGuard() {}
+
+  ~ItkObserverGuard()
+  {
+    for( const auto & objectAndTag : this->m_ObserverTags )
+    {
+      objectAndTag.first->RemoveObserver( objectAndTag.second );
+    }
+  }
+
+  /** Let command observe event of object until the guard goes out of scope */
+  void AddObserver( itk::Object * object, const itk::EventObject & event, itk::Command * command )
+  {
+    this->m_ObserverTags.emplace_back( object, object->AddObserver( event, command ) );
+  }
+
+private:
+
+  ItkObserverGuard( const ItkObserverGuard & ); // purposely not implemented
+  void operator=( const ItkObserverGuard & );   // purposely not implemented
+
+  std::vector< std::pair< itk::Object::Pointer, unsigned long >> m_ObserverTags;
+};
+} // end namespace selx
+
+#endif // selxItkObserverGuard_h
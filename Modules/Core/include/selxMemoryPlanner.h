@@ -0,0 +1,87 @@
+/*=========================================================================
+ *
+ *  Copyright Leiden University Medical Center, Erasmus University Medical
+ *  Center and contributors
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#ifndef selxMemoryPlanner_h
+#define selxMemoryPlanner_h
+
+#include "selxComponentBase.h"
+
+#include <mutex>
+#include <vector>
+
+namespace selx
+{
+/** \class MemoryPlanner
+ * \brief Releases the output data of components as soon as no component downstream needs it anymore.
+ *
+ * The lifetime of the data of each component is expressed in steps of the update order of the network: the data is
+ * produced at the update of the component itself, or, for components that are part of an itk pipeline, at the first
+ * update that pulls it. It is last used at the update of the latest component downstream. Data that is only consumed
+ * by components in the update order is released by ComponentBase::ReleaseData() once all of these have finished,
+ * in any order in which the updates are executed. All other data lives until the network is destroyed.
+ */
+class MemoryPlanner
+{
+public:
+
+  using UpdateIndicesType = std::vector< std::size_t >;
+
+  /** numberOfUpdates is the length of the update order of the network */
+  MemoryPlanner( std::size_t numberOfUpdates );
+
+  /** Add a component that produces its data at producingUpdate, or at numberOfUpdates if it is only produced after the
+   * network is executed, and whose data is needed by consumingUpdates. If isReleasable, the data is released after the
+   * last consuming update has finished. */
+  void AddComponent( ComponentBase::Pointer component, std::size_t producingUpdate, const UpdateIndicesType & consumingUpdates,
+    bool isReleasable );
+
+  /** Prepare for the next execution of the network */
+  void Reset();
+
+  /** Release the data that is not needed anymore after update has finished. Thread safe. */
+  void UpdateFinished( std::size_t update );
+
+  /** The estimated peak memory in bytes, by the ComponentBase::GetOutputMemorySize() of all components, when executing
+   * the updates one by one. The memory that a component needs beyond its output, by ComponentBase::GetResourceEstimate(),
+   * counts only at the update at which it runs. If withRelease is false, no data is released during execution. */
+  std::size_t GetEstimatedPeakMemorySize( bool withRelease = true ) const;
+
+  /** The resource estimates of all components, in the order in which they run, and the peak memory of the network */
+  NetworkPlanReport GetPlanReport() const;
+
+private:
+
+  struct ComponentLifetimeType
+  {
+    ComponentBase::Pointer component;
+    std::size_t            producingUpdate;
+    std::size_t            lastConsumingUpdate;
+    bool                   isReleasable;
+  };
+
+  const std::size_t                    m_NumberOfUpdates;
+  std::vector< ComponentLifetimeType > m_Components;
+  std::vector< UpdateIndicesType >     m_ReleasableComponentsPerUpdate;
+  std::vector< std::size_t >           m_NumberOfConsumingUpdates;
+  std::vector< std::size_t >           m_NumberOfUnfinishedConsumingUpdates;
+  std::mutex                           m_Mutex;
+};
+} // end namespace selx
+
+#endif // selxMemoryPlanner_h
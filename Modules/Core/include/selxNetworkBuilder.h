@@ -31,19 +31,25 @@
 #include <string>
 #include <cstring>
 #include <map>
+#include <set>
+#include <tuple>
 
 #include "selxLoggerImpl.h"
 #include "selxBlueprintImpl.h"
 #include "selxNetworkContainer.h"
+#include "selxComponentAssignmentCache.h"
+#include "selxComponentRegistry.h"
+#include "selxComponentSelector.h"
+#include "selxDerivedDataCache.h"
 #include "selxInterfaces.h"
 #include "selxInterfaceTraits.h"
 
 namespace selx
 {
-template< class ComponentList >
 class NetworkBuilder : public NetworkBuilderBase
 {
   // The NetworkBuilder takes care of the at run time realization of the algorithm network that is described by the BlueprintImpl.
+  // The components are selected from the component types in a ComponentRegistry.
   // The output, GetRealizedNetwork(), is a (light weight) ComponentContainer with 1 Execute button that is self-contained to run the registration algorithm.
   // After obtaining the RealizedNetwork(), the NetworkBuilder object can be deleted in order to free memory, releasing all internal/intermediate data of the configuration process.
 
@@ -55,22 +61,27 @@ public:
   typedef std::map<
     std::string, SinkInterface::Pointer > SinkInterfaceMapType;
 
-  NetworkBuilder( LoggerImpl & logger, const BlueprintImpl & blueprint );
+  NetworkBuilder( LoggerImpl & logger, const BlueprintImpl & blueprint, ComponentRegistry & componentRegistry );
   virtual ~NetworkBuilder() {}
 
   //Disabled
   virtual bool AddBlueprint( const BlueprintImpl & blueprint );
 
-  /** Read configuration at the blueprints nodes and edges and return true if all components could be uniquely selected*/
+  /** Read configuration at the blueprints nodes and edges and return true if all components could be uniquely selected.
+   * After the blueprint was modified, Configure() selects the modified components anew and keeps all other components. */
   virtual bool Configure();
 
-  /** if all components are uniquely selected, they can be connected */
+  /** if all components are uniquely selected, they can be connected. After a reconfiguration only the connections of
+   * the components that were selected anew and the added or modified connections are made. */
   virtual bool ConnectComponents();
 
   virtual bool CheckConnectionsSatisfied();
 
+  /** Can be called repeatedly, e.g. to get the plan report before executing the network */
   virtual NetworkContainer GetRealizedNetwork();
 
+  virtual NetworkPlanReport GetPlanReport( unsigned int numberOfThreads );
+
   virtual SourceInterfaceMapType GetSourceInterfaces();
 
   virtual SinkInterfaceMapType GetSinkInterfaces();
@@ -87,24 +98,34 @@ protected:
   typedef ComponentBase::CriterionType      CriterionType;
   typedef ComponentBase::ParameterValueType ParameterValueType;
 
-  typedef ComponentSelector< ComponentList >      ComponentSelectorType;
-  typedef typename ComponentSelectorType::Pointer ComponentSelectorPointer;
+  typedef ComponentSelector::Pointer ComponentSelectorPointer;
 
   typedef std::map< ComponentNameType, ComponentSelectorPointer > ComponentSelectorContainerType;
-  typedef typename ComponentSelectorContainerType::iterator       ComponentSelectorIteratorType;
+  typedef ComponentSelectorContainerType::iterator                ComponentSelectorIteratorType;
+
+  typedef ComponentAssignmentCache::ComponentAssignmentType ComponentAssignmentType;
 
-  /** Read configuration at the blueprints nodes and try to find instantiated components */
-  virtual void ApplyComponentConfiguration();
+  /** Read configuration at the blueprints nodes componentNames and try to find instantiated components. The selection of the
+   * components in componentAssignment is restricted to the assigned component type beforehand. */
+  virtual void ApplyComponentConfiguration( const ComponentNamesType & componentNames, const ComponentAssignmentType & componentAssignment );
 
-  /** Read configuration at the blueprints edges and try to find instantiated components */
-  virtual void ApplyConnectionConfiguration();
+  /** Select the components that were added or modified since the last Configure() anew and solve the connection
+   * constraints with all other components fixed. Returns false if these constraints cannot be solved. */
+  virtual bool ReconfigureModifiedComponents();
 
-  /** For all uniquely selected components test handshake to non-uniquely selected components */
-  virtual void PropagateConnectionsWithUniqueComponents();
+  /** Read configuration at the blueprints edges and narrow the selection of all components to those that can be connected */
+  virtual void SolveConnectionConstraints();
 
   /** See which components need more configuration criteria */
   virtual ComponentNamesType GetNonUniqueComponentNames();
 
+  /** Expand the replications of the declared blueprint into m_ReplicatedBlueprint after it was modified. Returns false if
+   * the replications cannot be expanded. */
+  bool UpdateReplicatedBlueprint();
+
+  /** Find the Source and Sink Components, once after each Configure() */
+  void UpdateInterfaceMaps();
+
   void Cite();
 
   //TODO make const correct
@@ -116,14 +137,38 @@ protected:
   ComponentSelectorContainerType  m_ComponentSelectorContainer;
   bool                            m_isConfigured;
   LoggerImpl &                    m_Logger;
+
+  // The blueprint as given, and the blueprint with its replications expanded from which the network is built
+  const BlueprintImpl &                 m_DeclaredBlueprint;
+  BlueprintImpl                         m_ReplicatedBlueprint;
+  BlueprintImpl::ModifiedTimeType       m_ReplicatedModifiedTime;
   const BlueprintImpl &                 m_Blueprint;
+  ComponentRegistry &                   m_ComponentRegistry;
+
+  // Taken at construction, such that all selectors of this network refer to the same component ids
+  ComponentRegistry::CompatibilityTablePointer m_CompatibilityTable;
+
+  // The data derived by the components of this network, shared among them
+  DerivedDataCache::Pointer m_DerivedDataCache;
+
+  // For reconfiguration after the blueprint was modified
+  BlueprintImpl::ModifiedTimeType  m_ConfiguredModifiedTime;
+  std::set< ComponentNameType >    m_ReselectedComponentNames;
+
+  // The connections as configured, by upstream, downstream and connection name. A component that accepted a
+  // connection that was deleted since then still holds its interface, hence it is selected anew.
+  typedef std::tuple< ComponentNameType, ComponentNameType, BlueprintImpl::ConnectionNameType > ConnectionKeyType;
+  std::set< ConnectionKeyType >    m_ConfiguredConnections;
+  bool                             m_IsConnected;
+  BlueprintImpl::ModifiedTimeType  m_ConnectedModifiedTime;
+
+  // The Source and Sink Components by name, valid until the next Configure()
+  bool                             m_AreInterfaceMapsValid;
+  SourceInterfaceMapType           m_SourceInterfaceMap;
+  SinkInterfaceMapType             m_SinkInterfaceMap;
 
 private:
 };
 } // end namespace selx
 
-#ifndef ITK_MANUAL_INSTANTIATION
-#include "selxNetworkBuilder.hxx"
-#endif
-
 #endif // NetworkBuilder_h
@@ -61,7 +61,8 @@ public:
 
   virtual bool AddBlueprint( const BlueprintImpl & blueprint ) = 0;
 
-  /** Read configuration at the blueprints nodes and edges and return true if all components could be uniquely selected*/
+  /** Read configuration at the blueprints nodes and edges and return true if all components could be uniquely selected.
+   * Can be called again after the blueprint was modified, to reconfigure the network. */
   virtual bool Configure() = 0;
 
   /** if all components are uniquely selected, they can be connected */
@@ -71,6 +72,9 @@ public:
 
   virtual NetworkContainer GetRealizedNetwork() = 0;
 
+  /** The resource estimates of the realized network, before it is executed, with numberOfThreads as by NetworkContainer::SetNumberOfThreads */
+  virtual NetworkPlanReport GetPlanReport( unsigned int numberOfThreads ) = 0;
+
   virtual SourceInterfaceMapType GetSourceInterfaces() = 0;
 
   virtual SinkInterfaceMapType GetSinkInterfaces() = 0;
@@ -21,23 +21,27 @@
 #define NetworkBuilderFactory_h
 
 #include "selxNetworkBuilderFactoryBase.h"
+#include "selxNetworkBuilder.h"
 
 namespace selx
 {
-template< class ComponentList >
+/** Creates NetworkBuilders that select their components from a ComponentRegistry */
 class NetworkBuilderFactory : public NetworkBuilderFactoryBase
 {
 public:
 
-  NetworkBuilderFactory() {}
+  NetworkBuilderFactory( ComponentRegistry & componentRegistry ) : m_ComponentRegistry( componentRegistry ) {}
   virtual ~NetworkBuilderFactory() {}
 
-  virtual std::unique_ptr< NetworkBuilderBase > New( LoggerImpl & logger, const BlueprintImpl & blueprint );
+  virtual std::unique_ptr< NetworkBuilderBase > New( LoggerImpl & logger, const BlueprintImpl & blueprint )
+  {
+    return std::unique_ptr< NetworkBuilderBase >( new NetworkBuilder( logger, blueprint, this->m_ComponentRegistry ) );
+  }
+
+private:
+
+  ComponentRegistry & m_ComponentRegistry;
 };
 } // end namespace selx
 
-#ifndef ITK_MANUAL_INSTANTIATION
-#include "selxNetworkBuilderFactory.hxx"
-#endif
-
 #endif // NetworkBuilderFactory_h
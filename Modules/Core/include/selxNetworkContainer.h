@@ -22,6 +22,10 @@
 
 #include "selxComponentBase.h"
 #include "selxInterfaces.h"
+#include "selxUpdateScheduler.h"
+#include "selxMemoryPlanner.h"
+#include "selxCheckpoint.h"
+#include "selxCancellationToken.h"
 
 #include "itkDataObject.h"
 
@@ -40,13 +44,87 @@ public:
   using ComponentContainerType = std::vector< std::shared_ptr< ComponentBase >>;
   using UpdateOrderType = std::vector<std::shared_ptr< UpdateInterface >>;
   using OutputObjectsMapType   = std::map< std::string, itk::DataObject::Pointer >;
+  using SourceInterfaceMapType = std::map< std::string, SourceInterface::Pointer >;
+  using DependenciesType       = UpdateScheduler::DependenciesType;
 
-  NetworkContainer( ComponentContainerType components, UpdateOrderType updateOrder, OutputObjectsMapType outputObjectsMap );
+  using MemoryPlannerPointer   = std::shared_ptr< MemoryPlanner >;
+  using CheckpointPointer      = std::shared_ptr< Checkpoint >;
+
+  /** dependencies holds, for each update in updateOrder, the indices of the updates that must finish before it: those
+   * upstream of it, and earlier updates that pull the same itk pipeline. Without dependencies each update depends on
+   * its predecessor in updateOrder. The memoryPlanner, if any, releases the
+   * data of components during Execute. The blueprintKey identifies the blueprint of the network in checkpoints. */
+  NetworkContainer( ComponentContainerType components, UpdateOrderType updateOrder, OutputObjectsMapType outputObjectsMap,
+    SourceInterfaceMapType sourceInterfaceMap = {}, DependenciesType dependencies = {}, MemoryPlannerPointer memoryPlanner = nullptr,
+    const std::string & blueprintKey = "" );
   ~NetworkContainer() {}
 
-  /** Run the (registration) algorithm */
+  /** Run the (registration) algorithm. Throws a CancellationToken::CancelledError if the network is cancelled. */
   void Execute();
 
+  /** Stop a running Execute(), from another thread. Components that are being updated abort at their next check of the
+   * cancellation token, no further components are updated. The network remains cancelled until its token is Reset(). */
+  void Cancel();
+
+  /** Share cancellationToken with all components of the network, e.g. to cancel several networks at once, or by a
+   * deadline set by CancellationToken::CancelAfter(). */
+  void SetCancellationToken( CancellationToken::Pointer cancellationToken );
+
+  CancellationToken::Pointer GetCancellationToken() const;
+
+  /** Let the registration components of the network stream their ProgressEvents to progressEventBuffer, from which
+   * the caller pops them while Execute() runs. The default nullptr reports no progress. */
+  void SetProgressEventBuffer( ProgressEventBuffer::Pointer progressEventBuffer );
+
+  /** The total number of threads Execute may use. Independent branches of the network are updated concurrently and the
+   * threads are divided among the components that run side by side. Components with a NumberOfThreads criterion in the
+   * blueprint keep their own number of threads. The default of 0 updates the components one by one without limiting
+   * their threads. */
+  void SetNumberOfThreads( unsigned int numberOfThreads );
+
+  unsigned int GetNumberOfThreads() const;
+
+  /** Make the results of Execute reproducible bit by bit, e.g. for regression benchmarks. Each component maps this onto
+   * its backend: random samplers are seeded by the RandomSeed, or by DefaultRandomSeed if none is set, and
+   * multithreaded reductions are avoided. The components may still be updated concurrently. */
+  void SetDeterministic( bool deterministic );
+
+  bool GetDeterministic() const;
+
+  /** The seed of the random number generators of all components. The default of 0 leaves the seeds to the backends,
+   * which may differ from run to run unless the network is deterministic. */
+  void SetRandomSeed( unsigned int randomSeed );
+
+  unsigned int GetRandomSeed() const;
+
+  /** The seed of a deterministic network without RandomSeed, the default of elastix */
+  static const unsigned int DefaultRandomSeed = 121212;
+
+  /** Let Execute write the results of each component that finished its update to directory, by
+   * ComponentBase::WriteCheckpoint(). When the network is executed again, e.g. after an interruption, with the same
+   * blueprint and the same inputKey, the components that finished before are restored from directory instead of
+   * updated. The inputKey identifies the inputs of the network, e.g. by their file names and modification times.
+   * An empty inputKey cannot tell other inputs apart: checkpoints are then written, but never restored. An empty
+   * directory disables checkpoints. */
+  void SetCheckpoint( const std::string & directory, const std::string & inputKey );
+
+  /** The estimated peak memory in bytes of Execute, 0 if unknown. If withRelease is false, as if no data were released early. */
+  std::size_t GetEstimatedPeakMemorySize( bool withRelease = true ) const;
+
+  /** The estimated runtime class and peak memory of each component and of the network as a whole, before Execute.
+   * The components report their estimates by the image domains of their inputs, so the output information of the
+   * network must be up to date. */
+  NetworkPlanReport GetPlanReport() const;
+
+  /** Pass a new input to the Source Component with name sourceName. A realized network can be executed repeatedly,
+   * each time on new inputs, without selecting and connecting its components again. The Source Components pass
+   * the new data to their already connected mini pipelines, i.e. the output objects remain the same objects. The
+   * checkpoint, if any, is not restored until SetCheckpoint is given the inputKey of the new inputs. */
+  void SetInput( const std::string & sourceName, itk::DataObject::Pointer input );
+
+  /** Get the names of the Source Components that accept inputs by SetInput */
+  std::vector< std::string > GetInputNames();
+
   /** Get the Sinking output objects */
   OutputObjectsMapType GetOutputObjectsMap();
 
@@ -55,6 +133,16 @@ private:
   const ComponentContainerType m_ComponentContainer;
   const UpdateOrderType m_UpdateOrder;
   const OutputObjectsMapType   m_OutputObjectsMap;
+  const SourceInterfaceMapType m_SourceInterfaceMap;
+  UpdateScheduler              m_UpdateScheduler;
+  const MemoryPlannerPointer   m_MemoryPlanner;
+  const std::string            m_BlueprintKey;
+  CheckpointPointer            m_Checkpoint;
+  bool                         m_IsCheckpointRestorable;
+  CancellationToken::Pointer   m_CancellationToken;
+  unsigned int                 m_NumberOfThreads;
+  bool                         m_Deterministic;
+  unsigned int                 m_RandomSeed;
 };
 } // end namespace selx
 #endif // selxNetworkContainer_h
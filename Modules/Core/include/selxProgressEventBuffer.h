@@ -0,0 +1,95 @@
+/*=========================================================================
+ *
+ *  Copyright Leiden University Medical Center, Erasmus University Medical
+ *  Center and contributors
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+
+#ifndef selxProgressEventBuffer_h
+#define selxProgressEventBuffer_h
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace selx
+{
+/** The progress of a registration component at one iteration of its optimization */
+struct ProgressEvent
+{
+  std::string componentName;
+  // The level of the multi-resolution pyramid, starting at 0
+  unsigned int level;
+  // The iteration within the level. Components that cannot observe their iterations report once at the end of each
+  // level, with the number of iterations 0 and a NaN metric value.
+  std::size_t iteration;
+  double      metricValue;
+  // The time in seconds since the buffer was created
+  double elapsedTime;
+};
+
+/** \class ProgressEventBuffer
+ * \brief A bounded lock-free queue by which registration components stream their ProgressEvents to a listener.
+ *
+ * Any number of components push events concurrently while the listener pops them, e.g. from another thread while the
+ * network executes. Pushing never blocks or allocates beyond the copy of the component name: when the buffer is full,
+ * because the listener does not keep up, the event is dropped and counted. Components do not report progress when
+ * no buffer is set, such that there is no overhead when nobody listens.
+ */
+class ProgressEventBuffer
+{
+public:
+
+  typedef std::shared_ptr< ProgressEventBuffer > Pointer;
+  typedef std::chrono::steady_clock              ClockType;
+
+  /** capacity is rounded up to a power of two */
+  ProgressEventBuffer( std::size_t capacity = 4096 );
+
+  /** Returns false, and drops the event, if the buffer is full. Thread safe. */
+  bool Push( const ProgressEvent & event );
+
+  /** Returns false if the buffer is empty. Thread safe. */
+  bool Pop( ProgressEvent & event );
+
+  std::size_t GetCapacity() const;
+
+  std::size_t GetNumberOfDroppedEvents() const;
+
+  /** Seconds since the buffer was created */
+  double GetElapsedTime() const;
+
+private:
+
+  // Each cell has a sequence number that tells whether it is free to be written or ready to be read for a given position
+  struct CellType
+  {
+    std::atomic< std::size_t > sequence;
+    ProgressEvent              event;
+  };
+
+  std::vector< CellType >     m_Cells;
+  const std::size_t           m_Mask;
+  std::atomic< std::size_t >  m_PushPosition;
+  std::atomic< std::size_t >  m_PopPosition;
+  std::atomic< std::size_t >  m_NumberOfDroppedEvents;
+  const ClockType::time_point m_StartTime;
+};
+} // end namespace selx
+
+#endif // selxProgressEventBuffer_h
@@ -0,0 +1,114 @@
+/*=========================================================================
+ *
+ *  Copyright Leiden University Medical Center, Erasmus University Medical
+ *  Center and contributors
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#ifndef selxProvidedInterfaceTable_h
+#define selxProvidedInterfaceTable_h
+
+#include "selxConnectionInfo.h"
+
+#include <vector>
+
+namespace selx
+{
+class ComponentBase;
+
+typedef unsigned int InterfaceIdType;
+
+// Generates the ids of InterfaceId
+struct InterfaceIds
+{
+  static InterfaceIdType New();
+};
+
+/** \class InterfaceId
+ * \brief Process wide unique, small integer id of each interface type, assigned at its first use.
+ */
+template< class InterfaceT >
+struct InterfaceId
+{
+  static InterfaceIdType Get()
+  {
+    static const InterfaceIdType id = InterfaceIds::New();
+    return id;
+  }
+};
+
+/** \class ProvidedInterfaceTable
+ * \brief The interfaces that a type of component provides, indexed by InterfaceId.
+ *
+ * Each entry casts a component to one of its providing interfaces, and to the ConnectionInfo of that interface, by
+ * static casts that are generated from the Providing<...> list of the component type. Handshakes and the scans of the
+ * network builder for sources, sinks and updates thus need no dynamic_cast.
+ */
+class ProvidedInterfaceTable
+{
+public:
+
+  typedef void * (*CastFunctionType)( ComponentBase * );
+
+  struct EntryType
+  {
+    CastFunctionType toInterface;
+    CastFunctionType toConnectionInfo;
+  };
+
+  /** The table of ComponentT, which must derive from ComponentBase and from each of ProvidingInterfaces */
+  template< class ComponentT, class ProvidingInterfaces >
+  static ProvidedInterfaceTable New()
+  {
+    ProvidedInterfaceTable table;
+    ProvidingInterfaces::template AddToTable< ComponentT >( table );
+    return table;
+  }
+
+  template< class ComponentT, class InterfaceT >
+  void Add()
+  {
+    const InterfaceIdType id = InterfaceId< InterfaceT >::Get();
+    if( id >= this->m_Entries.size() )
+    {
+      this->m_Entries.resize( id + 1, { nullptr, nullptr } );
+    }
+    this->m_Entries[ id ] = {
+      []( ComponentBase * component ) -> void * {
+        return static_cast< InterfaceT * >( static_cast< ComponentT * >( component ) );
+      },
+      []( ComponentBase * component ) -> void * {
+        return static_cast< ConnectionInfo< InterfaceT > * >( static_cast< ComponentT * >( component ) );
+      }
+    };
+  }
+
+  /** The entry of interfaceId, or nullptr if the component does not provide that interface */
+  const EntryType * Find( InterfaceIdType interfaceId ) const
+  {
+    if( interfaceId >= this->m_Entries.size() || this->m_Entries[ interfaceId ].toInterface == nullptr )
+    {
+      return nullptr;
+    }
+    return &this->m_Entries[ interfaceId ];
+  }
+
+private:
+
+  std::vector< EntryType > m_Entries;
+};
+} // end namespace selx
+
+#endif // selxProvidedInterfaceTable_h
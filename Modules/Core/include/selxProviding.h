@@ -21,6 +21,7 @@
 #define Providing_h
 
 #include "selxConnectionInfo.h"
+#include "selxProvidedInterfaceTable.h"
 
 namespace selx
 {
@@ -32,7 +33,10 @@ class Providing< >
 {
 public:
 
-  static unsigned int CountMeetsCriteria( const ComponentBase::InterfaceCriteriaType ) { return 0; }
+  static unsigned int CountMeetsCriteria( const InternedProperties & ) { return 0; }
+
+  template< class ComponentT >
+  static void AddToTable( ProvidedInterfaceTable & ) {}
 
 protected:
 };
@@ -42,7 +46,11 @@ class Providing< FirstInterface, RestInterfaces ... > : public FirstInterface, p
 {
 public:
 
-  static unsigned int CountMeetsCriteria( const ComponentBase::InterfaceCriteriaType );
+  static unsigned int CountMeetsCriteria( const InternedProperties & interfaceCriteria );
+
+  // Add the casts of ComponentT to each of the interfaces to the table
+  template< class ComponentT >
+  static void AddToTable( ProvidedInterfaceTable & table );
 
 protected:
 };
@@ -24,9 +24,19 @@ namespace selx
 {
 template< typename FirstInterface, typename ... RestInterfaces >
 unsigned int
-Providing< FirstInterface, RestInterfaces ... >::CountMeetsCriteria( const ComponentBase::InterfaceCriteriaType interfaceCriteria )
+Providing< FirstInterface, RestInterfaces ... >::CountMeetsCriteria( const InternedProperties & interfaceCriteria )
 {
   return Count< FirstInterface, RestInterfaces ... >::MeetsCriteria( interfaceCriteria );
 }
+
+
+template< typename FirstInterface, typename ... RestInterfaces >
+template< class ComponentT >
+void
+Providing< FirstInterface, RestInterfaces ... >::AddToTable( ProvidedInterfaceTable & table )
+{
+  table.Add< ComponentT, FirstInterface >();
+  Providing< RestInterfaces ... >::template AddToTable< ComponentT >( table );
+}
 } //end namespace selx
 #endif // Providing_hxx
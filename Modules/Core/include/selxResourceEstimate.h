@@ -0,0 +1,85 @@
+/*=========================================================================
+ *
+ *  Copyright Leiden University Medical Center, Erasmus University Medical
+ *  Center and contributors
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#ifndef selxResourceEstimate_h
+#define selxResourceEstimate_h
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace selx
+{
+/** \class ResourceEstimate
+ * \brief The resources that the update of a component is estimated to need, reported before the network is executed.
+ *
+ * Components estimate these from the image domains of their connected inputs, which are known after the components
+ * are connected and the output information of the network is updated.
+ */
+struct ResourceEstimate
+{
+  /** How the runtime of a component grows with the size of its inputs. Iterative components, such as registration
+   * methods, pass over their inputs a number of times that is bounded by their settings, but not known beforehand. */
+  enum class RuntimeClass { Unknown, Constant, Linear, Iterative };
+
+  RuntimeClass runtimeClass;
+
+  /** The peak memory in bytes that the component allocates while it updates, including its output, 0 if unknown */
+  std::size_t peakMemorySize;
+
+  static std::string ToString( RuntimeClass runtimeClass );
+
+  /** The memory in bytes of a multi-resolution pyramid of numberOfLevels levels of an image of numberOfPixels pixels
+   * of pixelSize bytes each, in which every coarser level is downsampled by a factor of 2 in each of its dimensions */
+  static std::size_t GetPyramidMemorySize( std::size_t numberOfPixels, std::size_t pixelSize, unsigned int dimension,
+    unsigned int numberOfLevels );
+};
+
+/** \class NetworkPlanReport
+ * \brief The resource estimates of the components of a realized network and of the network as a whole, by which
+ * a job scheduler can decide where to execute the network before it runs.
+ */
+struct NetworkPlanReport
+{
+  struct ComponentPlanType
+  {
+    std::string      name;
+    ResourceEstimate estimate;
+    // The step in the update order at which the component runs, numberOfUpdates if only after the network is executed
+    std::size_t update;
+  };
+
+  // In the order in which the components run
+  std::vector< ComponentPlanType > components;
+  std::size_t                      numberOfUpdates;
+
+  // The peak memory in bytes when the updates run one by one, with and without releasing intermediate data early
+  std::size_t peakMemorySize;
+  std::size_t peakMemorySizeWithoutRelease;
+
+  // The largest runtime class of the components, Unknown if none of them reports one
+  ResourceEstimate::RuntimeClass runtimeClass;
+
+  // The largest number of updates that can run side by side and the number of threads among which they are divided
+  unsigned int maximumConcurrency;
+  unsigned int numberOfThreads;
+};
+} // end namespace selx
+
+#endif // selxResourceEstimate_h
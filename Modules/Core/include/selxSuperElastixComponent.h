@@ -46,7 +46,7 @@ public:
 
   SuperElastixComponent(const std::string & name, LoggerImpl & logger) : AcceptingInterfaces(logger), ComponentBase(name, logger) {}
 
-  virtual int AcceptConnectionFrom( ComponentBase::Pointer other, const InterfaceCriteriaType interfaceCriteria ) override;
+  virtual int AcceptConnectionFrom( ComponentBase::Pointer other, const InterfaceCriteriaType & interfaceCriteria ) override;
 
   virtual int AcceptConnectionFrom( ComponentBase::Pointer ) override;
 
@@ -55,19 +55,28 @@ public:
   // GetComponentName get the name from ComponentBase, but is implemented here so that any interface can add a GetComponentName method without the need to implement that in each component individually.
   virtual const typename std::string GetComponentName();
 
+  // Implements UpdateInterface::SetNumberOfThreads for all components that provide the UpdateInterface. A NumberOfThreads criterion
+  // in the blueprint overrides numberOfThreads. Components pass m_NumberOfThreads to the threading of their backend in Update().
+  virtual void SetNumberOfThreads( unsigned int numberOfThreads );
+
+  // Generated once per component type from ProvidingInterfaces
+  virtual const ProvidedInterfaceTable & GetProvidedInterfaceTable() const override;
+
 protected:
 
-  virtual InterfaceStatus CanAcceptConnectionFrom( ComponentBase::ConstPointer, const InterfaceCriteriaType interfaceCriteria ) override;
+  virtual InterfaceStatus CanAcceptConnectionFrom( ComponentBase::ConstPointer, const InterfaceCriteriaType & interfaceCriteria ) override;
 
-  virtual unsigned int CountAcceptingInterfaces( const ComponentBase::InterfaceCriteriaType interfaceCriteria ) override
+  // The interface criteria are interned once and then matched against the interned properties of all interfaces. The
+  // properties of an interface are interned at its first use, possibly after the criteria, hence Intern() instead of Find().
+  virtual unsigned int CountAcceptingInterfaces( const ComponentBase::InterfaceCriteriaType & interfaceCriteria ) override
   {
-    return AcceptingInterfaces::CountMeetsCriteria( interfaceCriteria );
+    return AcceptingInterfaces::CountMeetsCriteria( InternedProperties::Intern( interfaceCriteria ) );
   }
 
 
-  virtual unsigned int CountProvidingInterfaces( const ComponentBase::InterfaceCriteriaType interfaceCriteria ) override
+  virtual unsigned int CountProvidingInterfaces( const ComponentBase::InterfaceCriteriaType & interfaceCriteria ) override
   {
-    return ProvidingInterfaces::CountMeetsCriteria( interfaceCriteria );
+    return ProvidingInterfaces::CountMeetsCriteria( InternedProperties::Intern( interfaceCriteria ) );
   }
 };
 } // end namespace selx
@@ -26,9 +26,9 @@ namespace selx
 template< typename AcceptingInterfaces, typename ProvidingInterfaces >
 int
 SuperElastixComponent< AcceptingInterfaces, ProvidingInterfaces >::AcceptConnectionFrom( ComponentBase::Pointer other,
-  const InterfaceCriteriaType interfaceCriteria )
+  const InterfaceCriteriaType & interfaceCriteria )
 {
-  return AcceptingInterfaces::ConnectFromImpl( other, interfaceCriteria );
+  return AcceptingInterfaces::ConnectFromImpl( other, InternedProperties::Intern( interfaceCriteria ), this->m_Name );
 }
 
 
@@ -36,16 +36,16 @@ template< typename AcceptingInterfaces, typename ProvidingInterfaces >
 int
 SuperElastixComponent< AcceptingInterfaces, ProvidingInterfaces >::AcceptConnectionFrom( ComponentBase::Pointer other )
 {
-  return AcceptingInterfaces::ConnectFromImpl( other );
+  return AcceptingInterfaces::ConnectFromImpl( other, this->m_Name );
 }
 
 
 template< typename AcceptingInterfaces, typename ProvidingInterfaces >
 InterfaceStatus
 SuperElastixComponent< AcceptingInterfaces, ProvidingInterfaces >
-::CanAcceptConnectionFrom( ComponentBase::ConstPointer other, const InterfaceCriteriaType interfaceCriteria )
+::CanAcceptConnectionFrom( ComponentBase::ConstPointer other, const InterfaceCriteriaType & interfaceCriteria )
 {
-  return AcceptingInterfaces::CanAcceptConnectionFrom( other, interfaceCriteria );
+  return AcceptingInterfaces::CanAcceptConnectionFrom( other, InternedProperties::Intern( interfaceCriteria ) );
 }
 
 
@@ -66,6 +66,26 @@ SuperElastixComponent< AcceptingInterfaces, ProvidingInterfaces >
 	return this->m_Name;
 }
 
+
+template< typename AcceptingInterfaces, typename ProvidingInterfaces >
+void
+SuperElastixComponent< AcceptingInterfaces, ProvidingInterfaces >
+::SetNumberOfThreads( unsigned int numberOfThreads )
+{
+  this->m_NumberOfThreads = this->m_NumberOfThreadsCriterion > 0 ? this->m_NumberOfThreadsCriterion : numberOfThreads;
+}
+
+
+template< typename AcceptingInterfaces, typename ProvidingInterfaces >
+const ProvidedInterfaceTable &
+SuperElastixComponent< AcceptingInterfaces, ProvidingInterfaces >
+::GetProvidedInterfaceTable() const
+{
+  // Components derived from this class provide the same interfaces, hence casting to this class suffices
+  static const ProvidedInterfaceTable table = ProvidedInterfaceTable::New< SuperElastixComponent, ProvidingInterfaces >();
+  return table;
+}
+
 } // end namespace selx
 
 
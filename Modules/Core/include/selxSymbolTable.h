@@ -0,0 +1,98 @@
+/*=========================================================================
+ *
+ *  Copyright Leiden University Medical Center, Erasmus University Medical
+ *  Center and contributors
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+
+#ifndef selxSymbolTable_h
+#define selxSymbolTable_h
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace selx
+{
+/** \class SymbolTable
+ * \brief Process wide table of interned strings.
+ *
+ * The keys and values of criteria and interface properties are compared many times during component selection and
+ * handshakes. Interning maps each distinct string once to a small integer symbol, after which these comparisons are
+ * integer comparisons. Symbols are never removed. All functions are thread safe.
+ */
+class SymbolTable
+{
+public:
+
+  typedef unsigned int SymbolType;
+
+  /** The symbol of strings that were never interned, which differs from the symbol of any interned string */
+  static const SymbolType UnknownSymbol = 0;
+
+  /** The symbol of string, which is added to the table if it was not interned before */
+  static SymbolType Intern( const std::string & string );
+
+  /** The symbol of string if it was interned before, UnknownSymbol otherwise. Does not grow the table, such that
+   * arbitrary user input can be looked up. */
+  static SymbolType Find( const std::string & string );
+
+  static const std::string & GetString( SymbolType symbol );
+};
+
+/** \class InternedProperties
+ * \brief Small flat map of interned keys to interned values, sorted by key.
+ *
+ * Used for both the properties of interfaces and the interface criteria of connections.
+ */
+class InternedProperties
+{
+public:
+
+  typedef SymbolTable::SymbolType              SymbolType;
+  typedef std::pair< SymbolType, SymbolType >  PropertyType;
+  typedef std::map< std::string, std::string > StringPropertiesType;
+
+  /** Intern all keys and values of properties */
+  static InternedProperties Intern( const StringPropertiesType & properties );
+
+  /** Look up the keys and values of criteria without interning them. Criteria with a string that was never interned
+   * cannot be met by any interned properties. */
+  static InternedProperties Find( const StringPropertiesType & criteria );
+
+  /** True if all criteria are properties with an identical value */
+  bool MeetsCriteria( const InternedProperties & criteria ) const;
+
+  /** The value of key, or UnknownSymbol if key is not a property */
+  SymbolType Get( SymbolType key ) const;
+
+  bool empty() const { return this->m_Properties.empty(); }
+
+  std::size_t size() const { return this->m_Properties.size(); }
+
+  StringPropertiesType ToStrings() const;
+
+private:
+
+  // Only created by Intern() and Find(), which keeps {} unambiguous for functions overloaded on string properties
+  InternedProperties( const StringPropertiesType & properties, SymbolType ( * toSymbol )( const std::string & ) );
+
+  std::vector< PropertyType > m_Properties;
+};
+} // end namespace selx
+
+#endif // selxSymbolTable_h
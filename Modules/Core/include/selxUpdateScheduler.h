@@ -0,0 +1,75 @@
+/*=========================================================================
+ *
+ *  Copyright Leiden University Medical Center, Erasmus University Medical
+ *  Center and contributors
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#ifndef selxUpdateScheduler_h
+#define selxUpdateScheduler_h
+
+#include "selxInterfaces.h"
+#include "selxCancellationToken.h"
+
+#include <vector>
+#include <memory>
+#include <functional>
+
+namespace selx
+{
+/** \class UpdateScheduler
+ * \brief Runs the Update() of the components of a network concurrently, respecting the connections of the blueprint.
+ *
+ * The updates form a directed acyclic graph: each update is given the indices of the updates it depends on,
+ * i.e. the updates of components upstream in the blueprint. Execute() runs them on a pool of worker threads that
+ * each have their own queue of updates that are ready to run. A worker takes the most recently readied update
+ * from its own queue and, when that is empty, steals the oldest update from the queue of another worker. An
+ * exception thrown by an update stops the scheduling of further updates and is rethrown by Execute(). Likewise, no
+ * further updates are started once the cancellation token, if any, is cancelled.
+ */
+class UpdateScheduler
+{
+public:
+
+  using UpdateOrderType            = std::vector< std::shared_ptr< UpdateInterface >>;
+  using DependenciesType           = std::vector< std::vector< std::size_t >>;
+  using UpdateFinishedCallbackType = std::function< void ( std::size_t ) >;
+
+  /** updateOrder must be a topological order of the dependencies */
+  UpdateScheduler( const UpdateOrderType & updateOrder, const DependenciesType & dependencies );
+
+  /** Run all updates on numberOfWorkers threads. With 1 worker the updates run in updateOrder on the calling thread.
+   * updateFinished, if given, is called with the index of each update that finished, by the thread that ran it.
+   * Updates for which isCompleted is true, e.g. restored from a checkpoint, are not run, but do count as finished. */
+  void Execute( unsigned int numberOfWorkers, const UpdateFinishedCallbackType & updateFinished = nullptr,
+    const std::vector< bool > & isCompleted = {} );
+
+  /** Stop Execute() before the next update when cancellationToken is cancelled, by a CancellationToken::CancelledError */
+  void SetCancellationToken( CancellationToken::Pointer cancellationToken );
+
+  /** The largest number of updates that can run side by side, i.e. the number of workers beyond which Execute does not speed up */
+  unsigned int GetMaximumConcurrency() const;
+
+private:
+
+  const UpdateOrderType      m_UpdateOrder;
+  DependenciesType           m_Successors;
+  std::vector< std::size_t > m_NumberOfDependencies;
+  unsigned int               m_MaximumConcurrency;
+  CancellationToken::Pointer m_CancellationToken;
+};
+} // end namespace selx
+
+#endif // selxUpdateScheduler_h
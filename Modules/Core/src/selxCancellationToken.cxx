@@ -0,0 +1,76 @@
+/*=========================================================================
+ *
+ *  Copyright Leiden University Medical Center, Erasmus University Medical
+ *  Center and contributors
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+
+#include "selxCancellationToken.h"
+
+#include <limits>
+
+namespace selx
+{
+CancellationToken::CancellationToken() :
+  m_IsCancelled( false ),
+  m_Deadline( std::numeric_limits< ClockType::rep >::max() )
+{
+}
+
+
+void
+CancellationToken::Cancel()
+{
+  this->m_IsCancelled = true;
+}
+
+
+void
+CancellationToken::CancelAfter( ClockType::duration timeout )
+{
+  this->m_Deadline = ( ClockType::now() + timeout ).time_since_epoch().count();
+}
+
+
+void
+CancellationToken::Reset()
+{
+  this->m_IsCancelled = false;
+  this->m_Deadline    = std::numeric_limits< ClockType::rep >::max();
+}
+
+
+bool
+CancellationToken::IsCancelled() const
+{
+  if( this->m_IsCancelled.load( std::memory_order_relaxed ) )
+  {
+    return true;
+  }
+  const ClockType::rep deadline = this->m_Deadline.load( std::memory_order_relaxed );
+  return deadline != std::numeric_limits< ClockType::rep >::max() && ClockType::now().time_since_epoch().count() >= deadline;
+}
+
+
+void
+CancellationToken::ThrowIfCancelled() const
+{
+  if( this->IsCancelled() )
+  {
+    throw CancelledError();
+  }
+}
+} // end namespace selx
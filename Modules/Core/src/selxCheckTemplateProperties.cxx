@@ -32,8 +32,8 @@
 namespace selx
 {
 CriterionStatus
-CheckTemplateProperties( const std::map< std::string, std::string > templateProperties,
-  const std::pair< std::string, std::vector< std::string >> criterion )
+CheckTemplateProperties( const std::map< std::string, std::string > & templateProperties,
+  const std::pair< std::string, std::vector< std::string >> & criterion )
 {
   if( templateProperties.count( criterion.first ) == 1 ) // e.g. is "Dimensionality" a template property? Or is NameOfClass queried?
   {
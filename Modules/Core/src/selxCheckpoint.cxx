@@ -0,0 +1,128 @@
+/*=========================================================================
+ *
+ *  Copyright Leiden University Medical Center, Erasmus University Medical
+ *  Center and contributors
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+
+#include "selxCheckpoint.h"
+
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+namespace selx
+{
+Checkpoint::Checkpoint( const std::string & directory, const std::string & key ) :
+  m_Directory( directory ),
+  m_Hash( GetHash( key ) )
+{
+  boost::filesystem::create_directories( this->m_Directory );
+
+  std::ifstream manifest( this->GetManifestFileName() );
+  std::string   line;
+  if( manifest && std::getline( manifest, line ) && line == this->m_Hash )
+  {
+    while( std::getline( manifest, line ) )
+    {
+      // A line that was cut off by an interruption is not followed by a newline and is ignored
+      if( !manifest.eof() && !line.empty() )
+      {
+        this->m_CompletedComponentNames.insert( line );
+      }
+    }
+  }
+  else
+  {
+    manifest.close();
+    this->Reset();
+  }
+}
+
+
+std::set< std::string >
+Checkpoint::GetCompletedComponentNames() const
+{
+  std::lock_guard< std::mutex > lock( this->m_Mutex );
+  return this->m_CompletedComponentNames;
+}
+
+
+std::string
+Checkpoint::GetComponentDirectory( const std::string & componentName ) const
+{
+  const boost::filesystem::path componentDirectory = boost::filesystem::path( this->m_Directory ) / componentName;
+  boost::filesystem::create_directories( componentDirectory );
+  return componentDirectory.string();
+}
+
+
+void
+Checkpoint::Completed( const std::string & componentName )
+{
+  std::lock_guard< std::mutex > lock( this->m_Mutex );
+  if( !this->m_CompletedComponentNames.insert( componentName ).second )
+  {
+    return;
+  }
+  std::ofstream manifest( this->GetManifestFileName(), std::ios::app );
+  manifest << componentName << '\n' << std::flush;
+  if( !manifest )
+  {
+    throw std::runtime_error( "Writing checkpoint manifest " + this->GetManifestFileName() + " failed." );
+  }
+}
+
+
+void
+Checkpoint::Reset()
+{
+  std::lock_guard< std::mutex > lock( this->m_Mutex );
+  this->m_CompletedComponentNames.clear();
+  std::ofstream manifest( this->GetManifestFileName(), std::ios::trunc );
+  manifest << this->m_Hash << '\n' << std::flush;
+  if( !manifest )
+  {
+    throw std::runtime_error( "Writing checkpoint manifest " + this->GetManifestFileName() + " failed." );
+  }
+}
+
+
+std::string
+Checkpoint::GetHash( const std::string & string )
+{
+  // 64 bit FNV-1a
+  std::uint64_t hash = 14695981039346656037ull;
+  for( const unsigned char character : string )
+  {
+    hash ^= character;
+    hash *= 1099511628211ull;
+  }
+  std::ostringstream hexadecimal;
+  hexadecimal << std::hex << std::setw( 16 ) << std::setfill( '0' ) << hash;
+  return hexadecimal.str();
+}
+
+
+std::string
+Checkpoint::GetManifestFileName() const
+{
+  return ( boost::filesystem::path( this->m_Directory ) / "checkpoint.txt" ).string();
+}
+} // end namespace selx
@@ -0,0 +1,202 @@
+/*=========================================================================
+ *
+ *  Copyright Leiden University Medical Center, Erasmus University Medical
+ *  Center and contributors
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "selxComponentAssignmentCache.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <iomanip>
+#include <numeric>
+#include <sstream>
+#include <tuple>
+
+namespace selx
+{
+const std::size_t ComponentAssignmentCache::DefaultCapacity;
+
+namespace
+{
+// 64 bit FNV-1a digest of a serialization of the blueprint, which is fed to it string by string
+class KeyDigest
+{
+public:
+
+  KeyDigest() : m_Hash( 14695981039346656037ull ) {}
+
+  // Length prefixed, such that the concatenation of the strings is unambiguous
+  void Append( const std::string & value )
+  {
+    this->AppendBytes( std::to_string( value.size() ) );
+    this->AppendBytes( ":" );
+    this->AppendBytes( value );
+  }
+
+  void Append( const BlueprintImpl::ParameterMapType & parameterMap )
+  {
+    this->Append( std::to_string( parameterMap.size() ) );
+    for( const auto & parameter : parameterMap )
+    {
+      this->Append( parameter.first );
+      this->Append( std::to_string( parameter.second.size() ) );
+      for( const auto & value : parameter.second )
+      {
+        this->Append( value );
+      }
+    }
+  }
+
+  ComponentAssignmentCache::KeyType GetKey() const
+  {
+    std::ostringstream hexadecimal;
+    hexadecimal << std::hex << std::setw( 16 ) << std::setfill( '0' ) << this->m_Hash;
+    return hexadecimal.str();
+  }
+
+private:
+
+  void AppendBytes( const std::string & bytes )
+  {
+    for( const unsigned char character : bytes )
+    {
+      this->m_Hash ^= character;
+      this->m_Hash *= 1099511628211ull;
+    }
+  }
+
+  std::uint64_t m_Hash;
+};
+} // end anonymous namespace
+
+
+ComponentAssignmentCache::KeyType
+ComponentAssignmentCache::GetKey( const BlueprintImpl & blueprint )
+{
+  KeyDigest key;
+
+  // The components by name and the connections by the names of their ends and their own name, such that the key does
+  // not depend on the order in which they were added
+  std::vector< BlueprintImpl::ComponentIndexType > components( blueprint.GetNumberOfComponents() );
+  std::iota( components.begin(), components.end(), 0 );
+  std::sort( components.begin(), components.end(), [ &blueprint ]( BlueprintImpl::ComponentIndexType first, BlueprintImpl::ComponentIndexType second ) {
+      return blueprint.GetComponentProperty( first ).name < blueprint.GetComponentProperty( second ).name;
+    } );
+  key.Append( std::to_string( components.size() ) );
+  for( const auto & component : components )
+  {
+    key.Append( blueprint.GetComponentProperty( component ).name );
+    key.Append( *blueprint.GetComponentProperty( component ).parameterMap );
+  }
+
+  std::vector< BlueprintImpl::ConnectionIndexType > connections( blueprint.GetNumberOfConnections() );
+  std::iota( connections.begin(), connections.end(), 0 );
+  auto connectionNames = [ &blueprint ]( BlueprintImpl::ConnectionIndexType index ) {
+      const BlueprintImpl::ConnectionPropertyType & connection = blueprint.GetConnectionProperty( index );
+      return std::tie( blueprint.GetComponentProperty( connection.upstream ).name, blueprint.GetComponentProperty( connection.downstream ).name,
+        connection.name );
+    };
+  std::sort( connections.begin(), connections.end(), [ &connectionNames ]( BlueprintImpl::ConnectionIndexType first, BlueprintImpl::ConnectionIndexType second ) {
+      return connectionNames( first ) < connectionNames( second );
+    } );
+  for( const auto & connection : connections )
+  {
+    key.Append( std::get< 0 >( connectionNames( connection ) ) );
+    key.Append( std::get< 1 >( connectionNames( connection ) ) );
+    key.Append( std::get< 2 >( connectionNames( connection ) ) );
+    key.Append( *blueprint.GetConnectionProperty( connection ).parameterMap );
+  }
+  return key.GetKey();
+}
+
+
+bool
+ComponentAssignmentCache::Find( const KeyType & key, ComponentAssignmentType & componentAssignment )
+{
+  std::lock_guard< std::mutex > lock( this->m_Mutex );
+  auto                          cached = this->m_Cache.find( key );
+  if( cached == this->m_Cache.end() )
+  {
+    return false;
+  }
+  this->m_Entries.splice( this->m_Entries.begin(), this->m_Entries, cached->second );
+  componentAssignment = cached->second->second;
+  return true;
+}
+
+
+void
+ComponentAssignmentCache::Insert( const KeyType & key, const ComponentAssignmentType & componentAssignment )
+{
+  std::lock_guard< std::mutex > lock( this->m_Mutex );
+  auto                          cached = this->m_Cache.find( key );
+  if( cached != this->m_Cache.end() )
+  {
+    cached->second->second = componentAssignment;
+    this->m_Entries.splice( this->m_Entries.begin(), this->m_Entries, cached->second );
+    return;
+  }
+  this->m_Entries.emplace_front( key, componentAssignment );
+  this->m_Cache[ key ] = this->m_Entries.begin();
+  this->Evict();
+}
+
+
+void
+ComponentAssignmentCache::Clear()
+{
+  std::lock_guard< std::mutex > lock( this->m_Mutex );
+  this->m_Cache.clear();
+  this->m_Entries.clear();
+}
+
+
+std::size_t
+ComponentAssignmentCache::Size() const
+{
+  std::lock_guard< std::mutex > lock( this->m_Mutex );
+  return this->m_Cache.size();
+}
+
+
+void
+ComponentAssignmentCache::SetCapacity( std::size_t capacity )
+{
+  std::lock_guard< std::mutex > lock( this->m_Mutex );
+  this->m_Capacity = capacity;
+  this->Evict();
+}
+
+
+std::size_t
+ComponentAssignmentCache::GetCapacity() const
+{
+  std::lock_guard< std::mutex > lock( this->m_Mutex );
+  return this->m_Capacity;
+}
+
+
+void
+ComponentAssignmentCache::Evict()
+{
+  while( this->m_Entries.size() > this->m_Capacity )
+  {
+    this->m_Cache.erase( this->m_Entries.back().first );
+    this->m_Entries.pop_back();
+  }
+}
+} // end namespace selx
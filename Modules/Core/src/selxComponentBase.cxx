@@ -22,11 +22,19 @@
 namespace selx
 {
 // TODO delete this constructor
-ComponentBase::ComponentBase() : m_Name( "undefined" ), m_Logger( *( new LoggerImpl() ) )
+ComponentBase::ComponentBase() : m_Name( "undefined" ), m_Logger( *( new LoggerImpl() ) ), m_NumberOfThreads( 0 ), m_NumberOfThreadsCriterion( 0 ),
+  m_DerivedDataCache( std::make_shared< DerivedDataCache >() ),
+  m_CancellationToken( std::make_shared< CancellationToken >() ),
+  m_RandomSeed( 0 ),
+  m_IsDeterministic( false )
 {
 }
 
-ComponentBase::ComponentBase(const std::string & name, LoggerImpl & logger) : m_Logger(logger), m_Name( name )
+ComponentBase::ComponentBase(const std::string & name, LoggerImpl & logger) : m_Logger(logger), m_Name( name ), m_NumberOfThreads( 0 ), m_NumberOfThreadsCriterion( 0 ),
+  m_DerivedDataCache( std::make_shared< DerivedDataCache >() ),
+  m_CancellationToken( std::make_shared< CancellationToken >() ),
+  m_RandomSeed( 0 ),
+  m_IsDeterministic( false )
 {
 }
 
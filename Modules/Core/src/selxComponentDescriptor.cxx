@@ -0,0 +1,228 @@
+/*=========================================================================
+ *
+ *  Copyright Leiden University Medical Center, Erasmus University Medical
+ *  Center and contributors
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "selxComponentDescriptor.h"
+#include "selxKeys.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace selx
+{
+ComponentDescriptor::ComponentDescriptor( const PropertiesType & templateProperties,
+  const InterfaceDescriptorsType & acceptingInterfaces,
+  const InterfaceDescriptorsType & providingInterfaces,
+  FactoryFunctionType factory ) :
+  m_TemplateProperties( templateProperties ),
+  m_InternedTemplateProperties( InternedProperties::Intern( templateProperties ) ),
+  m_AcceptingInterfaces( acceptingInterfaces ),
+  m_ProvidingInterfaces( providingInterfaces ),
+  m_Factory( factory ),
+  m_EstimatedCost( 1.0 )
+{
+  static const std::map< std::string, double > valueTypeSizes = {
+    { "bool", 1 }, { "char", 1 }, { "unsigned char", 1 }, { "short", 2 }, { "unsigned short", 2 },
+    { "int", 4 }, { "unsigned int", 4 }, { "float", 4 }, { "double", 8 } };
+
+  double valueTypeSize = 1.0;
+  for( const auto & key : { keys::PixelType, keys::InternalComputationValueType, keys::CoordRepType } )
+  {
+    auto valueType = templateProperties.find( key );
+    if( valueType != templateProperties.end() && valueTypeSizes.count( valueType->second ) == 1 )
+    {
+      valueTypeSize = std::max( valueTypeSize, valueTypeSizes.at( valueType->second ) );
+    }
+  }
+
+  double dimensionality = 1.0;
+  auto   dimensionalityProperty = templateProperties.find( keys::Dimensionality );
+  if( dimensionalityProperty != templateProperties.end()
+    && !dimensionalityProperty->second.empty() && dimensionalityProperty->second.size() < 3
+    && dimensionalityProperty->second.find_first_not_of( "0123456789" ) == std::string::npos )
+  {
+    dimensionality = std::max( 1.0, std::stod( dimensionalityProperty->second ) );
+  }
+
+  this->m_EstimatedCost = valueTypeSize * dimensionality;
+}
+
+
+CriterionStatus
+ComponentDescriptor::CheckCriterion( const CriterionType & criterion ) const
+{
+  return this->CheckCriterion( InternCriterion( criterion ) );
+}
+
+
+ComponentDescriptor::InternedCriterionType
+ComponentDescriptor::InternCriterion( const CriterionType & criterion )
+{
+  InternedCriterionType internedCriterion = { SymbolTable::Find( criterion.first ), {}, false, CriterionStatus::Unknown };
+  // NumberOfThreads is handled by SuperElastixComponent for all component types
+  if( criterion.first == keys::NumberOfThreads )
+  {
+    internedCriterion.isDecided = true;
+    internedCriterion.status    = IsValidNumberOfThreads( criterion.second ) ? CriterionStatus::Satisfied : CriterionStatus::Failed;
+    return internedCriterion;
+  }
+  // SelectionPolicy is handled by the NetworkBuilder
+  if( criterion.first == keys::SelectionPolicy )
+  {
+    internedCriterion.isDecided = true;
+    internedCriterion.status    = IsValidSelectionPolicy( criterion.second ) ? CriterionStatus::Satisfied : CriterionStatus::Failed;
+    return internedCriterion;
+  }
+  for( const auto & value : criterion.second )
+  {
+    internedCriterion.values.push_back( SymbolTable::Find( value ) );
+  }
+  return internedCriterion;
+}
+
+
+CriterionStatus
+ComponentDescriptor::CheckCriterion( const InternedCriterionType & criterion ) const
+{
+  // Same logic as CheckTemplateProperties
+  if( criterion.isDecided )
+  {
+    return criterion.status;
+  }
+  const SymbolType templateProperty = this->m_InternedTemplateProperties.Get( criterion.key );
+  if( templateProperty == SymbolTable::UnknownSymbol )
+  {
+    // Not a template property, e.g. a parameter that only an instantiated component can check
+    return CriterionStatus::Unknown;
+  }
+  if( criterion.values.size() != 1 )
+  {
+    throw std::runtime_error( "The criterion " + SymbolTable::GetString( criterion.key ) + " may have only 1 value" );
+  }
+  // Values that were never interned cannot equal any template property
+  return criterion.values[ 0 ] == templateProperty ? CriterionStatus::Satisfied : CriterionStatus::Failed;
+}
+
+
+bool
+ComponentDescriptor::IsValidNumberOfThreads( const CriterionType::second_type & value )
+{
+  return value.size() == 1 && !value[ 0 ].empty() && value[ 0 ].size() < 10
+         && value[ 0 ].find_first_not_of( "0123456789" ) == std::string::npos && std::stoul( value[ 0 ] ) > 0;
+}
+
+
+bool
+ComponentDescriptor::IsValidSelectionPolicy( const CriterionType::second_type & value )
+{
+  return value.size() == 1 && ( value[ 0 ] == keys::Unique || value[ 0 ] == keys::LowestCost );
+}
+
+
+unsigned int
+ComponentDescriptor::CountAcceptingInterfaces( const InterfaceCriteriaType & interfaceCriteria ) const
+{
+  return this->CountAcceptingInterfaces( InternedProperties::Find( interfaceCriteria ) );
+}
+
+
+unsigned int
+ComponentDescriptor::CountAcceptingInterfaces( const InternedProperties & interfaceCriteria ) const
+{
+  // Same logic as Count< Interfaces ... >::MeetsCriteria
+  unsigned int count = 0;
+  for( const auto & acceptingInterface : this->m_AcceptingInterfaces )
+  {
+    count += acceptingInterface.properties.MeetsCriteria( interfaceCriteria );
+  }
+  return count;
+}
+
+
+unsigned int
+ComponentDescriptor::CountProvidingInterfaces( const InterfaceCriteriaType & interfaceCriteria ) const
+{
+  return this->CountProvidingInterfaces( InternedProperties::Find( interfaceCriteria ) );
+}
+
+
+unsigned int
+ComponentDescriptor::CountProvidingInterfaces( const InternedProperties & interfaceCriteria ) const
+{
+  unsigned int count = 0;
+  for( const auto & providingInterface : this->m_ProvidingInterfaces )
+  {
+    count += providingInterface.properties.MeetsCriteria( interfaceCriteria );
+  }
+  return count;
+}
+
+
+InterfaceStatus
+ComponentDescriptor::CanAcceptConnectionFrom( const ComponentDescriptor & provider, const InterfaceCriteriaType & interfaceCriteria ) const
+{
+  return this->CanAcceptConnectionFrom( provider, InternedProperties::Find( interfaceCriteria ) );
+}
+
+
+InterfaceStatus
+ComponentDescriptor::CanAcceptConnectionFrom( const ComponentDescriptor & provider, const InternedProperties & interfaceCriteria ) const
+{
+  // Mirrors Accepting< Interfaces ... >::CanAcceptConnectionFrom. A provider component can be cast to an interface
+  // if and only if that interface is in its Providing< Interfaces ... > list, hence comparing interface types suffices.
+  InterfaceStatus status = InterfaceStatus::noaccepter;
+  for( const auto & acceptingInterface : this->m_AcceptingInterfaces )
+  {
+    if( !acceptingInterface.properties.MeetsCriteria( interfaceCriteria ) )
+    {
+      continue;
+    }
+
+    bool isProvided = false;
+    for( const auto & providingInterface : provider.m_ProvidingInterfaces )
+    {
+      if( providingInterface.interfaceType == acceptingInterface.interfaceType )
+      {
+        isProvided = true;
+        break;
+      }
+    }
+
+    if( isProvided )
+    {
+      if( status == InterfaceStatus::success )
+      {
+        return InterfaceStatus::multiple;
+      }
+      status = InterfaceStatus::success;
+    }
+    else if( status == InterfaceStatus::noaccepter )
+    {
+      status = InterfaceStatus::noprovider;
+    }
+  }
+  return status;
+}
+
+
+ComponentBase::Pointer
+ComponentDescriptor::New( const std::string & name, LoggerImpl & logger ) const
+{
+  return this->m_Factory( name, logger );
+}
+} // end namespace selx
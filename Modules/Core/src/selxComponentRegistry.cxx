@@ -0,0 +1,68 @@
+/*=========================================================================
+ *
+ *  Copyright Leiden University Medical Center, Erasmus University Medical
+ *  Center and contributors
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "selxComponentRegistry.h"
+
+#include <algorithm>
+
+namespace selx
+{
+ComponentRegistry &
+ComponentRegistry::GetDefault()
+{
+  static ComponentRegistry registry;
+  return registry;
+}
+
+
+void
+ComponentRegistry::Register( const ComponentDescriptor & descriptor )
+{
+  std::lock_guard< std::mutex > lock( this->m_Mutex );
+  if( std::find( this->m_Descriptors.begin(), this->m_Descriptors.end(), &descriptor ) != this->m_Descriptors.end() )
+  {
+    return;
+  }
+  this->m_Descriptors.push_back( &descriptor );
+
+  // The ids in the cached selections refer to the previous table
+  this->m_CompatibilityTable = nullptr;
+  this->m_ComponentAssignmentCache.Clear();
+}
+
+
+std::size_t
+ComponentRegistry::GetNumberOfComponents() const
+{
+  std::lock_guard< std::mutex > lock( this->m_Mutex );
+  return this->m_Descriptors.size();
+}
+
+
+ComponentRegistry::CompatibilityTablePointer
+ComponentRegistry::GetCompatibilityTable() const
+{
+  std::lock_guard< std::mutex > lock( this->m_Mutex );
+  if( !this->m_CompatibilityTable )
+  {
+    this->m_CompatibilityTable = std::make_shared< const InterfaceCompatibilityTable >( this->m_Descriptors );
+  }
+  return this->m_CompatibilityTable;
+}
+} // end namespace selx
@@ -0,0 +1,201 @@
+/*=========================================================================
+ *
+ *  Copyright Leiden University Medical Center, Erasmus University Medical
+ *  Center and contributors
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "selxComponentSelector.h"
+
+#include <algorithm>
+
+namespace selx
+{
+ComponentSelector::ComponentSelector( const std::string & name, LoggerImpl & logger, CompatibilityTablePointer compatibilityTable ) :
+  m_CompatibilityTable( compatibilityTable ), m_Name( name ), m_Logger( logger )
+{
+  // No components are constructed here, the candidates refer to the descriptors of all component types.
+  for( ComponentIdType id = 0; id < this->m_CompatibilityTable->GetNumberOfComponents(); ++id )
+  {
+    this->m_PossibleComponents.push_back( { id, &this->m_CompatibilityTable->GetDescriptor( id ), nullptr, 0 } );
+  }
+}
+
+
+void
+ComponentSelector::AddCriterion( const CriterionType & criterion )
+{
+  // The criterion is interned once for all candidates
+  const ComponentDescriptor::InternedCriterionType internedCriterion = ComponentDescriptor::InternCriterion( criterion );
+  bool                                             isDeferred        = false;
+  this->m_PossibleComponents.remove_if([ & ]( const CandidateType & candidate ){
+      auto status = candidate.descriptor->CheckCriterion( internedCriterion );
+      if( status == CriterionStatus::Unknown )
+      {
+        isDeferred = true;
+      }
+      return status == CriterionStatus::Failed;
+    } );
+
+  if( isDeferred )
+  {
+    this->m_DeferredCriteria.push_back( criterion );
+  }
+}
+
+
+void
+ComponentSelector::UpdatePossibleComponents()
+{
+  const std::size_t numberOfDeferredCriteria = this->m_DeferredCriteria.size();
+  this->m_PossibleComponents.remove_if([ & ]( CandidateType & candidate ){
+      if( candidate.numberOfAppliedCriteria == numberOfDeferredCriteria )
+      {
+        return false;
+      }
+      if( !candidate.component )
+      {
+        candidate.component = candidate.descriptor->New( this->m_Name, this->m_Logger );
+      }
+      // Criteria are applied in the order they were added, since MeetsCriterion may configure the component.
+      for( ; candidate.numberOfAppliedCriteria < numberOfDeferredCriteria; ++candidate.numberOfAppliedCriteria )
+      {
+        if( !candidate.component->MeetsCriterion( this->m_DeferredCriteria[ candidate.numberOfAppliedCriteria ] ) )
+        {
+          return true;
+        }
+      }
+      return false;
+    } );
+}
+
+
+void
+ComponentSelector::AddAcceptingInterfaceCriteria( const InterfaceCriteriaType & interfaceCriteria )
+{
+  const InternedProperties internedCriteria = InternedProperties::Find( interfaceCriteria );
+  this->m_PossibleComponents.remove_if([ & ]( const CandidateType & candidate ){
+      return 0 == candidate.descriptor->CountAcceptingInterfaces( internedCriteria );
+    } );
+}
+
+
+void
+ComponentSelector::AddProvidingInterfaceCriteria( const InterfaceCriteriaType & interfaceCriteria )
+{
+  const InternedProperties internedCriteria = InternedProperties::Find( interfaceCriteria );
+  this->m_PossibleComponents.remove_if([ & ]( const CandidateType & candidate ){
+      return 0 == candidate.descriptor->CountProvidingInterfaces( internedCriteria );
+    } );
+}
+
+
+void
+ComponentSelector::RestrictToComponentIds( const ComponentIdsType & componentIds )
+{
+  this->m_PossibleComponents.remove_if([ & ]( const CandidateType & candidate ){
+      return std::find( componentIds.begin(), componentIds.end(), candidate.id ) == componentIds.end();
+    } );
+}
+
+
+ComponentSelector::ComponentIdsType
+ComponentSelector::GetComponentIds()
+{
+  this->UpdatePossibleComponents();
+  return this->GetCandidateIds();
+}
+
+
+ComponentSelector::ComponentIdsType
+ComponentSelector::GetCandidateIds() const
+{
+  ComponentIdsType componentIds;
+  for( const auto & candidate : this->m_PossibleComponents )
+  {
+    componentIds.push_back( candidate.id );
+  }
+  return componentIds;
+}
+
+
+ComponentSelector::ComponentBasePointer
+ComponentSelector::GetComponent()
+{
+  this->UpdatePossibleComponents();
+
+  if( this->m_PossibleComponents.size() == 1 )
+  {
+    auto & candidate = *( this->m_PossibleComponents.begin() );
+    if( !candidate.component )
+    {
+      candidate.component = candidate.descriptor->New( this->m_Name, this->m_Logger );
+    }
+    return candidate.component;
+  }
+  else
+  {
+    return ITK_NULLPTR;
+  }
+}
+
+
+const ComponentDescriptor *
+ComponentSelector::GetComponentDescriptor()
+{
+  this->UpdatePossibleComponents();
+
+  if( this->m_PossibleComponents.size() == 1 )
+  {
+    return this->m_PossibleComponents.begin()->descriptor;
+  }
+  else
+  {
+    return ITK_NULLPTR;
+  }
+}
+
+
+unsigned int
+ComponentSelector::NumberOfComponents()
+{
+  this->UpdatePossibleComponents();
+  return this->m_PossibleComponents.size();
+}
+
+
+unsigned int
+ComponentSelector::NumberOfCandidates() const
+{
+  return this->m_PossibleComponents.size();
+}
+
+
+void
+ComponentSelector::PrintComponents( void )
+{
+  /*
+  for (auto & component : this->m_PossibleComponents)
+  {
+    auto const & properties = component->TemplateProperties();
+    for (auto const & keyvalue : properties)
+    {
+      std::cout << "{ """ << keyvalue.first << """: """ << keyvalue.second << """}" << std::endl;
+    }
+    std::cout << std::endl;
+  }
+  */
+}
+} // end namespace selx
+
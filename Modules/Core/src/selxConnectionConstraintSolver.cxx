@@ -0,0 +1,305 @@
+/*=========================================================================
+ *
+ *  Copyright Leiden University Medical Center, Erasmus University Medical
+ *  Center and contributors
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "selxConnectionConstraintSolver.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace selx
+{
+ConnectionConstraintSolver::ConnectionConstraintSolver( const InterfaceCompatibilityTable & compatibilityTable ) :
+  m_CompatibilityTable( compatibilityTable ),
+  m_ConflictingNode( 0 ),
+  m_ConflictingConnection( 0 ),
+  m_LowestCost( 0 )
+{
+}
+
+
+ConnectionConstraintSolver::NodeIdType
+ConnectionConstraintSolver::AddNode( const ComponentIdsType & componentIds )
+{
+  DomainType domain( this->m_CompatibilityTable.GetNumberOfComponents(), false );
+  for( const auto & componentId : componentIds )
+  {
+    domain[ componentId ] = true;
+  }
+  this->m_Domains.push_back( domain );
+  this->m_ConnectionsOfNode.emplace_back();
+  return this->m_Domains.size() - 1;
+}
+
+
+ConnectionConstraintSolver::ConnectionIdType
+ConnectionConstraintSolver::AddConnection( NodeIdType providingNode, NodeIdType acceptingNode, const InterfaceCriteriaType & interfaceCriteria )
+{
+  const ConnectionIdType   connection       = this->m_Connections.size();
+  const InternedProperties internedCriteria = InternedProperties::Find( interfaceCriteria );
+  this->m_Connections.push_back( { providingNode, acceptingNode, internedCriteria,
+                                   this->m_CompatibilityTable.GetAcceptingInterfaceMask( internedCriteria ) } );
+  this->m_ConnectionsOfNode[ providingNode ].push_back( connection );
+  if( acceptingNode != providingNode )
+  {
+    this->m_ConnectionsOfNode[ acceptingNode ].push_back( connection );
+  }
+  return connection;
+}
+
+
+void
+ConnectionConstraintSolver::SetConflict( NodeIdType node, ConnectionIdType connection )
+{
+  this->m_ConflictingNode       = node;
+  this->m_ConflictingConnection = connection;
+}
+
+
+bool
+ConnectionConstraintSolver::ApplyNodeConsistency()
+{
+  // The criteria of a connection must be satisfied by at least one providing interface of the providing node
+  // and one accepting interface of the accepting node, independent of the component type at the other end.
+  for( ConnectionIdType connection = 0; connection < this->m_Connections.size(); ++connection )
+  {
+    const ConnectionType & currentConnection = this->m_Connections[ connection ];
+
+    DomainType & providingDomain = this->m_Domains[ currentConnection.providingNode ];
+    for( ComponentIdType componentId = 0; componentId < providingDomain.size(); ++componentId )
+    {
+      if( providingDomain[ componentId ]
+        && this->m_CompatibilityTable.GetDescriptor( componentId ).CountProvidingInterfaces( currentConnection.interfaceCriteria ) == 0 )
+      {
+        providingDomain[ componentId ] = false;
+      }
+    }
+    if( this->GetDomainSize( currentConnection.providingNode ) == 0 )
+    {
+      this->SetConflict( currentConnection.providingNode, connection );
+      return false;
+    }
+
+    DomainType & acceptingDomain = this->m_Domains[ currentConnection.acceptingNode ];
+    for( ComponentIdType componentId = 0; componentId < acceptingDomain.size(); ++componentId )
+    {
+      if( acceptingDomain[ componentId ]
+        && this->m_CompatibilityTable.GetDescriptor( componentId ).CountAcceptingInterfaces( currentConnection.interfaceCriteria ) == 0 )
+      {
+        acceptingDomain[ componentId ] = false;
+      }
+    }
+    if( this->GetDomainSize( currentConnection.acceptingNode ) == 0 )
+    {
+      this->SetConflict( currentConnection.acceptingNode, connection );
+      return false;
+    }
+  }
+  return true;
+}
+
+
+bool
+ConnectionConstraintSolver::Revise( const ArcType & arc )
+{
+  // Remove the component types from the revised domain that cannot be connected to any component type in the other domain.
+  const ConnectionType & connection = this->m_Connections[ arc.connection ];
+  DomainType &           revisedDomain = this->m_Domains[ arc.reviseProvidingNode ? connection.providingNode : connection.acceptingNode ];
+  const DomainType &     otherDomain = this->m_Domains[ arc.reviseProvidingNode ? connection.acceptingNode : connection.providingNode ];
+
+  bool isRevised = false;
+  for( ComponentIdType componentId = 0; componentId < revisedDomain.size(); ++componentId )
+  {
+    if( !revisedDomain[ componentId ] )
+    {
+      continue;
+    }
+
+    bool isSupported = false;
+    for( ComponentIdType otherComponentId = 0; otherComponentId < otherDomain.size() && !isSupported; ++otherComponentId )
+    {
+      if( otherDomain[ otherComponentId ] )
+      {
+        isSupported = arc.reviseProvidingNode
+          ? this->m_CompatibilityTable.CanConnect( otherComponentId, componentId, connection.acceptingInterfaceMask )
+          : this->m_CompatibilityTable.CanConnect( componentId, otherComponentId, connection.acceptingInterfaceMask );
+      }
+    }
+
+    if( !isSupported )
+    {
+      revisedDomain[ componentId ] = false;
+      isRevised                    = true;
+    }
+  }
+  return isRevised;
+}
+
+
+void
+ConnectionConstraintSolver::Enqueue( ArcQueueType & queue, const ArcType & arc ) const
+{
+  const std::size_t arcIndex = 2 * arc.connection + ( arc.reviseProvidingNode ? 0 : 1 );
+  if( !queue.isQueued[ arcIndex ] )
+  {
+    queue.isQueued[ arcIndex ] = true;
+    queue.arcs.push_back( arc );
+  }
+}
+
+
+void
+ConnectionConstraintSolver::EnqueueNeighbours( ArcQueueType & queue, NodeIdType node, ConnectionIdType connection ) const
+{
+  for( const auto & neighbourConnection : this->m_ConnectionsOfNode[ node ] )
+  {
+    if( neighbourConnection == connection )
+    {
+      continue;
+    }
+    // Revise the other end of the neighbouring connection
+    this->Enqueue( queue, { neighbourConnection, this->m_Connections[ neighbourConnection ].acceptingNode == node } );
+  }
+}
+
+
+bool
+ConnectionConstraintSolver::Propagate( ArcQueueType & queue )
+{
+  // AC-3: if the domain of a node is revised, all arcs that revise its neighbours against it are revisited.
+  while( !queue.arcs.empty() )
+  {
+    const ArcType arc = queue.arcs.front();
+    queue.arcs.pop_front();
+    queue.isQueued[ 2 * arc.connection + ( arc.reviseProvidingNode ? 0 : 1 ) ] = false;
+
+    if( !this->Revise( arc ) )
+    {
+      continue;
+    }
+
+    const ConnectionType & connection = this->m_Connections[ arc.connection ];
+    const NodeIdType       revisedNode = arc.reviseProvidingNode ? connection.providingNode : connection.acceptingNode;
+    if( this->GetDomainSize( revisedNode ) == 0 )
+    {
+      this->SetConflict( revisedNode, arc.connection );
+      return false;
+    }
+
+    this->EnqueueNeighbours( queue, revisedNode, arc.connection );
+  }
+  return true;
+}
+
+
+bool
+ConnectionConstraintSolver::Solve()
+{
+  if( !this->ApplyNodeConsistency() )
+  {
+    return false;
+  }
+
+  // Initially all arcs are to be revised
+  ArcQueueType queue = { {}, std::vector< bool >( 2 * this->m_Connections.size(), false ) };
+  for( ConnectionIdType connection = 0; connection < this->m_Connections.size(); ++connection )
+  {
+    this->Enqueue( queue, { connection, true } );
+    this->Enqueue( queue, { connection, false } );
+  }
+  return this->Propagate( queue );
+}
+
+
+bool
+ConnectionConstraintSolver::SelectLowestCost( const NodeIdsType & nodes, const CostsType & costs )
+{
+  this->m_LowestCostDomains.clear();
+  this->m_LowestCost = std::numeric_limits< double >::infinity();
+  this->SearchLowestCost( nodes, costs, 0, 0.0 );
+  if( this->m_LowestCostDomains.empty() )
+  {
+    return false;
+  }
+  this->m_Domains = this->m_LowestCostDomains;
+  return true;
+}
+
+
+void
+ConnectionConstraintSolver::SearchLowestCost( const NodeIdsType & nodes, const CostsType & costs, std::size_t depth, double cost )
+{
+  // Branch and bound: since costs are not negative, a partial assignment that is not cheaper than the best complete
+  // assignment cannot lead to a better one.
+  if( cost >= this->m_LowestCost )
+  {
+    return;
+  }
+  if( depth == nodes.size() )
+  {
+    this->m_LowestCostDomains = this->m_Domains;
+    this->m_LowestCost        = cost;
+    return;
+  }
+
+  // Try the cheapest component types first, such that good assignments are found early and bound the search
+  const NodeIdType node         = nodes[ depth ];
+  ComponentIdsType componentIds = this->GetComponentIds( node );
+  std::stable_sort( componentIds.begin(), componentIds.end(), [ & ]( ComponentIdType a, ComponentIdType b ){
+      return costs[ a ] < costs[ b ];
+    } );
+
+  const std::vector< DomainType > domains = this->m_Domains;
+  for( const auto & componentId : componentIds )
+  {
+    this->m_Domains[ node ]                = DomainType( domains[ node ].size(), false );
+    this->m_Domains[ node ][ componentId ] = true;
+
+    ArcQueueType queue = { {}, std::vector< bool >( 2 * this->m_Connections.size(), false ) };
+    this->EnqueueNeighbours( queue, node, this->m_Connections.size() );
+    if( this->Propagate( queue ) )
+    {
+      this->SearchLowestCost( nodes, costs, depth + 1, cost + costs[ componentId ] );
+    }
+    this->m_Domains = domains;
+  }
+}
+
+
+ConnectionConstraintSolver::ComponentIdsType
+ConnectionConstraintSolver::GetComponentIds( NodeIdType node ) const
+{
+  ComponentIdsType componentIds;
+  const DomainType & domain = this->m_Domains[ node ];
+  for( ComponentIdType componentId = 0; componentId < domain.size(); ++componentId )
+  {
+    if( domain[ componentId ] )
+    {
+      componentIds.push_back( componentId );
+    }
+  }
+  return componentIds;
+}
+
+
+std::size_t
+ConnectionConstraintSolver::GetDomainSize( NodeIdType node ) const
+{
+  return std::count( this->m_Domains[ node ].begin(), this->m_Domains[ node ].end(), true );
+}
+} // end namespace selx
@@ -0,0 +1,101 @@
+/*=========================================================================
+ *
+ *  Copyright Leiden University Medical Center, Erasmus University Medical
+ *  Center and contributors
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+
+#include "selxDerivedDataCache.h"
+
+namespace selx
+{
+DerivedDataCache::DerivedDataCache() : m_NumberOfHits( 0 )
+{
+}
+
+
+DerivedDataCache::DataObjectPointer
+DerivedDataCache::GetOrCompute( const itk::DataObject * source, const std::string & operation, const ParametersType & parameters,
+  const ComputeFunctionType & compute )
+{
+  const KeyType                           key( source, source->GetMTime(), operation, parameters );
+  std::promise< DataObjectPointer >       promise;
+  std::shared_future< DataObjectPointer > data;
+  {
+    std::lock_guard< std::mutex > lock( this->m_Mutex );
+    auto entry = this->m_Entries.find( key );
+    if( entry != this->m_Entries.end() )
+    {
+      ++this->m_NumberOfHits;
+      data = entry->second.data;
+    }
+    else
+    {
+      // The entries are ordered by source and modified time, the data derived from an older version of the source is
+      // never requested again
+      this->m_Entries.erase( this->m_Entries.lower_bound( KeyType( source, 0, std::string(), ParametersType() ) ),
+        this->m_Entries.lower_bound( KeyType( source, std::get< 1 >( key ), std::string(), ParametersType() ) ) );
+      this->m_Entries[ key ] = { source, promise.get_future().share() };
+    }
+  }
+
+  if( data.valid() )
+  {
+    // Computed, or being computed by another component
+    return data.get();
+  }
+
+  // Compute outside the lock, other data may be requested meanwhile
+  try
+  {
+    DataObjectPointer dataObject = compute();
+    promise.set_value( dataObject );
+    return dataObject;
+  }
+  catch( ... )
+  {
+    promise.set_exception( std::current_exception() );
+    std::lock_guard< std::mutex > lock( this->m_Mutex );
+    this->m_Entries.erase( key );
+    throw;
+  }
+}
+
+
+std::size_t
+DerivedDataCache::GetNumberOfEntries() const
+{
+  std::lock_guard< std::mutex > lock( this->m_Mutex );
+  return this->m_Entries.size();
+}
+
+
+std::size_t
+DerivedDataCache::GetNumberOfHits() const
+{
+  std::lock_guard< std::mutex > lock( this->m_Mutex );
+  return this->m_NumberOfHits;
+}
+
+
+void
+DerivedDataCache::Clear()
+{
+  std::lock_guard< std::mutex > lock( this->m_Mutex );
+  this->m_Entries.clear();
+  this->m_NumberOfHits = 0;
+}
+} // end namespace selx
@@ -0,0 +1,135 @@
+/*=========================================================================
+ *
+ *  Copyright Leiden University Medical Center, Erasmus University Medical
+ *  Center and contributors
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "selxInterfaceCompatibilityTable.h"
+
+#include <algorithm>
+#include <typeindex>
+#include <unordered_map>
+
+namespace selx
+{
+InterfaceCompatibilityTable::InterfaceCompatibilityTable( const DescriptorsType & descriptors ) :
+  m_Descriptors( descriptors )
+{
+  const std::size_t numberOfComponents = descriptors.size();
+
+  // For each interface type: for all component types whether they provide it
+  std::unordered_map< std::type_index, std::vector< bool > > providers;
+  for( ComponentIdType providerId = 0; providerId < numberOfComponents; ++providerId )
+  {
+    for( const auto & providingInterface : descriptors[ providerId ]->GetProvidingInterfaces() )
+    {
+      auto & row = providers[ providingInterface.interfaceType ];
+      row.resize( numberOfComponents, false );
+      row[ providerId ] = true;
+    }
+  }
+
+  this->m_RowOffsets.reserve( numberOfComponents + 1 );
+  this->m_RowOffsets.push_back( 0 );
+  for( const auto & descriptor : descriptors )
+  {
+    this->m_RowOffsets.push_back( this->m_RowOffsets.back() + descriptor->GetAcceptingInterfaces().size() );
+  }
+
+  this->m_IsProvidedBy.resize( this->m_RowOffsets.back() * numberOfComponents, false );
+  std::size_t row = 0;
+  for( const auto & descriptor : descriptors )
+  {
+    for( const auto & acceptingInterface : descriptor->GetAcceptingInterfaces() )
+    {
+      auto provider = providers.find( acceptingInterface.interfaceType );
+      if( provider != providers.end() )
+      {
+        std::copy( provider->second.begin(), provider->second.end(), this->m_IsProvidedBy.begin() + row * numberOfComponents );
+      }
+      ++row;
+    }
+  }
+}
+
+
+InterfaceCompatibilityTable::InterfaceMaskType
+InterfaceCompatibilityTable::GetAcceptingInterfaceMask( const InterfaceCriteriaType & interfaceCriteria ) const
+{
+  return this->GetAcceptingInterfaceMask( InternedProperties::Find( interfaceCriteria ) );
+}
+
+
+InterfaceCompatibilityTable::InterfaceMaskType
+InterfaceCompatibilityTable::GetAcceptingInterfaceMask( const InternedProperties & interfaceCriteria ) const
+{
+  InterfaceMaskType mask;
+  mask.reserve( this->m_RowOffsets.back() );
+  for( const auto & descriptor : this->m_Descriptors )
+  {
+    for( const auto & acceptingInterface : descriptor->GetAcceptingInterfaces() )
+    {
+      mask.push_back( acceptingInterface.properties.MeetsCriteria( interfaceCriteria ) );
+    }
+  }
+  return mask;
+}
+
+
+InterfaceStatus
+InterfaceCompatibilityTable::CanAcceptConnectionFrom( ComponentIdType acceptorId, ComponentIdType providerId, const InterfaceMaskType & acceptingInterfaceMask ) const
+{
+  // Same logic as Accepting< Interfaces ... >::CanAcceptConnectionFrom
+  const std::size_t numberOfComponents = this->m_Descriptors.size();
+  InterfaceStatus   status = InterfaceStatus::noaccepter;
+  for( std::size_t row = this->m_RowOffsets[ acceptorId ]; row < this->m_RowOffsets[ acceptorId + 1 ]; ++row )
+  {
+    if( !acceptingInterfaceMask[ row ] )
+    {
+      continue;
+    }
+
+    if( this->m_IsProvidedBy[ row * numberOfComponents + providerId ] )
+    {
+      if( status == InterfaceStatus::success )
+      {
+        return InterfaceStatus::multiple;
+      }
+      status = InterfaceStatus::success;
+    }
+    else if( status == InterfaceStatus::noaccepter )
+    {
+      status = InterfaceStatus::noprovider;
+    }
+  }
+  return status;
+}
+
+
+bool
+InterfaceCompatibilityTable::CanConnect( ComponentIdType acceptorId, ComponentIdType providerId, const InterfaceMaskType & acceptingInterfaceMask ) const
+{
+  const std::size_t numberOfComponents = this->m_Descriptors.size();
+  for( std::size_t row = this->m_RowOffsets[ acceptorId ]; row < this->m_RowOffsets[ acceptorId + 1 ]; ++row )
+  {
+    if( acceptingInterfaceMask[ row ] && this->m_IsProvidedBy[ row * numberOfComponents + providerId ] )
+    {
+      return true;
+    }
+  }
+  return false;
+}
+} // end namespace selx
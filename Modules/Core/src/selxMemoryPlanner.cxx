@@ -0,0 +1,135 @@
+/*=========================================================================
+ *
+ *  Copyright Leiden University Medical Center, Erasmus University Medical
+ *  Center and contributors
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "selxMemoryPlanner.h"
+
+#include <algorithm>
+
+namespace selx
+{
+MemoryPlanner::MemoryPlanner( std::size_t numberOfUpdates ) :
+  m_NumberOfUpdates( numberOfUpdates ),
+  m_ReleasableComponentsPerUpdate( numberOfUpdates )
+{
+}
+
+
+void
+MemoryPlanner::AddComponent( ComponentBase::Pointer component, std::size_t producingUpdate, const UpdateIndicesType & consumingUpdates,
+  bool isReleasable )
+{
+  UpdateIndicesType uniqueConsumingUpdates = consumingUpdates;
+  std::sort( uniqueConsumingUpdates.begin(), uniqueConsumingUpdates.end() );
+  uniqueConsumingUpdates.erase( std::unique( uniqueConsumingUpdates.begin(), uniqueConsumingUpdates.end() ), uniqueConsumingUpdates.end() );
+
+  // Data without consumers in the update order is needed until the end, e.g. by the outputs of the network.
+  isReleasable = isReleasable && !uniqueConsumingUpdates.empty();
+  const std::size_t lastConsumingUpdate = isReleasable ? uniqueConsumingUpdates.back() : this->m_NumberOfUpdates;
+
+  const std::size_t componentIndex = this->m_Components.size();
+  this->m_Components.push_back( { component, std::min( producingUpdate, this->m_NumberOfUpdates ), lastConsumingUpdate, isReleasable } );
+  this->m_NumberOfConsumingUpdates.push_back( isReleasable ? uniqueConsumingUpdates.size() : 0 );
+  if( isReleasable )
+  {
+    for( const auto & update : uniqueConsumingUpdates )
+    {
+      this->m_ReleasableComponentsPerUpdate[ update ].push_back( componentIndex );
+    }
+  }
+}
+
+
+void
+MemoryPlanner::Reset()
+{
+  std::lock_guard< std::mutex > lock( this->m_Mutex );
+  this->m_NumberOfUnfinishedConsumingUpdates = this->m_NumberOfConsumingUpdates;
+}
+
+
+void
+MemoryPlanner::UpdateFinished( std::size_t update )
+{
+  std::vector< ComponentBase::Pointer > componentsToRelease;
+  {
+    std::lock_guard< std::mutex > lock( this->m_Mutex );
+    for( const auto & componentIndex : this->m_ReleasableComponentsPerUpdate[ update ] )
+    {
+      if( --this->m_NumberOfUnfinishedConsumingUpdates[ componentIndex ] == 0 )
+      {
+        componentsToRelease.push_back( this->m_Components[ componentIndex ].component );
+      }
+    }
+  }
+  // Release outside the lock, other updates may finish meanwhile
+  for( const auto & component : componentsToRelease )
+  {
+    component->ReleaseData();
+  }
+}
+
+
+std::size_t
+MemoryPlanner::GetEstimatedPeakMemorySize( bool withRelease ) const
+{
+  // Step m_NumberOfUpdates is after the execution of the network
+  std::vector< std::size_t > memoryPerStep( this->m_NumberOfUpdates + 1, 0 );
+  for( const auto & lifetime : this->m_Components )
+  {
+    const std::size_t memorySize = lifetime.component->GetOutputMemorySize();
+    const std::size_t lastStep = withRelease ? lifetime.lastConsumingUpdate : this->m_NumberOfUpdates;
+    for( std::size_t step = lifetime.producingUpdate; step <= lastStep; ++step )
+    {
+      memoryPerStep[ step ] += memorySize;
+    }
+    // Working memory, such as intermediate images, is freed when the component has finished
+    const std::size_t peakMemorySize = lifetime.component->GetResourceEstimate().peakMemorySize;
+    if( peakMemorySize > memorySize )
+    {
+      memoryPerStep[ lifetime.producingUpdate ] += peakMemorySize - memorySize;
+    }
+  }
+  return *std::max_element( memoryPerStep.begin(), memoryPerStep.end() );
+}
+
+
+NetworkPlanReport
+MemoryPlanner::GetPlanReport() const
+{
+  NetworkPlanReport report;
+  report.numberOfUpdates = this->m_NumberOfUpdates;
+  report.runtimeClass = ResourceEstimate::RuntimeClass::Unknown;
+  // The network builder adds the components downstream first
+  for( auto lifetime = this->m_Components.rbegin(); lifetime != this->m_Components.rend(); ++lifetime )
+  {
+    const ResourceEstimate estimate = lifetime->component->GetResourceEstimate();
+    report.components.push_back( { lifetime->component->m_Name, estimate, lifetime->producingUpdate } );
+    report.runtimeClass = std::max( report.runtimeClass, estimate.runtimeClass );
+  }
+  std::stable_sort( report.components.begin(), report.components.end(),
+    []( const NetworkPlanReport::ComponentPlanType & first, const NetworkPlanReport::ComponentPlanType & second ) {
+      return first.update < second.update;
+    } );
+  report.peakMemorySize = this->GetEstimatedPeakMemorySize( true );
+  report.peakMemorySizeWithoutRelease = this->GetEstimatedPeakMemorySize( false );
+  report.maximumConcurrency = 1;
+  report.numberOfThreads = 0;
+  return report;
+}
+} // end namespace selx
@@ -0,0 +1,827 @@
+/*=========================================================================
+ *
+ *  Copyright Leiden University Medical Center, Erasmus University Medical
+ *  Center and contributors
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "selxNetworkBuilder.h"
+#include "selxConnectionConstraintSolver.h"
+#include "selxKeys.h"
+#include "selxSuperElastixComponent.h"
+#include "selxLoggerImpl.h"
+
+#include <algorithm>
+#include <set>
+
+namespace selx
+{
+NetworkBuilder::NetworkBuilder( LoggerImpl & logger, const BlueprintImpl & blueprint, ComponentRegistry & componentRegistry ) :
+  m_isConfigured( false ), m_Logger( logger ), m_DeclaredBlueprint( blueprint ), m_ReplicatedBlueprint( logger ),
+  m_ReplicatedModifiedTime( 0 ), m_Blueprint( m_ReplicatedBlueprint ), m_ComponentRegistry( componentRegistry ),
+  m_CompatibilityTable( componentRegistry.GetCompatibilityTable() ), m_DerivedDataCache( std::make_shared< DerivedDataCache >() ),
+  m_ConfiguredModifiedTime( 0 ), m_IsConnected( false ),
+  m_ConnectedModifiedTime( 0 ), m_AreInterfaceMapsValid( false )
+{
+  // If the replications cannot be expanded, Configure() fails
+  this->UpdateReplicatedBlueprint();
+}
+
+
+bool
+NetworkBuilder::UpdateReplicatedBlueprint()
+{
+  if( this->m_DeclaredBlueprint.GetModifiedTime() <= this->m_ReplicatedModifiedTime )
+  {
+    return true;
+  }
+
+  // Components of the declared blueprint that are not modified keep their modified time in the replicated blueprint,
+  // such that only the modified replicas are reconfigured.
+  if( !this->m_DeclaredBlueprint.ReplicateInto( this->m_ReplicatedBlueprint ) )
+  {
+    return false;
+  }
+  this->m_ReplicatedModifiedTime = this->m_DeclaredBlueprint.GetModifiedTime();
+  return true;
+}
+
+
+bool
+NetworkBuilder::AddBlueprint( const BlueprintImpl & blueprint )
+{
+  //Disabled
+  //this->m_Blueprint.ComposeWith( blueprint );
+  //m_Blueprint = std::make_shared< BlueprintImpl >(*blueprint);
+  return true;
+}
+
+
+bool
+NetworkBuilder::Configure()
+{
+  // Instantiates all the components as described in the blueprint. Returns true
+  // if all components could be uniquely selected.
+  // Configuration consists of 2 steps:
+  // - ApplyComponentConfiguration()
+  // - SolveConnectionConstraints()
+  // If the blueprint was modified after a previous Configure(), only the modified components are selected anew.
+
+  if( !this->UpdateReplicatedBlueprint() )
+  {
+    this->m_Logger.Log( LogLevel::CRT, "The replications of the blueprint cannot be expanded." );
+    return false;
+  }
+
+  if( this->m_isConfigured && this->m_Blueprint.GetModifiedTime() > this->m_ConfiguredModifiedTime )
+  {
+    this->m_AreInterfaceMapsValid = false;
+    if( !this->ReconfigureModifiedComponents() )
+    {
+      this->m_Logger.Log( LogLevel::INF, "The modified components do not fit in the network of the other components, configuring all components ..." );
+      this->m_ComponentSelectorContainer.clear();
+      this->m_isConfigured = false;
+    }
+  }
+
+  if( !this->m_isConfigured )
+  {
+    this->m_AreInterfaceMapsValid = false;
+
+    // Blueprints that were configured before by any NetworkBuilder of this ComponentRegistry are found in the cache.
+    // Their criteria are then only checked against the component types that were selected before, and no
+    // connection constraints need to be solved.
+    ComponentAssignmentCache &              cache = this->m_ComponentRegistry.GetComponentAssignmentCache();
+    const ComponentAssignmentCache::KeyType key   = ComponentAssignmentCache::GetKey( this->m_Blueprint );
+    ComponentAssignmentType                 componentAssignment;
+    if( cache.Find( key, componentAssignment ) )
+    {
+      this->m_Logger.Log( LogLevel::INF, "Applying component criteria to the cached component selection ... " );
+      this->ApplyComponentConfiguration( this->m_Blueprint.GetComponentNames(), componentAssignment );
+      this->m_Logger.Log( LogLevel::INF, "Applying component criteria to the cached component selection ... Done." );
+    }
+    else
+    {
+      this->m_Logger.Log( LogLevel::INF, "Applying component criteria ... " );
+      this->ApplyComponentConfiguration( this->m_Blueprint.GetComponentNames(), componentAssignment );
+      // Counted on the candidates, since the deferred criteria are only applied after the connection constraints
+      // have narrowed the selection
+      std::size_t numberOfUniqueCandidates = 0;
+      for( auto const & componentSelector : this->m_ComponentSelectorContainer )
+      {
+        numberOfUniqueCandidates += componentSelector.second->NumberOfCandidates() == 1 ? 1 : 0;
+      }
+      this->m_Logger.Log(  LogLevel::INF,
+                           "Applying component criteria ... Done. {0:d} out of {1:d} components have a unique candidate.",
+                           numberOfUniqueCandidates,
+                           m_Blueprint.GetComponentNames().size() );
+
+      this->m_Logger.Log( LogLevel::INF, "Solving connection constraints ..." );
+      this->SolveConnectionConstraints();
+      auto nonUniqueComponentNames = this->GetNonUniqueComponentNames();
+      this->m_Logger.Log(  LogLevel::INF,
+                           "Solving connection constraints ... Done. {0:d} out of {1:d} components were uniquely selected.",
+                           m_Blueprint.GetComponentNames().size()-nonUniqueComponentNames.size(),
+                           m_Blueprint.GetComponentNames().size() );
+
+      if( nonUniqueComponentNames.size() == 0 )
+      {
+        for( auto const & componentName : this->m_Blueprint.GetComponentNames() )
+        {
+          componentAssignment[ componentName ] = this->m_ComponentSelectorContainer[ componentName ]->GetComponentIds().front();
+        }
+        cache.Insert( key, componentAssignment );
+      }
+    }
+    this->m_isConfigured = true;
+  }
+  this->m_ConfiguredModifiedTime = this->m_Blueprint.GetModifiedTime();
+  this->m_ConfiguredConnections.clear();
+  for( BlueprintImpl::ConnectionIndexType connectionIndex = 0; connectionIndex < this->m_Blueprint.GetNumberOfConnections(); ++connectionIndex )
+  {
+    const BlueprintImpl::ConnectionPropertyType & connection = this->m_Blueprint.GetConnectionProperty( connectionIndex );
+    this->m_ConfiguredConnections.emplace( this->m_Blueprint.GetComponentProperty( connection.upstream ).name,
+      this->m_Blueprint.GetComponentProperty( connection.downstream ).name, connection.name );
+  }
+
+  auto nonUniqueComponentNames = this->GetNonUniqueComponentNames();
+
+  // TODO: Print the available criteria
+  if( nonUniqueComponentNames.size() > 0 )
+  {
+    this->m_Logger.Log( LogLevel::CRT, ( this->m_Logger << nonUniqueComponentNames ) + " need more criteria." );
+    return false;
+  }
+
+  return true;
+}
+
+
+bool
+NetworkBuilder::ReconfigureModifiedComponents()
+{
+  // Components that were deleted from the blueprint
+  for( auto componentSelector = this->m_ComponentSelectorContainer.begin(); componentSelector != this->m_ComponentSelectorContainer.end(); )
+  {
+    if( this->m_Blueprint.ComponentExists( componentSelector->first ) )
+    {
+      ++componentSelector;
+    }
+    else
+    {
+      componentSelector = this->m_ComponentSelectorContainer.erase( componentSelector );
+    }
+  }
+
+  // Components cannot be disconnected. The accepting component of a deleted connection, also of a connection from a
+  // deleted component, still holds the interface of the connection and is selected anew.
+  std::set< ComponentNameType > disconnectedComponentNames;
+  for( auto const & connection : this->m_ConfiguredConnections )
+  {
+    if( !this->m_Blueprint.ConnectionExists( std::get< 0 >( connection ), std::get< 1 >( connection ), std::get< 2 >( connection ) ) )
+    {
+      disconnectedComponentNames.insert( std::get< 1 >( connection ) );
+    }
+  }
+
+  // The selectors of the other components are kept, including their instantiated components
+  ComponentNamesType modifiedComponentNames;
+  for( auto const & componentName : this->m_Blueprint.GetComponentNames() )
+  {
+    if( this->m_ComponentSelectorContainer.count( componentName ) == 0
+      || this->m_Blueprint.GetComponentModifiedTime( componentName ) > this->m_ConfiguredModifiedTime
+      || disconnectedComponentNames.count( componentName ) > 0 )
+    {
+      modifiedComponentNames.push_back( componentName );
+    }
+  }
+
+  this->m_Logger.Log( LogLevel::INF, "Applying component criteria to {0:d} modified component(s) ... ", modifiedComponentNames.size() );
+  this->ApplyComponentConfiguration( modifiedComponentNames, ComponentAssignmentType() );
+  this->m_Logger.Log( LogLevel::INF, "Applying component criteria to {0:d} modified component(s) ... Done.", modifiedComponentNames.size() );
+
+  // The unmodified components are uniquely selected already, such that the connection constraints only narrow
+  // the modified components. The constraints cannot be solved if an unmodified component needs to change too.
+  this->m_Logger.Log( LogLevel::INF, "Solving connection constraints ..." );
+  try
+  {
+    this->SolveConnectionConstraints();
+  }
+  catch( std::runtime_error & )
+  {
+    return false;
+  }
+  this->m_Logger.Log( LogLevel::INF, "Solving connection constraints ... Done." );
+  return true;
+}
+
+
+NetworkBuilderBase::ComponentNamesType
+NetworkBuilder::GetNonUniqueComponentNames()
+{
+  ComponentNamesType                  nonUniqueComponentNames;
+  const BlueprintImpl::ComponentNamesType componentNames = m_Blueprint.GetComponentNames();
+  for( auto const & name : componentNames )
+  {
+    // The current idea of the configuration setup is that the number of
+    // possible components at a node can only be reduced by adding criteria.
+    // If a node has 0 possible components, the configuration is aborted (with an exception)
+    // If all nodes have exactly 1 possible component, no more criteria are needed.
+
+    if( this->m_ComponentSelectorContainer[ name ]->NumberOfComponents() > 1 )
+    {
+      nonUniqueComponentNames.push_back( name );
+    }
+  }
+  return nonUniqueComponentNames;
+}
+
+
+void
+NetworkBuilder::ApplyComponentConfiguration( const ComponentNamesType & componentNames, const ComponentAssignmentType & componentAssignment )
+{
+  // Creates a ComponentSelector for each node of the graph and apply
+  // the criteria/properties at each node to narrow the Component selection.
+
+  // At the NetworkBuilder we store all components selectors in a mapping based
+  // on the keys we find in the graph. This is a flexible solution, but is
+  // fragile as well since correspondence is implicit.
+  // We might consider copying the blueprint graph to a component selector
+  // graph, such that all graph operations correspond
+  //
+  // This could be in line with the idea of maintaining 2 graphs:
+  // 1 descriptive (= const blueprint) and 1 internal holding to realized
+  // components.
+  // Manipulating the internal graph (combining component nodes into a
+  // hybrid node, duplicating sub graphs, etc) is possible then.
+  //
+  // Additional redesign consideration: the final graph should hold the
+  // realized components at each node and not the ComponentSelectors that,
+  // in turn, hold 1 (or more) component.
+
+  for( auto const & componentName : componentNames )
+  {
+    ComponentSelectorPointer currentComponentSelector = std::make_shared< ComponentSelector >( componentName, this->m_Logger, this->m_CompatibilityTable );
+
+    auto assignedComponent = componentAssignment.find( componentName );
+    if( assignedComponent != componentAssignment.end() )
+    {
+      currentComponentSelector->RestrictToComponentIds( { assignedComponent->second } );
+    }
+
+    BlueprintImpl::ParameterMapType currentProperty = this->m_Blueprint.GetComponent( componentName );
+    for( auto const& criterion : currentProperty )
+    {
+      // The number of components is not queried per criterion, since that would instantiate the candidates
+      // for criteria that cannot be decided statically before all template properties have been applied.
+      currentComponentSelector->AddCriterion( criterion );
+
+      this->m_Logger.Log( LogLevel::TRC,
+                          "Finding component for '{0}': adding criterion {{ '{1}' : '{2}' }}.",
+                          componentName,
+                          criterion.first,
+                          this->m_Logger << criterion.second);
+    }
+
+    // The candidates are counted without instantiating them: criteria that cannot be checked statically are only
+    // applied to the candidates that remain after solving the connection constraints.
+    this->m_Logger.Log( LogLevel::DBG,
+                        "Finding component for '{0}': {1} candidate(s) satisfy the criteria that can be checked statically, out of {2} criteria.",
+                        componentName,
+                        currentComponentSelector->NumberOfCandidates(),
+                        currentProperty.size() );
+
+    if( currentComponentSelector->NumberOfCandidates() == 0 )
+    {
+      std::string msg = "No components fulfill all criteria for " + componentName + ".";
+      this->m_Logger.Log( LogLevel::CRT, msg );
+      throw std::runtime_error( msg );
+    }
+
+    // insert new element, or replace the selector of a modified component
+    this->m_ComponentSelectorContainer[ componentName ] = currentComponentSelector;
+    this->m_ReselectedComponentNames.insert( componentName );
+  }
+  return;
+}
+
+
+void
+NetworkBuilder::SolveConnectionConstraints()
+{
+  // Read the criteria/properties at each connection and narrow the selection of components at both ends to
+  // the component types that have compatible interfaces. The ConnectionConstraintSolver propagates these
+  // constraints through the whole network, such that properties like Dimensionality or PixelType need to be
+  // specified at a single component only, if all other components can be deduced from it by their connections.
+  const InterfaceCompatibilityTable & compatibilityTable = *this->m_CompatibilityTable;
+  ConnectionConstraintSolver          solver( compatibilityTable );
+
+  std::map< ComponentNameType, ConnectionConstraintSolver::NodeIdType > nodeIds;
+  std::vector< ComponentNameType >                                       nodeNames;
+  for( auto const & componentName : this->m_Blueprint.GetComponentNames() )
+  {
+    nodeIds[ componentName ] = solver.AddNode( this->m_ComponentSelectorContainer[ componentName ]->GetCandidateIds() );
+    nodeNames.push_back( componentName );
+  }
+
+  // For error messages: the providing and accepting component of each connection
+  std::vector< std::pair< ComponentNameType, ComponentNameType > > connectionEnds;
+  for( BlueprintImpl::ComponentIndexType providingIndex = 0; providingIndex < this->m_Blueprint.GetNumberOfComponents(); ++providingIndex )
+  {
+    const ComponentNameType & providingComponentName = this->m_Blueprint.GetComponentProperty( providingIndex ).name;
+    for( auto const & connectionIndex : this->m_Blueprint.GetOutputConnections( providingIndex ) )
+    {
+      const BlueprintImpl::ConnectionPropertyType & connection             = this->m_Blueprint.GetConnectionProperty( connectionIndex );
+      const ComponentNameType &                     acceptingComponentName = this->m_Blueprint.GetComponentProperty( connection.downstream ).name;
+
+      // TODO: #110
+      ComponentBase::InterfaceCriteriaType interfaceCriteria;
+      for( const auto& connectionProperty : *connection.parameterMap )
+      {
+        assert( connectionProperty.second.size() <= 1 );
+        if( connectionProperty.second.size() == 1 ) {
+          interfaceCriteria[connectionProperty.first] = connectionProperty.second[0];
+        }
+      }
+
+      this->m_Logger.Log( LogLevel::TRC, "Adding constraint from '{0}' to '{1}' by connection '{2}': {3}.",
+                          providingComponentName, acceptingComponentName, connection.name, this->m_Logger << interfaceCriteria );
+      solver.AddConnection( nodeIds[ providingComponentName ], nodeIds[ acceptingComponentName ], interfaceCriteria );
+      connectionEnds.push_back( { providingComponentName, acceptingComponentName } );
+    }
+  }
+
+  if( !solver.Solve() )
+  {
+    const auto & connectionEnd = connectionEnds[ solver.GetConflictingConnection() ];
+    std::string  msg = "No component exists for '" + nodeNames[ solver.GetConflictingNode() ]
+      + "' that has suitable interfaces for all its connections, including the connection from '" + connectionEnd.first + "' to '" + connectionEnd.second + "'.";
+    this->m_Logger.Log( LogLevel::ERR, msg );
+    throw std::runtime_error( msg );
+  }
+
+  // Components with the LowestCost SelectionPolicy that are still not unique get the component type of the consistent
+  // assignment with the lowest estimated cost.
+  ConnectionConstraintSolver::NodeIdsType lowestCostNodes;
+  ComponentNamesType                      lowestCostComponentNames;
+  for( auto const & componentName : nodeNames )
+  {
+    const auto componentProperties = this->m_Blueprint.GetComponent( componentName );
+    const auto selectionPolicy     = componentProperties.find( keys::SelectionPolicy );
+    if( selectionPolicy != componentProperties.end() && selectionPolicy->second[ 0 ] == keys::LowestCost
+      && solver.GetDomainSize( nodeIds[ componentName ] ) > 1 )
+    {
+      lowestCostNodes.push_back( nodeIds[ componentName ] );
+      lowestCostComponentNames.push_back( componentName );
+    }
+  }
+  if( !lowestCostNodes.empty() )
+  {
+    ConnectionConstraintSolver::CostsType costs;
+    for( InterfaceCompatibilityTable::ComponentIdType componentId = 0; componentId < compatibilityTable.GetNumberOfComponents(); ++componentId )
+    {
+      costs.push_back( compatibilityTable.GetDescriptor( componentId ).GetEstimatedCost() );
+    }
+
+    this->m_Logger.Log( LogLevel::INF, "Selecting the lowest cost components for {0} ...", this->m_Logger << lowestCostComponentNames );
+    if( !solver.SelectLowestCost( lowestCostNodes, costs ) )
+    {
+      std::string msg = "No combination of components exists for " + ( this->m_Logger << lowestCostComponentNames )
+        + " that satisfies all connection constraints.";
+      this->m_Logger.Log( LogLevel::ERR, msg );
+      throw std::runtime_error( msg );
+    }
+    this->m_Logger.Log( LogLevel::INF, "Selecting the lowest cost components for {0} ... Done.", this->m_Logger << lowestCostComponentNames );
+  }
+
+  for( auto const & componentName : nodeNames )
+  {
+    auto componentSelector = this->m_ComponentSelectorContainer[ componentName ];
+    componentSelector->RestrictToComponentIds( solver.GetComponentIds( nodeIds[ componentName ] ) );
+
+    // Only the candidates that satisfy the connection constraints are instantiated for the deferred criteria
+    const unsigned int numberOfComponents = componentSelector->NumberOfComponents();
+    this->m_Logger.Log( LogLevel::DBG,
+                        "Finding component for '{0}': {1} component(s) satisfies all criteria and connection constraints.",
+                        componentName,
+                        numberOfComponents );
+    if( numberOfComponents == 0 )
+    {
+      std::string msg = "No components fulfill all criteria and connection constraints for " + componentName + ".";
+      this->m_Logger.Log( LogLevel::CRT, msg );
+      throw std::runtime_error( msg );
+    }
+  }
+}
+
+
+bool
+NetworkBuilder::ConnectComponents()
+{
+  bool isAllSuccess = true;
+
+  // After a successful ConnectComponents(), only the connections of the components that were selected anew and the
+  // connections that were added or modified since then need to be made.
+  const bool isConnectingAll = !this->m_IsConnected;
+
+  // Components share the data that they derive from their inputs while they are connected
+  for( auto const & componentSelector : this->m_ComponentSelectorContainer )
+  {
+    ComponentBase::Pointer component = componentSelector.second->GetComponent();
+    if( component )
+    {
+      component->m_DerivedDataCache = this->m_DerivedDataCache;
+    }
+  }
+
+  for( BlueprintImpl::ComponentIndexType providingIndex = 0; providingIndex < this->m_Blueprint.GetNumberOfComponents(); ++providingIndex )
+  {
+    const ComponentNameType & providingComponentName = this->m_Blueprint.GetComponentProperty( providingIndex ).name;
+    const auto                outputConnections      = this->m_Blueprint.GetOutputConnections( providingIndex );
+    for( auto connectionIndex = outputConnections.begin(); connectionIndex != outputConnections.end(); ++connectionIndex )
+    {
+      const BlueprintImpl::ConnectionPropertyType & connection             = this->m_Blueprint.GetConnectionProperty( *connectionIndex );
+      const ComponentNameType &                     acceptingComponentName = this->m_Blueprint.GetComponentProperty( connection.downstream ).name;
+
+      // GetComponent returns NULL if possible components !=1. We assume ComponentSelectorContainers have unique components since Configure().
+      ComponentBase::Pointer providingComponent = this->m_ComponentSelectorContainer[ providingComponentName ]->GetComponent();
+      ComponentBase::Pointer acceptingComponent = this->m_ComponentSelectorContainer[ acceptingComponentName ]->GetComponent();
+
+      const bool isReselected = this->m_ReselectedComponentNames.count( providingComponentName ) > 0
+        || this->m_ReselectedComponentNames.count( acceptingComponentName ) > 0;
+
+      if( !isConnectingAll && !isReselected && connection.modifiedTime <= this->m_ConnectedModifiedTime )
+      {
+        continue;
+      }
+
+      // TODO:#110
+      ComponentBase::InterfaceCriteriaType interfaceCriteria;
+      for( const auto & connectionProperty : *connection.parameterMap )
+      {
+        if( connectionProperty.second.size() > 0 )
+        {
+          interfaceCriteria[ connectionProperty.first ] = connectionProperty.second[ 0 ];
+        }
+      }
+
+      // multiple parallel 'named' connections between 2 components can exist. The connections from a component are
+      // ordered by the accepting component, so parallel connections are adjacent.
+      const bool isParallel = ( connectionIndex != outputConnections.begin()
+        && this->m_Blueprint.GetConnectionProperty( connectionIndex[ -1 ] ).downstream == connection.downstream )
+        || ( connectionIndex + 1 != outputConnections.end()
+        && this->m_Blueprint.GetConnectionProperty( connectionIndex[ 1 ] ).downstream == connection.downstream );
+
+      std::string message1, message2;
+      if (isParallel) // specialize log messages if multiple parallel connections exist
+      {
+        message1 = "Connect '{0}' to '{1}' by connection '{2}' ... ";
+        message2 = "Connect '{0}' to '{1}' by connection '{3}' ... Done, by {2} interface(s).";
+      }
+      else
+      {
+        message1 = "Connect '{0}' to '{1}' ... ";
+        message2 = "Connect '{0}' to '{1}' ... Done, by {2} interface(s).";
+
+      }
+      this->m_Logger.Log(LogLevel::DBG, message1 , providingComponentName, acceptingComponentName, connection.name);
+      int numberOfConnections = acceptingComponent->AcceptConnectionFrom(providingComponent, interfaceCriteria);
+      this->m_Logger.Log(LogLevel::DBG, message2 , providingComponentName, acceptingComponentName, numberOfConnections, connection.name);
+      if( numberOfConnections == 0 )
+      {
+        isAllSuccess = false;
+        this->m_Logger.Log( LogLevel::CRT, "Connection from '{0}' to '{1}' was specified but no compatible interfaces were found.", providingComponentName, acceptingComponentName);
+      }
+    }
+  }
+
+  this->m_IsConnected = isAllSuccess;
+  this->m_ConnectedModifiedTime = this->m_Blueprint.GetModifiedTime();
+  this->m_ReselectedComponentNames.clear();
+  return isAllSuccess;
+}
+
+
+bool
+NetworkBuilder::CheckConnectionsSatisfied()
+{
+  bool isAllSatisfied = true;
+
+  // TODO: Print the unsatisfied connections
+  for( auto const & name : this->m_Blueprint.GetComponentNames() )
+  {
+    ComponentBase::Pointer component   = this->m_ComponentSelectorContainer[ name ]->GetComponent();
+    bool                   isSatisfied = component->ConnectionsSatisfied();
+    if( isSatisfied == false )
+    {
+      isAllSatisfied = false;
+      this->m_Logger.Log( LogLevel::ERR, "Component '{0}' has unsatisfied connections.", name );
+    }
+  }
+  return isAllSatisfied;
+}
+
+
+void
+NetworkBuilder::UpdateInterfaceMaps()
+{
+  /** Scans all Components once to find those with Sourcing or Sinking capability and stores them until the network is reconfigured */
+  if( this->m_AreInterfaceMapsValid )
+  {
+    return;
+  }
+
+  SourceInterfaceMapType sourceInterfaceMap;
+  SinkInterfaceMapType   sinkInterfaceMap;
+  for( const auto & componentSelector : this->m_ComponentSelectorContainer )
+  {
+    ComponentBase::Pointer component = componentSelector.second->GetComponent();
+
+    if(component == nullptr) {
+      std::string msg = "No component found for '" + componentSelector.first + "'.";
+      this->m_Logger.Log( LogLevel::CRT, msg );
+      throw std::runtime_error(msg);
+    }
+
+    if( SourceInterface::Pointer provingSourceInterface = ComponentBase::GetProvidedInterface< SourceInterface >( component ) )
+    {
+      sourceInterfaceMap[ componentSelector.first ] = provingSourceInterface;
+    }
+    if( SinkInterface::Pointer provingSinkInterface = ComponentBase::GetProvidedInterface< SinkInterface >( component ) )
+    {
+      sinkInterfaceMap[ componentSelector.first ] = provingSinkInterface;
+    }
+  }
+  this->m_SourceInterfaceMap = sourceInterfaceMap;
+  this->m_SinkInterfaceMap = sinkInterfaceMap;
+  this->m_AreInterfaceMapsValid = true;
+}
+
+
+NetworkBuilderBase::SourceInterfaceMapType
+NetworkBuilder::GetSourceInterfaces()
+{
+  this->UpdateInterfaceMaps();
+  return this->m_SourceInterfaceMap;
+}
+
+
+NetworkBuilderBase::SinkInterfaceMapType
+NetworkBuilder::GetSinkInterfaces()
+{
+  this->UpdateInterfaceMaps();
+  return this->m_SinkInterfaceMap;
+}
+
+
+AnyFileReader::Pointer
+NetworkBuilder::GetInputFileReader( const NetworkBuilderBase::ComponentNameType & inputName )
+{
+  this->UpdateInterfaceMaps();
+  auto source = this->m_SourceInterfaceMap.find( inputName );
+  if( source == this->m_SourceInterfaceMap.end() )
+  {
+    std::stringstream msg;
+    msg << "No Source component found by name:" << inputName;
+    this->m_Logger.Log(LogLevel::ERR, "{}", msg.str() );
+    throw std::runtime_error( msg.str() );
+  }
+
+  return source->second->GetInputFileReader();
+}
+
+
+AnyFileWriter::Pointer
+NetworkBuilder::GetOutputFileWriter( const NetworkBuilderBase::ComponentNameType & outputName )
+{
+  this->UpdateInterfaceMaps();
+  auto sink = this->m_SinkInterfaceMap.find( outputName );
+  if( sink == this->m_SinkInterfaceMap.end() )
+  {
+    std::stringstream msg;
+    msg << "No Sink component found by name : " << outputName;
+    this->m_Logger.Log(LogLevel::ERR, "{}", msg.str() );
+    throw std::runtime_error( msg.str() );
+  }
+
+  return sink->second->GetOutputFileWriter();
+}
+
+
+SinkInterface::DataObjectPointer
+NetworkBuilder::GetInitializedOutput( const NetworkBuilderBase::ComponentNameType & outputName )
+{
+  this->UpdateInterfaceMaps();
+  auto sink = this->m_SinkInterfaceMap.find( outputName );
+  if( sink == this->m_SinkInterfaceMap.end() )
+  {
+    std::stringstream msg;
+    msg << "No Sink component found by name : " << outputName;
+    this->m_Logger.Log(LogLevel::ERR, "{}", msg.str() );
+    throw std::runtime_error( msg.str() );
+  }
+
+  return sink->second->GetInitializedOutput();
+}
+
+
+NetworkContainer
+NetworkBuilder::GetRealizedNetwork()
+{
+  // vector that stores all components
+  NetworkContainer::ComponentContainerType components;
+  NetworkContainer::UpdateOrderType updateOrder;
+  NetworkContainer::OutputObjectsMapType outputObjectsMap;
+  NetworkContainer::DependenciesType dependencies;
+  std::map< ComponentNameType, std::size_t > updateIndices;
+
+  if( this->Configure() )
+  {
+    for( const auto & componentSelector : this->m_ComponentSelectorContainer )
+    {
+      //store all components
+      ComponentBase::Pointer component = componentSelector.second->GetComponent();
+      components.push_back( component );
+
+      // The NumberOfThreads criterion is supported by all components and was validated at selection.
+      const auto componentProperties = this->m_Blueprint.GetComponent( componentSelector.first );
+      auto numberOfThreads = componentProperties.find( keys::NumberOfThreads );
+      if( numberOfThreads != componentProperties.end() )
+      {
+        component->m_NumberOfThreadsCriterion = std::stoul( numberOfThreads->second[ 0 ] );
+        component->m_NumberOfThreads = component->m_NumberOfThreadsCriterion;
+      }
+    }
+
+    /** The outputs of the Components with Sinking capability */
+    for( const auto & nameAndInterface : this->GetSinkInterfaces() )
+    {
+      outputObjectsMap[ nameAndInterface.first ] = nameAndInterface.second->GetMiniPipelineOutput();
+    }
+
+    for (const auto & componentName : this->m_Blueprint.GetUpdateOrder())
+    {
+      auto component = this->m_ComponentSelectorContainer[componentName]->GetComponent();
+      if( auto provingUpdateInterface = ComponentBase::GetProvidedInterface< UpdateInterface >( component ) )
+      {
+        // check if the UpdateInterface has been connected to a (controller) component. If so don't take over the control by adding it into updateOrder.
+        auto connectionInfoUpdateInterface = ComponentBase::GetConnectionInfo< UpdateInterface >( component );
+        const auto & providedTo = connectionInfoUpdateInterface->GetProvidedTo();
+
+        // A previously realized network has taken over the control already
+        const bool isControlledByNetwork = providedTo.size() == 1 && providedTo[ 0 ] == "NetworkBuilder";
+        if( providedTo.size() == 0 || isControlledByNetwork )
+        {
+          updateIndices[ componentName ] = updateOrder.size();
+          updateOrder.push_back(provingUpdateInterface);
+          if( !isControlledByNetwork )
+          {
+            connectionInfoUpdateInterface->SetProvidedTo("NetworkBuilder");
+          }
+        }
+      }
+    }
+
+    // An update depends on the updates of all components upstream of it, also if other components are in between.
+    dependencies.resize( updateOrder.size() );
+    std::vector< std::size_t > updateIndexOfComponent( this->m_Blueprint.GetNumberOfComponents(), updateOrder.size() );
+    for( const auto & updateIndex : updateIndices )
+    {
+      updateIndexOfComponent[ this->m_Blueprint.GetComponentIndex( updateIndex.first ) ] = updateIndex.second;
+    }
+    // The updates that pull each component that is not updated by the network itself, i.e. an itk pipeline stage
+    std::vector< std::vector< std::size_t >> pullingUpdates( this->m_Blueprint.GetNumberOfComponents() );
+    for( const auto & updateIndex : updateIndices )
+    {
+      std::vector< bool > isVisited( this->m_Blueprint.GetNumberOfComponents(), false );
+      std::vector< BlueprintImpl::ComponentIndexType > componentsToVisit( 1, this->m_Blueprint.GetComponentIndex( updateIndex.first ) );
+      while( !componentsToVisit.empty() )
+      {
+        const BlueprintImpl::ComponentIndexType component = componentsToVisit.back();
+        componentsToVisit.pop_back();
+        for( const auto & connection : this->m_Blueprint.GetInputConnections( component ) )
+        {
+          const BlueprintImpl::ComponentIndexType upstream = this->m_Blueprint.GetConnectionProperty( connection ).upstream;
+          if( isVisited[ upstream ] )
+          {
+            continue;
+          }
+          isVisited[ upstream ] = true;
+          if( updateIndexOfComponent[ upstream ] != updateOrder.size() )
+          {
+            dependencies[ updateIndex.second ].push_back( updateIndexOfComponent[ upstream ] );
+          }
+          else
+          {
+            pullingUpdates[ upstream ].push_back( updateIndex.second );
+          }
+          componentsToVisit.push_back( upstream );
+        }
+      }
+    }
+    // An itk pipeline stage must not be pulled by two updates at once: the updates that share one run one after another,
+    // in update order, even if they are on independent branches.
+    for( auto & updates : pullingUpdates )
+    {
+      std::sort( updates.begin(), updates.end() );
+      for( std::size_t i = 1; i < updates.size(); ++i )
+      {
+        dependencies[ updates[ i ] ].push_back( updates[ i - 1 ] );
+      }
+    }
+    for( auto & updateDependencies : dependencies )
+    {
+      std::sort( updateDependencies.begin(), updateDependencies.end() );
+      updateDependencies.erase( std::unique( updateDependencies.begin(), updateDependencies.end() ), updateDependencies.end() );
+    }
+
+    // Liveness of the data of each component, in steps of updateOrder. Components that are not updated by the network are
+    // part of an itk pipeline and produce their data when the first update downstream pulls it.
+    auto memoryPlanner = std::make_shared< MemoryPlanner >( updateOrder.size() );
+    std::map< ComponentNameType, std::size_t > producingUpdates;
+    const auto componentNamesInUpdateOrder = this->m_Blueprint.GetUpdateOrder();
+    for( auto componentName = componentNamesInUpdateOrder.rbegin(); componentName != componentNamesInUpdateOrder.rend(); ++componentName )
+    {
+      MemoryPlanner::UpdateIndicesType consumingUpdates;
+      bool isReleasable = true;
+      std::size_t producingUpdate = updateOrder.size();
+      for( const auto & connection : this->m_Blueprint.GetOutputConnections( this->m_Blueprint.GetComponentIndex( *componentName ) ) )
+      {
+        const ComponentNameType & outputName = this->m_Blueprint.GetComponentProperty( this->m_Blueprint.GetConnectionProperty( connection ).downstream ).name;
+        auto outputUpdateIndex = updateIndices.find( outputName );
+        if( outputUpdateIndex != updateIndices.end() )
+        {
+          consumingUpdates.push_back( outputUpdateIndex->second );
+        }
+        else
+        {
+          // An itk pipeline downstream may pull the data at any time
+          isReleasable = false;
+        }
+        producingUpdate = std::min( producingUpdate, producingUpdates[ outputName ] );
+      }
+      auto updateIndex = updateIndices.find( *componentName );
+      if( updateIndex != updateIndices.end() )
+      {
+        producingUpdate = updateIndex->second;
+      }
+      producingUpdates[ *componentName ] = producingUpdate;
+
+      memoryPlanner->AddComponent( this->m_ComponentSelectorContainer[ *componentName ]->GetComponent(), producingUpdate, consumingUpdates,
+        isReleasable );
+    }
+    this->m_Logger.Log( LogLevel::INF, "Estimated peak memory: {0} MB, {1} MB without releasing intermediate data.",
+      memoryPlanner->GetEstimatedPeakMemorySize() / ( 1024 * 1024 ), memoryPlanner->GetEstimatedPeakMemorySize( false ) / ( 1024 * 1024 ) );
+
+    return NetworkContainer( components, updateOrder, outputObjectsMap, this->GetSourceInterfaces(), dependencies, memoryPlanner,
+      ComponentAssignmentCache::GetKey( this->m_Blueprint ) );
+  }
+  else
+  {
+    std::stringstream msg;
+    msg << "Network is not realized yet";
+    this->m_Logger.Log(LogLevel::ERR, "{}", msg.str() );
+    throw std::runtime_error( msg.str() );
+    return NetworkContainer( components, updateOrder, outputObjectsMap );
+  }
+
+
+}
+
+NetworkPlanReport
+NetworkBuilder::GetPlanReport( unsigned int numberOfThreads )
+{
+  auto realizedNetwork = this->GetRealizedNetwork();
+  realizedNetwork.SetNumberOfThreads( numberOfThreads );
+  const NetworkPlanReport report = realizedNetwork.GetPlanReport();
+  for( const auto & component : report.components )
+  {
+    this->m_Logger.Log( LogLevel::DBG, "Plan of '{0}': update {1}, runtime {2}, peak memory {3} bytes.", component.name, component.update,
+      ResourceEstimate::ToString( component.estimate.runtimeClass ), component.estimate.peakMemorySize );
+  }
+  return report;
+}
+
+
+void
+NetworkBuilder::Cite()
+{
+  const BlueprintImpl::ComponentNamesType componentNames = m_Blueprint.GetComponentNames();
+  for( auto const & componentName : componentNames ) {
+    this->m_ComponentSelectorContainer[componentName]->GetComponent()->Cite();
+  }
+}
+
+} // end namespace selx
@@ -21,24 +21,267 @@
 #include "selxKeys.h"
 #include "selxSuperElastixComponent.h"
 
+#include <algorithm>
+#include <set>
+
 namespace selx
 {
-NetworkContainer::NetworkContainer( ComponentContainerType components, UpdateOrderType updateOrder, OutputObjectsMapType outputObjectsMap ) :
+const unsigned int NetworkContainer::DefaultRandomSeed;
+
+static NetworkContainer::DependenciesType
+GetSequentialDependencies( std::size_t numberOfUpdates )
+{
+  NetworkContainer::DependenciesType dependencies( numberOfUpdates );
+  for( std::size_t update = 1; update < numberOfUpdates; ++update )
+  {
+    dependencies[ update ].push_back( update - 1 );
+  }
+  return dependencies;
+}
+
+
+NetworkContainer::NetworkContainer( ComponentContainerType components, UpdateOrderType updateOrder, OutputObjectsMapType outputObjectsMap,
+  SourceInterfaceMapType sourceInterfaceMap, DependenciesType dependencies, MemoryPlannerPointer memoryPlanner,
+  const std::string & blueprintKey ) :
   m_ComponentContainer( components ),
   m_UpdateOrder( updateOrder),
-  m_OutputObjectsMap( outputObjectsMap )
+  m_OutputObjectsMap( outputObjectsMap ),
+  m_SourceInterfaceMap( sourceInterfaceMap ),
+  m_UpdateScheduler( updateOrder, dependencies.empty() ? GetSequentialDependencies( updateOrder.size() ) : dependencies ),
+  m_MemoryPlanner( memoryPlanner ),
+  m_BlueprintKey( blueprintKey ),
+  m_IsCheckpointRestorable( false ),
+  m_NumberOfThreads( 0 ),
+  m_Deterministic( false ),
+  m_RandomSeed( 0 )
 {
+  this->SetCancellationToken( std::make_shared< CancellationToken >() );
 }
 
 
 void
 NetworkContainer::Execute()
 {
-  /** For those components that have an update interface the update is executed in the right pipeline order. **/
+  /** For those components that have an update interface the update is executed in the right pipeline order. Components
+   * that do not depend on each other may be updated concurrently, each with an equal share of the threads. **/
+  const unsigned int maximumConcurrency = std::max( this->m_UpdateScheduler.GetMaximumConcurrency(), 1u );
+  const unsigned int numberOfWorkers = this->m_NumberOfThreads == 0 ? 1 : std::min( this->m_NumberOfThreads, maximumConcurrency );
+  const unsigned int numberOfThreadsPerUpdate = this->m_NumberOfThreads / numberOfWorkers;
   for( auto updateInterface : this->m_UpdateOrder )
   {
-    updateInterface->Update();
+    updateInterface->SetNumberOfThreads( numberOfThreadsPerUpdate );
+  }
+
+  const unsigned int randomSeed = this->m_Deterministic && this->m_RandomSeed == 0 ? DefaultRandomSeed : this->m_RandomSeed;
+  for( const auto & component : this->m_ComponentContainer )
+  {
+    component->m_RandomSeed      = randomSeed;
+    component->m_IsDeterministic = this->m_Deterministic;
+  }
+
+  if( this->m_MemoryPlanner )
+  {
+    this->m_MemoryPlanner->Reset();
+  }
+
+  // Restore the components that completed in an earlier execution. Their updates are skipped, but the updates of all
+  // other components, including those upstream that have no checkpoint, run as usual.
+  std::vector< ComponentBase::Pointer > updateComponents( this->m_UpdateOrder.size() );
+  std::vector< bool > isCompleted( this->m_UpdateOrder.size(), false );
+  if( this->m_Checkpoint )
+  {
+    if( !this->m_IsCheckpointRestorable )
+    {
+      this->m_Checkpoint->Reset();
+    }
+    const std::set< std::string > completedComponentNames = this->m_Checkpoint->GetCompletedComponentNames();
+    for( std::size_t update = 0; update < this->m_UpdateOrder.size(); ++update )
+    {
+      const std::string componentName = this->m_UpdateOrder[ update ]->GetComponentName();
+      auto component = std::find_if( this->m_ComponentContainer.begin(), this->m_ComponentContainer.end(),
+        [ &componentName ]( const ComponentBase::Pointer & candidate ) { return candidate->m_Name == componentName; } );
+      if( component == this->m_ComponentContainer.end() )
+      {
+        continue;
+      }
+      updateComponents[ update ] = *component;
+      if( completedComponentNames.count( componentName ) > 0 )
+      {
+        isCompleted[ update ] = ( *component )->ReadCheckpoint( this->m_Checkpoint->GetComponentDirectory( componentName ) );
+      }
+    }
+  }
+
+  try
+  {
+    this->m_UpdateScheduler.Execute( numberOfWorkers, [ this, &updateComponents, &isCompleted ]( std::size_t update ) {
+        const ComponentBase::Pointer & component = updateComponents[ update ];
+        if( this->m_Checkpoint && component && !isCompleted[ update ]
+          && component->WriteCheckpoint( this->m_Checkpoint->GetComponentDirectory( component->m_Name ) ) )
+        {
+          this->m_Checkpoint->Completed( component->m_Name );
+        }
+        if( this->m_MemoryPlanner )
+        {
+          this->m_MemoryPlanner->UpdateFinished( update );
+        }
+      }, isCompleted );
+  }
+  catch( ... )
+  {
+    // Components abort in their own way, e.g. by an itk::ProcessAborted exception, which is reported uniformly
+    if( this->m_CancellationToken->IsCancelled() )
+    {
+      throw CancellationToken::CancelledError();
+    }
+    throw;
+  }
+}
+
+
+void
+NetworkContainer::Cancel()
+{
+  this->m_CancellationToken->Cancel();
+}
+
+
+void
+NetworkContainer::SetCancellationToken( CancellationToken::Pointer cancellationToken )
+{
+  this->m_CancellationToken = cancellationToken;
+  this->m_UpdateScheduler.SetCancellationToken( cancellationToken );
+  for( const auto & component : this->m_ComponentContainer )
+  {
+    component->m_CancellationToken = cancellationToken;
+  }
+}
+
+
+CancellationToken::Pointer
+NetworkContainer::GetCancellationToken() const
+{
+  return this->m_CancellationToken;
+}
+
+
+void
+NetworkContainer::SetProgressEventBuffer( ProgressEventBuffer::Pointer progressEventBuffer )
+{
+  for( const auto & component : this->m_ComponentContainer )
+  {
+    component->m_ProgressEventBuffer = progressEventBuffer;
+  }
+}
+
+
+void
+NetworkContainer::SetNumberOfThreads( unsigned int numberOfThreads )
+{
+  this->m_NumberOfThreads = numberOfThreads;
+}
+
+
+unsigned int
+NetworkContainer::GetNumberOfThreads() const
+{
+  return this->m_NumberOfThreads;
+}
+
+
+void
+NetworkContainer::SetCheckpoint( const std::string & directory, const std::string & inputKey )
+{
+  if( directory.empty() )
+  {
+    this->m_Checkpoint.reset();
+    return;
+  }
+  this->m_Checkpoint = std::make_shared< Checkpoint >( directory, this->m_BlueprintKey + '\n' + inputKey );
+  this->m_IsCheckpointRestorable = !inputKey.empty();
+}
+
+
+void
+NetworkContainer::SetDeterministic( bool deterministic )
+{
+  this->m_Deterministic = deterministic;
+}
+
+
+bool
+NetworkContainer::GetDeterministic() const
+{
+  return this->m_Deterministic;
+}
+
+
+void
+NetworkContainer::SetRandomSeed( unsigned int randomSeed )
+{
+  this->m_RandomSeed = randomSeed;
+}
+
+
+unsigned int
+NetworkContainer::GetRandomSeed() const
+{
+  return this->m_RandomSeed;
+}
+
+
+std::size_t
+NetworkContainer::GetEstimatedPeakMemorySize( bool withRelease ) const
+{
+  return this->m_MemoryPlanner ? this->m_MemoryPlanner->GetEstimatedPeakMemorySize( withRelease ) : 0;
+}
+
+
+NetworkPlanReport
+NetworkContainer::GetPlanReport() const
+{
+  NetworkPlanReport report;
+  if( this->m_MemoryPlanner )
+  {
+    report = this->m_MemoryPlanner->GetPlanReport();
+  }
+  else
+  {
+    report.numberOfUpdates = this->m_UpdateOrder.size();
+    report.peakMemorySize = 0;
+    report.peakMemorySizeWithoutRelease = 0;
+    report.runtimeClass = ResourceEstimate::RuntimeClass::Unknown;
+  }
+  report.maximumConcurrency = std::max( this->m_UpdateScheduler.GetMaximumConcurrency(), 1u );
+  report.numberOfThreads = this->m_NumberOfThreads;
+  return report;
+}
+
+
+void
+NetworkContainer::SetInput( const std::string & sourceName, itk::DataObject::Pointer input )
+{
+  auto sourceInterface = this->m_SourceInterfaceMap.find( sourceName );
+  if( sourceInterface == this->m_SourceInterfaceMap.end() )
+  {
+    throw std::runtime_error( "The network has no Source Component with name '" + sourceName + "'." );
+  }
+  sourceInterface->second->SetMiniPipelineInput( input );
+
+  // The input key of the checkpoint identifies the previous inputs, SetCheckpoint must be given a key for the new ones
+  this->m_IsCheckpointRestorable = false;
+}
+
+
+std::vector< std::string >
+NetworkContainer::GetInputNames()
+{
+  std::vector< std::string > inputNames;
+  for( const auto & nameAndInterface : this->m_SourceInterfaceMap )
+  {
+    inputNames.push_back( nameAndInterface.first );
   }
+  return inputNames;
 }
 
 
@@ -0,0 +1,134 @@
+/*=========================================================================
+ *
+ *  Copyright Leiden University Medical Center, Erasmus University Medical
+ *  Center and contributors
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+
+#include "selxProgressEventBuffer.h"
+
+namespace selx
+{
+static std::size_t
+RoundUpToPowerOfTwo( std::size_t value )
+{
+  std::size_t powerOfTwo = 1;
+  while( powerOfTwo < value )
+  {
+    powerOfTwo *= 2;
+  }
+  return powerOfTwo;
+}
+
+
+ProgressEventBuffer::ProgressEventBuffer( std::size_t capacity ) :
+  m_Cells( RoundUpToPowerOfTwo( capacity ) ),
+  m_Mask( m_Cells.size() - 1 ),
+  m_PushPosition( 0 ),
+  m_PopPosition( 0 ),
+  m_NumberOfDroppedEvents( 0 ),
+  m_StartTime( ClockType::now() )
+{
+  for( std::size_t position = 0; position < this->m_Cells.size(); ++position )
+  {
+    this->m_Cells[ position ].sequence.store( position, std::memory_order_relaxed );
+  }
+}
+
+
+bool
+ProgressEventBuffer::Push( const ProgressEvent & event )
+{
+  std::size_t position = this->m_PushPosition.load( std::memory_order_relaxed );
+  while( true )
+  {
+    CellType &           cell     = this->m_Cells[ position & this->m_Mask ];
+    const std::size_t    sequence = cell.sequence.load( std::memory_order_acquire );
+    const std::ptrdiff_t distance = static_cast< std::ptrdiff_t >( sequence ) - static_cast< std::ptrdiff_t >( position );
+    if( distance == 0 )
+    {
+      // The cell is free: claim it, or retry at the position that another producer moved on to
+      if( this->m_PushPosition.compare_exchange_weak( position, position + 1, std::memory_order_relaxed ) )
+      {
+        cell.event = event;
+        cell.sequence.store( position + 1, std::memory_order_release );
+        return true;
+      }
+    }
+    else if( distance < 0 )
+    {
+      // The cell still holds an event of the previous round that was not popped
+      ++this->m_NumberOfDroppedEvents;
+      return false;
+    }
+    else
+    {
+      position = this->m_PushPosition.load( std::memory_order_relaxed );
+    }
+  }
+}
+
+
+bool
+ProgressEventBuffer::Pop( ProgressEvent & event )
+{
+  std::size_t position = this->m_PopPosition.load( std::memory_order_relaxed );
+  while( true )
+  {
+    CellType &           cell     = this->m_Cells[ position & this->m_Mask ];
+    const std::size_t    sequence = cell.sequence.load( std::memory_order_acquire );
+    const std::ptrdiff_t distance = static_cast< std::ptrdiff_t >( sequence ) - static_cast< std::ptrdiff_t >( position + 1 );
+    if( distance == 0 )
+    {
+      if( this->m_PopPosition.compare_exchange_weak( position, position + 1, std::memory_order_relaxed ) )
+      {
+        event = std::move( cell.event );
+        cell.sequence.store( position + this->m_Mask + 1, std::memory_order_release );
+        return true;
+      }
+    }
+    else if( distance < 0 )
+    {
+      return false;
+    }
+    else
+    {
+      position = this->m_PopPosition.load( std::memory_order_relaxed );
+    }
+  }
+}
+
+
+std::size_t
+ProgressEventBuffer::GetCapacity() const
+{
+  return this->m_Cells.size();
+}
+
+
+std::size_t
+ProgressEventBuffer::GetNumberOfDroppedEvents() const
+{
+  return this->m_NumberOfDroppedEvents;
+}
+
+
+double
+ProgressEventBuffer::GetElapsedTime() const
+{
+  return std::chrono::duration< double >( ClockType::now() - this->m_StartTime ).count();
+}
+} // end namespace selx
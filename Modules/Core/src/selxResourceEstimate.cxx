@@ -0,0 +1,53 @@
+/*=========================================================================
+ *
+ *  Copyright Leiden University Medical Center, Erasmus University Medical
+ *  Center and contributors
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "selxResourceEstimate.h"
+
+namespace selx
+{
+std::string
+ResourceEstimate::ToString( RuntimeClass runtimeClass )
+{
+  switch( runtimeClass )
+  {
+    case RuntimeClass::Constant:
+      return "Constant";
+    case RuntimeClass::Linear:
+      return "Linear";
+    case RuntimeClass::Iterative:
+      return "Iterative";
+    default:
+      return "Unknown";
+  }
+}
+
+
+std::size_t
+ResourceEstimate::GetPyramidMemorySize( std::size_t numberOfPixels, std::size_t pixelSize, unsigned int dimension,
+  unsigned int numberOfLevels )
+{
+  std::size_t memorySize = 0;
+  for( unsigned int level = 0; level < numberOfLevels && numberOfPixels > 0; ++level )
+  {
+    memorySize += numberOfPixels * pixelSize;
+    numberOfPixels >>= dimension;
+  }
+  return memorySize;
+}
+} // end namespace selx
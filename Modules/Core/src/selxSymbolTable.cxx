@@ -0,0 +1,151 @@
+/*=========================================================================
+ *
+ *  Copyright Leiden University Medical Center, Erasmus University Medical
+ *  Center and contributors
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+
+#include "selxSymbolTable.h"
+
+#include <algorithm>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+namespace selx
+{
+namespace
+{
+struct SymbolTableData
+{
+  std::mutex                                               mutex;
+  std::unordered_map< std::string, SymbolTable::SymbolType > symbols;
+  // The string of each symbol. A deque keeps references to its elements valid when it grows.
+  std::deque< std::string >                                strings;
+};
+
+// Constructed at first use, since descriptors of components may intern their properties during static initialization.
+SymbolTableData &
+GetSymbolTableData()
+{
+  static SymbolTableData data;
+  return data;
+}
+}
+
+const SymbolTable::SymbolType SymbolTable::UnknownSymbol;
+
+SymbolTable::SymbolType
+SymbolTable::Intern( const std::string & string )
+{
+  SymbolTableData &             data = GetSymbolTableData();
+  std::lock_guard< std::mutex > lock( data.mutex );
+  auto                          symbol = data.symbols.find( string );
+  if( symbol != data.symbols.end() )
+  {
+    return symbol->second;
+  }
+  data.strings.push_back( string );
+  // Symbols start at 1, UnknownSymbol is 0
+  return data.symbols[ string ] = static_cast< SymbolType >( data.strings.size() );
+}
+
+
+SymbolTable::SymbolType
+SymbolTable::Find( const std::string & string )
+{
+  SymbolTableData &             data = GetSymbolTableData();
+  std::lock_guard< std::mutex > lock( data.mutex );
+  auto                          symbol = data.symbols.find( string );
+  return symbol == data.symbols.end() ? UnknownSymbol : symbol->second;
+}
+
+
+const std::string &
+SymbolTable::GetString( SymbolType symbol )
+{
+  static const std::string unknownString;
+  SymbolTableData &             data = GetSymbolTableData();
+  std::lock_guard< std::mutex > lock( data.mutex );
+  return symbol == UnknownSymbol || symbol > data.strings.size() ? unknownString : data.strings[ symbol - 1 ];
+}
+
+
+InternedProperties::InternedProperties( const StringPropertiesType & properties, SymbolType ( * toSymbol )( const std::string & ) )
+{
+  this->m_Properties.reserve( properties.size() );
+  for( const auto & keyAndValue : properties )
+  {
+    this->m_Properties.emplace_back( toSymbol( keyAndValue.first ), toSymbol( keyAndValue.second ) );
+  }
+  std::sort( this->m_Properties.begin(), this->m_Properties.end() );
+}
+
+
+InternedProperties
+InternedProperties::Intern( const StringPropertiesType & properties )
+{
+  return InternedProperties( properties, &SymbolTable::Intern );
+}
+
+
+InternedProperties
+InternedProperties::Find( const StringPropertiesType & criteria )
+{
+  return InternedProperties( criteria, &SymbolTable::Find );
+}
+
+
+bool
+InternedProperties::MeetsCriteria( const InternedProperties & criteria ) const
+{
+  // Both are sorted by key, such that a single pass over the properties suffices. Interned properties never contain
+  // UnknownSymbol, hence criteria with unknown strings fail.
+  auto property = this->m_Properties.begin();
+  for( const auto & criterion : criteria.m_Properties )
+  {
+    while( property != this->m_Properties.end() && property->first < criterion.first )
+    {
+      ++property;
+    }
+    if( property == this->m_Properties.end() || *property != criterion )
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+
+InternedProperties::SymbolType
+InternedProperties::Get( SymbolType key ) const
+{
+  auto property = std::lower_bound( this->m_Properties.begin(), this->m_Properties.end(), PropertyType( key, SymbolTable::UnknownSymbol ) );
+  return property != this->m_Properties.end() && property->first == key ? property->second : SymbolTable::UnknownSymbol;
+}
+
+
+InternedProperties::StringPropertiesType
+InternedProperties::ToStrings() const
+{
+  StringPropertiesType properties;
+  for( const auto & property : this->m_Properties )
+  {
+    properties[ SymbolTable::GetString( property.first ) ] = SymbolTable::GetString( property.second );
+  }
+  return properties;
+}
+} // end namespace selx
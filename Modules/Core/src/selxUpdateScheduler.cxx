@@ -0,0 +1,283 @@
+/*=========================================================================
+ *
+ *  Copyright Leiden University Medical Center, Erasmus University Medical
+ *  Center and contributors
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "selxUpdateScheduler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+namespace selx
+{
+UpdateScheduler::UpdateScheduler( const UpdateOrderType & updateOrder, const DependenciesType & dependencies ) :
+  m_UpdateOrder( updateOrder ),
+  m_Successors( updateOrder.size() ),
+  m_NumberOfDependencies( updateOrder.size(), 0 ),
+  m_MaximumConcurrency( 0 )
+{
+  if( dependencies.size() != updateOrder.size() )
+  {
+    throw std::runtime_error( "UpdateScheduler requires the dependencies of each update." );
+  }
+
+  // The level of an update is the length of the longest chain of updates it depends on. Updates at the same
+  // level are independent; the widest level is used as the maximum concurrency.
+  std::vector< std::size_t >  levels( updateOrder.size(), 0 );
+  std::vector< unsigned int > levelWidths;
+  for( std::size_t update = 0; update < updateOrder.size(); ++update )
+  {
+    for( const auto & dependency : dependencies[ update ] )
+    {
+      if( dependency >= update )
+      {
+        throw std::runtime_error( "UpdateScheduler requires the updates in topological order." );
+      }
+      this->m_Successors[ dependency ].push_back( update );
+      levels[ update ] = std::max( levels[ update ], levels[ dependency ] + 1 );
+    }
+    this->m_NumberOfDependencies[ update ] = dependencies[ update ].size();
+
+    if( levels[ update ] >= levelWidths.size() )
+    {
+      levelWidths.resize( levels[ update ] + 1, 0 );
+    }
+    ++levelWidths[ levels[ update ] ];
+  }
+  if( !levelWidths.empty() )
+  {
+    this->m_MaximumConcurrency = *std::max_element( levelWidths.begin(), levelWidths.end() );
+  }
+}
+
+
+void
+UpdateScheduler::SetCancellationToken( CancellationToken::Pointer cancellationToken )
+{
+  this->m_CancellationToken = cancellationToken;
+}
+
+
+unsigned int
+UpdateScheduler::GetMaximumConcurrency() const
+{
+  return this->m_MaximumConcurrency;
+}
+
+
+void
+UpdateScheduler::Execute( unsigned int numberOfWorkers, const UpdateFinishedCallbackType & updateFinished,
+  const std::vector< bool > & isCompleted )
+{
+  if( !isCompleted.empty() && isCompleted.size() != this->m_UpdateOrder.size() )
+  {
+    throw std::runtime_error( "UpdateScheduler requires the completion of each update." );
+  }
+  auto run = [ & ]( std::size_t update ) {
+      if( isCompleted.empty() || !isCompleted[ update ] )
+      {
+        if( this->m_CancellationToken )
+        {
+          this->m_CancellationToken->ThrowIfCancelled();
+        }
+        this->m_UpdateOrder[ update ]->Update();
+      }
+      if( updateFinished )
+      {
+        updateFinished( update );
+      }
+    };
+
+  numberOfWorkers = std::min( numberOfWorkers, this->m_MaximumConcurrency );
+  if( numberOfWorkers <= 1 )
+  {
+    for( std::size_t update = 0; update < this->m_UpdateOrder.size(); ++update )
+    {
+      run( update );
+    }
+    return;
+  }
+
+  struct WorkerQueueType
+  {
+    std::mutex                mutex;
+    std::deque< std::size_t > updates;
+  };
+
+  std::vector< WorkerQueueType >          queues( numberOfWorkers );
+  std::vector< std::atomic< std::size_t >> remainingDependencies( this->m_UpdateOrder.size() );
+  for( std::size_t update = 0; update < this->m_UpdateOrder.size(); ++update )
+  {
+    remainingDependencies[ update ] = this->m_NumberOfDependencies[ update ];
+  }
+
+  std::atomic< std::size_t > numberOfUnfinishedUpdates( this->m_UpdateOrder.size() );
+  std::atomic< std::size_t > numberOfQueuedUpdates( 0 );
+  std::atomic< bool >        isAborted( false );
+  std::exception_ptr         exception;
+  std::mutex                 waitMutex;
+  std::condition_variable    wakeUp;
+
+  auto push = [ & ]( unsigned int worker, std::size_t update ) {
+      {
+        std::lock_guard< std::mutex > lock( queues[ worker ].mutex );
+        queues[ worker ].updates.push_back( update );
+      }
+      {
+        std::lock_guard< std::mutex > lock( waitMutex );
+        ++numberOfQueuedUpdates;
+      }
+      wakeUp.notify_one();
+    };
+
+  // Pop from the back of the own queue, or steal from the front of the queue of another worker.
+  auto pop = [ & ]( unsigned int worker, std::size_t & update ) {
+      for( unsigned int offset = 0; offset < numberOfWorkers; ++offset )
+      {
+        WorkerQueueType &             queue = queues[ ( worker + offset ) % numberOfWorkers ];
+        std::lock_guard< std::mutex > lock( queue.mutex );
+        if( !queue.updates.empty() )
+        {
+          if( offset == 0 )
+          {
+            update = queue.updates.back();
+            queue.updates.pop_back();
+          }
+          else
+          {
+            update = queue.updates.front();
+            queue.updates.pop_front();
+          }
+          --numberOfQueuedUpdates;
+          return true;
+        }
+      }
+      return false;
+    };
+
+  // Distribute the updates without dependencies over the workers
+  unsigned int initialWorker = 0;
+  for( std::size_t update = 0; update < this->m_UpdateOrder.size(); ++update )
+  {
+    if( this->m_NumberOfDependencies[ update ] == 0 )
+    {
+      push( initialWorker, update );
+      initialWorker = ( initialWorker + 1 ) % numberOfWorkers;
+    }
+  }
+
+  // Record the first exception and wake up the other workers, which then stop
+  auto abort = [ & ]() {
+      std::lock_guard< std::mutex > lock( waitMutex );
+      if( !isAborted )
+      {
+        exception = std::current_exception();
+        isAborted = true;
+      }
+      wakeUp.notify_all();
+    };
+
+  auto work = [ & ]( unsigned int worker ) {
+      while( true )
+      {
+        // Checked before each pop, such that no further updates are taken once another update threw or the network
+        // was cancelled
+        try
+        {
+          if( this->m_CancellationToken )
+          {
+            this->m_CancellationToken->ThrowIfCancelled();
+          }
+        }
+        catch( ... )
+        {
+          abort();
+          return;
+        }
+        if( isAborted )
+        {
+          return;
+        }
+
+        std::size_t update;
+        if( !pop( worker, update ) )
+        {
+          std::unique_lock< std::mutex > lock( waitMutex );
+          wakeUp.wait( lock, [ & ] {
+              return isAborted || numberOfUnfinishedUpdates == 0 || numberOfQueuedUpdates > 0;
+            } );
+          if( isAborted || numberOfUnfinishedUpdates == 0 )
+          {
+            return;
+          }
+          continue;
+        }
+
+        // Another update may have thrown while this one was popped
+        if( isAborted )
+        {
+          return;
+        }
+        try
+        {
+          run( update );
+        }
+        catch( ... )
+        {
+          abort();
+          return;
+        }
+
+        for( const auto & successor : this->m_Successors[ update ] )
+        {
+          if( --remainingDependencies[ successor ] == 0 )
+          {
+            push( worker, successor );
+          }
+        }
+
+        if( --numberOfUnfinishedUpdates == 0 )
+        {
+          std::lock_guard< std::mutex > lock( waitMutex );
+          wakeUp.notify_all();
+        }
+      }
+    };
+
+  std::vector< std::thread > workers;
+  for( unsigned int worker = 1; worker < numberOfWorkers; ++worker )
+  {
+    workers.emplace_back( work, worker );
+  }
+  work( 0 );
+  for( auto & thread : workers )
+  {
+    thread.join();
+  }
+
+  if( exception )
+  {
+    std::rethrow_exception( exception );
+  }
+}
+} // end namespace selx
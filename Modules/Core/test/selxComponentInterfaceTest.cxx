@@ -21,6 +21,7 @@
 #include "selxGDOptimizer3rdPartyComponent.h"
 #include "selxSSDMetric4thPartyComponent.h"
 #include "selxGDOptimizer4thPartyComponent.h"
+#include "selxComponentDescriptor.h"
 
 #include "gtest/gtest.h"
 
@@ -105,6 +106,31 @@ TEST_F( InterfaceTest, DynamicCast )
   ASSERT_NE( derivativeAcceptorIF, nullptr );
 }
 
+TEST_F( InterfaceTest, ProvidedInterfaceTable )
+{
+  // The table casts to the same interfaces as dynamic_cast does
+  MetricValueInterface::Pointer valueIF = ComponentBase::GetProvidedInterface< MetricValueInterface >( metric3p );
+  ASSERT_NE( valueIF, nullptr );
+  EXPECT_EQ( valueIF, std::dynamic_pointer_cast< MetricValueInterface >( metric3p ) );
+  EXPECT_EQ( ComponentBase::GetProvidedInterface< MetricDerivativeInterface >( metric3p ),
+    std::dynamic_pointer_cast< MetricDerivativeInterface >( metric3p ) );
+  EXPECT_EQ( ComponentBase::GetConnectionInfo< MetricValueInterface >( metric3p ),
+    std::dynamic_pointer_cast< ConnectionInfo< MetricValueInterface >>( metric3p ) );
+
+  // Accepting interfaces are not provided
+  EXPECT_EQ( ComponentBase::GetProvidedInterface< MetricValueInterface >( optimizer3p ), nullptr );
+  EXPECT_FALSE( optimizer3p->IsProviding< MetricValueInterface >() );
+  EXPECT_TRUE( optimizer4p->IsProviding< ConflictinUpdateInterface >() );
+  EXPECT_FALSE( optimizer3p->IsProviding< ConflictinUpdateInterface >() );
+
+  // The provided interface shares the ownership of the component
+  std::weak_ptr< ComponentBase > component = metric3p;
+  metric3p = nullptr;
+  EXPECT_FALSE( component.expired() );
+  valueIF = nullptr;
+  EXPECT_TRUE( component.expired() );
+}
+
 TEST_F( InterfaceTest, ConnectByName )
 {
   InterfaceStatus IFstatus;
@@ -133,6 +159,45 @@ TEST_F( InterfaceTest, ConnectByName )
   EXPECT_EQ( IFstatus, InterfaceStatus::multiple );
 }
 
+TEST_F( InterfaceTest, ConnectByNameWithoutInstances )
+{
+  // The ComponentDescriptor decides on the same handshakes as ConnectByName, without any component being constructed.
+  auto const & metric3pDescriptor    = ComponentDescriptor::Get< SSDMetric3rdPartyComponent >();
+  auto const & metric4pDescriptor    = ComponentDescriptor::Get< SSDMetric4thPartyComponent >();
+  auto const & optimizer3pDescriptor = ComponentDescriptor::Get< GDOptimizer3rdPartyComponent >();
+  auto const & optimizer4pDescriptor = ComponentDescriptor::Get< GDOptimizer4thPartyComponent >();
+
+  EXPECT_EQ( optimizer3pDescriptor.CanAcceptConnectionFrom( metric3pDescriptor, { { "NameOfInterface", "MetricValueInterface" } } ), InterfaceStatus::success );
+  EXPECT_EQ( optimizer3pDescriptor.CanAcceptConnectionFrom( metric4pDescriptor, { { "NameOfInterface", "MetricValueInterface" } } ), InterfaceStatus::success );
+  EXPECT_EQ( optimizer4pDescriptor.CanAcceptConnectionFrom( metric3pDescriptor, { { "NameOfInterface", "MetricValueInterface" } } ), InterfaceStatus::success );
+  EXPECT_EQ( optimizer4pDescriptor.CanAcceptConnectionFrom( metric4pDescriptor, { { "NameOfInterface", "MetricValueInterface" } } ), InterfaceStatus::success );
+  EXPECT_EQ( optimizer3pDescriptor.CanAcceptConnectionFrom( metric3pDescriptor, { { "NameOfInterface", "MetricDerivativeInterface" } } ), InterfaceStatus::success );
+  EXPECT_EQ( optimizer3pDescriptor.CanAcceptConnectionFrom( metric4pDescriptor, { { "NameOfInterface", "MetricDerivativeInterface" } } ), InterfaceStatus::noprovider );
+  EXPECT_EQ( optimizer4pDescriptor.CanAcceptConnectionFrom( metric3pDescriptor, { { "NameOfInterface", "MetricDerivativeInterface" } } ), InterfaceStatus::noaccepter );
+  EXPECT_EQ( optimizer3pDescriptor.CanAcceptConnectionFrom( metric3pDescriptor, {} ), InterfaceStatus::multiple );
+
+  EXPECT_EQ( optimizer3pDescriptor.CountAcceptingInterfaces( { { "NameOfInterface", "MetricDerivativeInterface" } } ), 1 );
+  EXPECT_EQ( metric4pDescriptor.CountProvidingInterfaces( { { "NameOfInterface", "MetricDerivativeInterface" } } ), 0 );
+}
+
+TEST_F( InterfaceTest, InternedProperties )
+{
+  const InternedProperties properties = InternedProperties::Intern( { { "NameOfInterface", "MetricValueInterface" }, { "Dimensionality", "3" } } );
+  EXPECT_EQ( properties.ToStrings(), InternedProperties::StringPropertiesType( { { "NameOfInterface", "MetricValueInterface" }, { "Dimensionality", "3" } } ) );
+  EXPECT_EQ( properties.Get( SymbolTable::Find( "Dimensionality" ) ), SymbolTable::Find( "3" ) );
+  EXPECT_EQ( properties.Get( SymbolTable::Find( "NotAProperty" ) ), SymbolTable::UnknownSymbol );
+
+  EXPECT_TRUE( properties.MeetsCriteria( InternedProperties::Find( {} ) ) );
+  EXPECT_TRUE( properties.MeetsCriteria( InternedProperties::Find( { { "Dimensionality", "3" } } ) ) );
+  EXPECT_TRUE( properties.MeetsCriteria( InternedProperties::Find( { { "NameOfInterface", "MetricValueInterface" }, { "Dimensionality", "3" } } ) ) );
+  EXPECT_FALSE( properties.MeetsCriteria( InternedProperties::Find( { { "Dimensionality", "2" } } ) ) );
+  EXPECT_FALSE( properties.MeetsCriteria( InternedProperties::Find( { { "Dimensionality", "3" }, { "PixelType", "float" } } ) ) );
+
+  // Looking up criteria does not intern unknown strings
+  EXPECT_FALSE( properties.MeetsCriteria( InternedProperties::Find( { { "Dimensionality", "UnknownValue" } } ) ) );
+  EXPECT_EQ( SymbolTable::Find( "UnknownValue" ), SymbolTable::UnknownSymbol );
+}
+
 TEST_F( InterfaceTest, ConnectAll )
 {
   int                               connectionCount = 0;
@@ -20,6 +20,8 @@
 #include "gtest/gtest.h"
 
 #include "selxComponentSelector.h"
+#include "selxComponentRegistry.h"
+#include "selxConnectionConstraintSolver.h"
 #include "selxTypeList.h"
 #include "selxTransformComponent1.h"
 #include "selxMetricComponent1.h"
@@ -29,6 +31,8 @@
 #include "selxSSDMetric3rdPartyComponent.h"
 #include "selxSSDMetric4thPartyComponent.h"
 
+#include <algorithm>
+
 namespace selx
 {
 class ComponentSelectorTest : public ::testing::Test
@@ -64,7 +68,7 @@ public:
 
 TEST_F( ComponentSelectorTest, EmptyComponentList )
 {
-  auto componentSelector = std::make_shared< ComponentSelector< EmptyComponentList >>( "nameless", *( new LoggerImpl() ) );
+  auto componentSelector = std::make_shared< ComponentSelector >( "nameless", *( new LoggerImpl() ), ComponentRegistry::Get< EmptyComponentList >().GetCompatibilityTable() );
 
   // " 0 Component objects available to the NetworkBuilder."
   EXPECT_EQ( componentSelector->NumberOfComponents(), 0 );
@@ -73,7 +77,7 @@ TEST_F( ComponentSelectorTest, EmptyComponentList )
 TEST_F( ComponentSelectorTest, FilledComponentList )
 {
   // In this test we manually register 2 dummy modules: itkTransformComponent1 and itkMetricComponent1.
-  auto componentSelector = std::make_shared< ComponentSelector< TypeList< TransformComponent1, MetricComponent1 >>>( "nameless", *( new LoggerImpl() ) );
+  auto componentSelector = std::make_shared< ComponentSelector >( "nameless", *( new LoggerImpl() ), ComponentRegistry::Get< TypeList< TransformComponent1, MetricComponent1 >>().GetCompatibilityTable() );
 
   // After registering the TransformComponent1 and MetricComponent1object, there are
   // " 2 Component objects available to the NetworkBuilder."
@@ -82,7 +86,7 @@ TEST_F( ComponentSelectorTest, FilledComponentList )
 
 TEST_F( ComponentSelectorTest, SetEmptyCriteria )
 {
-  auto componentSelector = std::make_shared< ComponentSelector< SmallComponentList >>( "nameless", *( new LoggerImpl() ) );
+  auto componentSelector = std::make_shared< ComponentSelector >( "nameless", *( new LoggerImpl() ), ComponentRegistry::Get< SmallComponentList >().GetCompatibilityTable() );
 
   CriterionType emptyCriterion; // = CriterionType();
 
@@ -96,7 +100,7 @@ TEST_F( ComponentSelectorTest, SetEmptyCriteria )
 
 TEST_F( ComponentSelectorTest, SetSufficientCriteria )
 {
-  auto componentSelector = std::make_shared< ComponentSelector< SmallComponentList >>( "nameless", *( new LoggerImpl() ) );
+  auto componentSelector = std::make_shared< ComponentSelector >( "nameless", *( new LoggerImpl() ), ComponentRegistry::Get< SmallComponentList >().GetCompatibilityTable() );
 
   CriterionType criterion = { "ComponentInput", { "Transform" } };
 
@@ -109,7 +113,7 @@ TEST_F( ComponentSelectorTest, SetSufficientCriteria )
 }
 TEST_F( ComponentSelectorTest, AddCriteria )
 {
-  auto componentSelector = std::make_shared< ComponentSelector< SmallComponentList >>( "nameless", *( new LoggerImpl() ) );
+  auto componentSelector = std::make_shared< ComponentSelector >( "nameless", *( new LoggerImpl() ), ComponentRegistry::Get< SmallComponentList >().GetCompatibilityTable() );
 
   CriterionType nonSelectiveCriterion( { "ComponentProperty", { "SomeProperty" } } );
 
@@ -133,9 +137,39 @@ TEST_F( ComponentSelectorTest, AddCriteria )
   EXPECT_TRUE( component->MeetsCriterion( { "NameOfClass", { "TransformComponent1" } } ) );
 }
 
+TEST_F( ComponentSelectorTest, DeferredCriteria )
+{
+  // Exposes the number of instantiated candidates
+  class InspectableComponentSelector : public ComponentSelector
+  {
+  public:
+
+    using ComponentSelector::ComponentSelector;
+    std::size_t NumberOfInstances() const
+    {
+      return std::count_if( this->m_PossibleComponents.begin(), this->m_PossibleComponents.end(),
+        []( const CandidateType & candidate ) { return candidate.component != nullptr; } );
+    }
+  };
+
+  LoggerImpl logger;
+  InspectableComponentSelector componentSelector( "nameless", logger, ComponentRegistry::Get< SmallComponentList >().GetCompatibilityTable() );
+
+  // A criterion that the template properties cannot decide is deferred: the candidates are counted without instantiating them
+  componentSelector.AddCriterion( { "ComponentProperty", { "SomeProperty" } } );
+  EXPECT_EQ( componentSelector.NumberOfCandidates(), 2 );
+  EXPECT_EQ( componentSelector.GetCandidateIds().size(), 2 );
+  EXPECT_EQ( componentSelector.NumberOfInstances(), 0 );
+
+  // Only the candidates that remain are instantiated for the deferred criteria
+  componentSelector.RestrictToComponentIds( { componentSelector.GetCandidateIds().front() } );
+  EXPECT_EQ( componentSelector.NumberOfComponents(), 1 );
+  EXPECT_EQ( componentSelector.NumberOfInstances(), 1 );
+}
+
 TEST_F( ComponentSelectorTest, InterfacedObjects )
 {
-  auto componentSelectorA = std::make_shared< ComponentSelector< BigComponentList >>( "nameless", *( new LoggerImpl() ) );
+  auto componentSelectorA = std::make_shared< ComponentSelector >( "nameless", *( new LoggerImpl() ), ComponentRegistry::Get< BigComponentList >().GetCompatibilityTable() );
   // " 6 Component objects available to the NetworkBuilder."
   EXPECT_EQ( componentSelectorA->NumberOfComponents(), 6 );
 
@@ -145,7 +179,7 @@ TEST_F( ComponentSelectorTest, InterfacedObjects )
   EXPECT_NO_THROW( componentA = componentSelectorA->GetComponent() );
   EXPECT_TRUE( componentA->MeetsCriterion( { "NameOfClass", { "GDOptimizer3rdPartyComponent" } } ) );
 
-  auto componentSelectorB = std::make_shared< ComponentSelector< BigComponentList >>( "nameless", *( new LoggerImpl() ) );
+  auto componentSelectorB = std::make_shared< ComponentSelector >( "nameless", *( new LoggerImpl() ), ComponentRegistry::Get< BigComponentList >().GetCompatibilityTable() );
   componentSelectorB->AddProvidingInterfaceCriteria( { { "NameOfInterface", "MetricDerivativeInterface" } } );
   ComponentType::Pointer componentB;
   EXPECT_NO_THROW( componentB = componentSelectorB->GetComponent() );
@@ -155,7 +189,7 @@ TEST_F( ComponentSelectorTest, InterfacedObjects )
 TEST_F( ComponentSelectorTest, UnknownComponent )
 {
   // Fill our component database with some components
-  auto componentSelector = std::make_shared< ComponentSelector< BigComponentList >>( "nameless", *( new LoggerImpl() ) );
+  auto componentSelector = std::make_shared< ComponentSelector >( "nameless", *( new LoggerImpl() ), ComponentRegistry::Get< BigComponentList >().GetCompatibilityTable() );
 
   // Setup the criterion for a component that does not exist in our data base
   CriterionType criterion( { "NameOfClass", { "DoYouHaveThisComponent?" } } );
@@ -167,4 +201,70 @@ TEST_F( ComponentSelectorTest, UnknownComponent )
   EXPECT_TRUE( componentSelector->NumberOfComponents() == 0 );
   EXPECT_FALSE( componentSelector->GetComponent() );
 }
+
+TEST_F( ComponentSelectorTest, RegisteredComponents )
+{
+  // Components can be registered in several steps, e.g. by each module. Registering a component twice has no effect.
+  ComponentRegistry registry;
+  registry.RegisterComponents< SmallComponentList >();
+  auto smallCompatibilityTable = registry.GetCompatibilityTable();
+  EXPECT_EQ( smallCompatibilityTable->GetNumberOfComponents(), 2 );
+
+  registry.RegisterComponents< BigComponentList >();
+  registry.Register< TransformComponent1 >();
+  EXPECT_EQ( registry.GetNumberOfComponents(), 6 );
+  EXPECT_NE( registry.GetCompatibilityTable(), smallCompatibilityTable );
+  EXPECT_EQ( registry.GetCompatibilityTable(), registry.GetCompatibilityTable() );
+
+  auto componentSelector = std::make_shared< ComponentSelector >( "nameless", *( new LoggerImpl() ), registry.GetCompatibilityTable() );
+  componentSelector->AddProvidingInterfaceCriteria( { { "NameOfInterface", "MetricDerivativeInterface" } } );
+  ComponentType::Pointer component;
+  EXPECT_NO_THROW( component = componentSelector->GetComponent() );
+  EXPECT_TRUE( component->MeetsCriterion( { "NameOfClass", { "SSDMetric3rdPartyComponent" } } ) );
+}
+
+TEST_F( ComponentSelectorTest, LowestCostAssignment )
+{
+  ComponentRegistry registry;
+  registry.RegisterComponents< BigComponentList >();
+  auto compatibilityTable = registry.GetCompatibilityTable();
+
+  auto getId = [ & ]( const ComponentDescriptor & descriptor ){
+      for( InterfaceCompatibilityTable::ComponentIdType id = 0; id < compatibilityTable->GetNumberOfComponents(); ++id )
+      {
+        if( &compatibilityTable->GetDescriptor( id ) == &descriptor )
+        {
+          return id;
+        }
+      }
+      return compatibilityTable->GetNumberOfComponents();
+    };
+  const auto metric3p    = getId( ComponentDescriptor::Get< SSDMetric3rdPartyComponent >() );
+  const auto metric4p    = getId( ComponentDescriptor::Get< SSDMetric4thPartyComponent >() );
+  const auto optimizer3p = getId( ComponentDescriptor::Get< GDOptimizer3rdPartyComponent >() );
+  const auto optimizer4p = getId( ComponentDescriptor::Get< GDOptimizer4thPartyComponent >() );
+
+  // All four combinations can be connected by the MetricValueInterface
+  ConnectionConstraintSolver solver( *compatibilityTable );
+  auto                       metric    = solver.AddNode( { metric3p, metric4p } );
+  auto                       optimizer = solver.AddNode( { optimizer3p, optimizer4p } );
+  solver.AddConnection( metric, optimizer, { { "NameOfInterface", "MetricValueInterface" } } );
+  ASSERT_TRUE( solver.Solve() );
+  EXPECT_EQ( solver.GetDomainSize( metric ), 2 );
+  EXPECT_EQ( solver.GetDomainSize( optimizer ), 2 );
+
+  ConnectionConstraintSolver::CostsType costs( compatibilityTable->GetNumberOfComponents(), 1.0 );
+  costs[ metric4p ]    = 3.0;
+  costs[ optimizer3p ] = 2.0;
+
+  // Only the selected nodes are restricted
+  ConnectionConstraintSolver optimizerSolver = solver;
+  EXPECT_TRUE( optimizerSolver.SelectLowestCost( { optimizer }, costs ) );
+  EXPECT_EQ( optimizerSolver.GetComponentIds( optimizer ), ConnectionConstraintSolver::ComponentIdsType( { optimizer4p } ) );
+  EXPECT_EQ( optimizerSolver.GetDomainSize( metric ), 2 );
+
+  EXPECT_TRUE( solver.SelectLowestCost( { metric, optimizer }, costs ) );
+  EXPECT_EQ( solver.GetComponentIds( metric ), ConnectionConstraintSolver::ComponentIdsType( { metric3p } ) );
+  EXPECT_EQ( solver.GetComponentIds( optimizer ), ConnectionConstraintSolver::ComponentIdsType( { optimizer4p } ) );
+}
 } // namespace selx
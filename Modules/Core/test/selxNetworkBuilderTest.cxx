@@ -22,6 +22,7 @@
 
 #include "selxTransformComponent1.h"
 #include "selxMetricComponent1.h"
+#include "selxUpdateComponent1.h"
 #include "selxGDOptimizer3rdPartyComponent.h"
 #include "selxGDOptimizer4thPartyComponent.h"
 #include "selxSSDMetric3rdPartyComponent.h"
@@ -31,6 +32,13 @@
 
 #include "gtest/gtest.h"
 
+#include <boost/filesystem.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <thread>
+
 namespace selx
 {
 class NetworkBuilderTest : public ::testing::Test
@@ -77,14 +85,24 @@ public:
   LoggerImpl * logger = new LoggerImpl();
 };
 
+// Exposes the selected components of a NetworkBuilder
+class InspectableNetworkBuilder : public NetworkBuilder
+{
+public:
+
+  using NetworkBuilder::NetworkBuilder;
+  ComponentBase::Pointer GetComponent( const ComponentNameType & name ) { return this->m_ComponentSelectorContainer[ name ]->GetComponent(); }
+  std::size_t GetNumberOfComponents() const { return this->m_ComponentSelectorContainer.size(); }
+};
+
 TEST_F( NetworkBuilderTest, Create )
 {
-  NetworkBuilderPointer networkBuilderA = NetworkBuilderPointer( new NetworkBuilder< CustomComponentList >( *logger, *blueprint ) );
+  NetworkBuilderPointer networkBuilderA = NetworkBuilderPointer( new NetworkBuilder( *logger, *blueprint, ComponentRegistry::Get< CustomComponentList >() ) );
 }
 
 TEST_F( NetworkBuilderTest, Configure )
 {
-  NetworkBuilderPointer networkBuilder = NetworkBuilderPointer( new NetworkBuilder< CustomComponentList >( *logger, *blueprint ) );
+  NetworkBuilderPointer networkBuilder = NetworkBuilderPointer( new NetworkBuilder( *logger, *blueprint, ComponentRegistry::Get< CustomComponentList >() ) );
 
   bool allUniqueComponents;
   EXPECT_NO_THROW( allUniqueComponents = networkBuilder->Configure() );
@@ -93,11 +111,765 @@ TEST_F( NetworkBuilderTest, Configure )
 
 TEST_F( NetworkBuilderTest, Connect )
 {
-  NetworkBuilderPointer networkBuilder = NetworkBuilderPointer( new NetworkBuilder< CustomComponentList >( *logger, *blueprint ) );
+  NetworkBuilderPointer networkBuilder = NetworkBuilderPointer( new NetworkBuilder( *logger, *blueprint, ComponentRegistry::Get< CustomComponentList >() ) );
   EXPECT_NO_THROW( bool allUniqueComponents = networkBuilder->Configure() );
   bool success;
   EXPECT_NO_THROW( success = networkBuilder->ConnectComponents() );
 }
+
+TEST_F( NetworkBuilderTest, ConfigureByNonUniqueConnections )
+{
+  // Without GDOptimizer4thPartyComponent, the chain Transform -> Metric -> Optimizer can be deduced from handshakes alone, although
+  // after applying the component and connection criteria none of the components is uniquely selected.
+  using ComponentList = TypeList< TransformComponent1, MetricComponent1, GDOptimizer3rdPartyComponent, SSDMetric3rdPartyComponent,
+    SSDMetric4thPartyComponent >;
+
+  BlueprintPointer blueprint = BlueprintPointer( new BlueprintImpl( *logger ) );
+  blueprint->SetComponent( "Transform", {} );
+  blueprint->SetComponent( "Metric", {} );
+  blueprint->SetComponent( "Optimizer", {} );
+  blueprint->SetConnection( "Transform", "Metric", {}, "" );
+  blueprint->SetConnection( "Metric", "Optimizer", {}, "" );
+
+  NetworkBuilderPointer networkBuilder = NetworkBuilderPointer( new NetworkBuilder( *logger, *blueprint, ComponentRegistry::Get< ComponentList >() ) );
+  bool allUniqueComponents;
+  EXPECT_NO_THROW( allUniqueComponents = networkBuilder->Configure() );
+  EXPECT_TRUE( allUniqueComponents );
+  bool success;
+  EXPECT_NO_THROW( success = networkBuilder->ConnectComponents() );
+  EXPECT_TRUE( success );
+}
+TEST_F( NetworkBuilderTest, SelectionPolicy )
+{
+  // Both GDOptimizer3rdPartyComponent and GDOptimizer4thPartyComponent accept the MetricValueInterface of the Metric
+  BlueprintPointer blueprint = BlueprintPointer( new BlueprintImpl( *logger ) );
+  blueprint->SetComponent( "Metric", { { "NameOfClass", { "SSDMetric4thPartyComponent" } } } );
+  blueprint->SetComponent( "Optimizer", {} );
+  blueprint->SetConnection( "Metric", "Optimizer", { { "NameOfInterface", { "MetricValueInterface" } } }, "" );
+
+  NetworkBuilder uniqueNetworkBuilder( *logger, *blueprint, ComponentRegistry::Get< CustomComponentList >() );
+  EXPECT_FALSE( uniqueNetworkBuilder.Configure() );
+
+  blueprint->SetComponent( "Optimizer", { { "SelectionPolicy", { "LowestCost" } } } );
+  NetworkBuilder lowestCostNetworkBuilder( *logger, *blueprint, ComponentRegistry::Get< CustomComponentList >() );
+  EXPECT_TRUE( lowestCostNetworkBuilder.Configure() );
+  EXPECT_TRUE( lowestCostNetworkBuilder.ConnectComponents() );
+
+  blueprint->SetComponent( "Optimizer", { { "SelectionPolicy", { "Cheapest" } } } );
+  NetworkBuilder unknownPolicyNetworkBuilder( *logger, *blueprint, ComponentRegistry::Get< CustomComponentList >() );
+  EXPECT_THROW( unknownPolicyNetworkBuilder.Configure(), std::runtime_error );
+}
+
+TEST_F( NetworkBuilderTest, ConflictingConnections )
+{
+  // MetricComponent1 is the only component accepting from TransformComponent1, but it does not provide the
+  // MetricDerivativeInterface the optimizer requires.
+  BlueprintPointer blueprint = BlueprintPointer( new BlueprintImpl( *logger ) );
+  blueprint->SetComponent( "Transform", { { "NameOfClass", { "TransformComponent1" } } } );
+  blueprint->SetComponent( "Metric", {} );
+  blueprint->SetComponent( "Optimizer", {} );
+  blueprint->SetConnection( "Transform", "Metric", {}, "" );
+  blueprint->SetConnection( "Metric", "Optimizer", { { "NameOfInterface", { "MetricDerivativeInterface" } } }, "" );
+
+  NetworkBuilderPointer networkBuilder = NetworkBuilderPointer( new NetworkBuilder( *logger, *blueprint, ComponentRegistry::Get< CustomComponentList >() ) );
+  EXPECT_THROW( networkBuilder->Configure(), std::runtime_error );
+}
+
+TEST_F( NetworkBuilderTest, CachedConfiguration )
+{
+  using ComponentList = TypeList< TransformComponent1, MetricComponent1, GDOptimizer3rdPartyComponent, SSDMetric3rdPartyComponent >;
+  ComponentAssignmentCache & cache = ComponentRegistry::Get< ComponentList >().GetComponentAssignmentCache();
+  cache.Clear();
+
+  NetworkBuilderPointer networkBuilder = NetworkBuilderPointer( new NetworkBuilder( *logger, *blueprint, ComponentRegistry::Get< ComponentList >() ) );
+  EXPECT_TRUE( networkBuilder->Configure() );
+  EXPECT_EQ( cache.Size(), 1 );
+
+  // The same blueprint, composed in a different order, is configured from the cache.
+  BlueprintPointer sameBlueprint = BlueprintPointer( new BlueprintImpl( *logger ) );
+  sameBlueprint->SetComponent( "Transform", { { "NameOfClass", { "TransformComponent1" } } } );
+  sameBlueprint->SetComponent( "Metric", { { "NameOfClass", { "MetricComponent1" } } } );
+  sameBlueprint->SetConnection( "Transform", "Metric", { { "NameOfInterface", { "TransformedImageInterface" } } }, "" );
+  EXPECT_EQ( ComponentAssignmentCache::GetKey( *blueprint ), ComponentAssignmentCache::GetKey( *sameBlueprint ) );
+
+  NetworkBuilderPointer cachedNetworkBuilder = NetworkBuilderPointer( new NetworkBuilder( *logger, *sameBlueprint, ComponentRegistry::Get< ComponentList >() ) );
+  EXPECT_TRUE( cachedNetworkBuilder->Configure() );
+  EXPECT_TRUE( cachedNetworkBuilder->ConnectComponents() );
+  EXPECT_EQ( cache.Size(), 1 );
+
+  // A blueprint with different properties is not.
+  sameBlueprint->SetConnection( "Transform", "Metric", { { "NameOfInterface", { "MetricValueInterface" } } }, "" );
+  EXPECT_NE( ComponentAssignmentCache::GetKey( *blueprint ), ComponentAssignmentCache::GetKey( *sameBlueprint ) );
+
+  // The key is a digest of fixed size, and the least recently used assignments are removed beyond the capacity
+  EXPECT_EQ( ComponentAssignmentCache::GetKey( *blueprint ).size(), 16 );
+  cache.SetCapacity( 2 );
+  ComponentAssignmentCache::ComponentAssignmentType componentAssignment;
+  cache.Insert( ComponentAssignmentCache::GetKey( *sameBlueprint ), componentAssignment );
+  EXPECT_TRUE( cache.Find( ComponentAssignmentCache::GetKey( *blueprint ), componentAssignment ) );
+  cache.Insert( "Another", componentAssignment );
+  EXPECT_EQ( cache.Size(), 2 );
+  EXPECT_TRUE( cache.Find( ComponentAssignmentCache::GetKey( *blueprint ), componentAssignment ) );
+  EXPECT_FALSE( cache.Find( ComponentAssignmentCache::GetKey( *sameBlueprint ), componentAssignment ) );
+  cache.SetCapacity( ComponentAssignmentCache::DefaultCapacity );
+}
+
+TEST_F( NetworkBuilderTest, ReconfigureModifiedBlueprint )
+{
+  InspectableNetworkBuilder networkBuilder( *logger, *blueprint, ComponentRegistry::Get< CustomComponentList >() );
+  EXPECT_TRUE( networkBuilder.Configure() );
+  EXPECT_TRUE( networkBuilder.ConnectComponents() );
+  ComponentBase::Pointer transform = networkBuilder.GetComponent( "Transform" );
+  ComponentBase::Pointer metric    = networkBuilder.GetComponent( "Metric" );
+
+  // Setting the same parameters does not modify the blueprint
+  blueprint->SetComponent( "Metric", { { "NameOfClass", { "MetricComponent1" } } } );
+  EXPECT_TRUE( networkBuilder.Configure() );
+  EXPECT_EQ( networkBuilder.GetComponent( "Metric" ), metric );
+
+  // Only the modified component is selected and connected anew, the component is deduced from its connection
+  blueprint->SetComponent( "Metric", {} );
+  EXPECT_TRUE( networkBuilder.Configure() );
+  EXPECT_TRUE( networkBuilder.ConnectComponents() );
+  EXPECT_TRUE( networkBuilder.CheckConnectionsSatisfied() );
+  EXPECT_EQ( networkBuilder.GetComponent( "Transform" ), transform );
+  EXPECT_NE( networkBuilder.GetComponent( "Metric" ), metric );
+}
+
+TEST_F( NetworkBuilderTest, ReconfigureDeletedConnection )
+{
+  InspectableNetworkBuilder networkBuilder( *logger, *blueprint, ComponentRegistry::Get< CustomComponentList >() );
+  EXPECT_TRUE( networkBuilder.Configure() );
+  EXPECT_TRUE( networkBuilder.ConnectComponents() );
+  EXPECT_TRUE( networkBuilder.CheckConnectionsSatisfied() );
+  ComponentBase::Pointer metric = networkBuilder.GetComponent( "Metric" );
+
+  // The metric accepted the deleted connection, it is selected anew and misses its transformed image
+  blueprint->DeleteConnection( "Transform", "Metric", "" );
+  EXPECT_TRUE( networkBuilder.Configure() );
+  EXPECT_TRUE( networkBuilder.ConnectComponents() );
+  EXPECT_FALSE( networkBuilder.CheckConnectionsSatisfied() );
+  EXPECT_NE( networkBuilder.GetComponent( "Metric" ), metric );
+
+  blueprint->SetConnection( "Transform", "Metric", { { "NameOfInterface", { "TransformedImageInterface" } } }, "" );
+  EXPECT_TRUE( networkBuilder.Configure() );
+  EXPECT_TRUE( networkBuilder.ConnectComponents() );
+  EXPECT_TRUE( networkBuilder.CheckConnectionsSatisfied() );
+  metric = networkBuilder.GetComponent( "Metric" );
+
+  // Deleting the upstream component deletes its connection too
+  blueprint->DeleteComponent( "Transform" );
+  EXPECT_TRUE( networkBuilder.Configure() );
+  EXPECT_TRUE( networkBuilder.ConnectComponents() );
+  EXPECT_FALSE( networkBuilder.CheckConnectionsSatisfied() );
+  EXPECT_NE( networkBuilder.GetComponent( "Metric" ), metric );
+  EXPECT_EQ( 1u, networkBuilder.GetNumberOfComponents() );
+}
+
+TEST_F( NetworkBuilderTest, ReplicateSubgraph )
+{
+  // Each replica of the Metric is connected to the shared Transform
+  blueprint->SetReplication( "Batch", { "Metric" }, 3 );
+  InspectableNetworkBuilder networkBuilder( *logger, *blueprint, ComponentRegistry::Get< CustomComponentList >() );
+  EXPECT_TRUE( networkBuilder.Configure() );
+  EXPECT_TRUE( networkBuilder.ConnectComponents() );
+  EXPECT_TRUE( networkBuilder.CheckConnectionsSatisfied() );
+  EXPECT_EQ( networkBuilder.GetNumberOfComponents(), 4 );
+  ComponentBase::Pointer transform = networkBuilder.GetComponent( "Transform" );
+  ComponentBase::Pointer metric1   = networkBuilder.GetComponent( "Metric_1" );
+  EXPECT_NE( networkBuilder.GetComponent( "Metric_0" ), metric1 );
+
+  // Adding a replica keeps the existing replicas
+  blueprint->SetReplication( "Batch", { "Metric" }, 4 );
+  EXPECT_TRUE( networkBuilder.Configure() );
+  EXPECT_TRUE( networkBuilder.ConnectComponents() );
+  EXPECT_EQ( networkBuilder.GetNumberOfComponents(), 5 );
+  EXPECT_EQ( networkBuilder.GetComponent( "Transform" ), transform );
+  EXPECT_EQ( networkBuilder.GetComponent( "Metric_1" ), metric1 );
+
+  // Removing replicas
+  blueprint->SetReplication( "Batch", { "Metric" }, 2 );
+  EXPECT_TRUE( networkBuilder.Configure() );
+  EXPECT_TRUE( networkBuilder.ConnectComponents() );
+  EXPECT_EQ( networkBuilder.GetNumberOfComponents(), 3 );
+
+  // The connection from the Transform to the Metric would leave the replication
+  blueprint->SetReplication( "Batch", { "Transform" }, 2 );
+  EXPECT_FALSE( networkBuilder.Configure() );
+}
+
+
+TEST_F( NetworkBuilderTest, DerivedDataCache )
+{
+  DerivedDataCache cache;
+  itk::DataObject::Pointer source = itk::DataObject::New();
+  unsigned int numberOfComputations = 0;
+  auto compute = [ &numberOfComputations ]() { ++numberOfComputations; return itk::DataObject::New(); };
+
+  auto shrunk = cache.Get< itk::DataObject >( source, "Shrink", { "2" }, compute );
+  EXPECT_EQ( cache.Get< itk::DataObject >( source, "Shrink", { "2" }, compute ), shrunk );
+  EXPECT_NE( cache.Get< itk::DataObject >( source, "Shrink", { "4" }, compute ), shrunk );
+  EXPECT_EQ( numberOfComputations, 2 );
+  EXPECT_EQ( cache.GetNumberOfHits(), 1 );
+
+  // Data derived from a modified source is computed anew, and replaces the data derived from the source before. The
+  // data derived from other sources is kept.
+  itk::DataObject::Pointer anotherSource = itk::DataObject::New();
+  cache.Get< itk::DataObject >( anotherSource, "Shrink", { "2" }, compute );
+  source->Modified();
+  EXPECT_NE( cache.Get< itk::DataObject >( source, "Shrink", { "2" }, compute ), shrunk );
+  EXPECT_EQ( numberOfComputations, 4 );
+  EXPECT_EQ( cache.GetNumberOfEntries(), 2 );
+
+  // Failed computations are not cached
+  EXPECT_THROW( cache.GetOrCompute( source, "Smooth", {}, []() -> itk::DataObject::Pointer { throw std::runtime_error( "" ); } ),
+    std::runtime_error );
+  EXPECT_EQ( cache.GetNumberOfEntries(), 2 );
+
+  // Concurrent requests wait for a single computation
+  std::vector< std::thread > threads;
+  std::vector< itk::DataObject::Pointer > smoothed( 4 );
+  for( std::size_t index = 0; index < smoothed.size(); ++index )
+  {
+    threads.emplace_back( [ &, index ]() {
+      smoothed[ index ] = cache.GetOrCompute( source, "Smooth", {}, [ & ]() -> itk::DataObject::Pointer {
+        std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+        return compute();
+      } );
+    } );
+  }
+  for( auto & thread : threads )
+  {
+    thread.join();
+  }
+  EXPECT_EQ( numberOfComputations, 5 );
+  EXPECT_EQ( smoothed[ 0 ], smoothed[ 3 ] );
+
+  // The components of a network share a cache
+  InspectableNetworkBuilder networkBuilder( *logger, *blueprint, ComponentRegistry::Get< CustomComponentList >() );
+  EXPECT_TRUE( networkBuilder.Configure() );
+  EXPECT_NE( networkBuilder.GetComponent( "Transform" )->m_DerivedDataCache, networkBuilder.GetComponent( "Metric" )->m_DerivedDataCache );
+  EXPECT_TRUE( networkBuilder.ConnectComponents() );
+  EXPECT_EQ( networkBuilder.GetComponent( "Transform" )->m_DerivedDataCache, networkBuilder.GetComponent( "Metric" )->m_DerivedDataCache );
+}
+
+
+TEST_F( NetworkBuilderTest, ConfigureBenchmark )
+{
+  // Microbenchmark of the component selection: 25 pairs of a Transform with a given class and a Metric that is deduced
+  // from its connection, configured without the ComponentAssignmentCache.
+  using ComponentList = TypeList< TransformComponent1, MetricComponent1, GDOptimizer3rdPartyComponent, SSDMetric3rdPartyComponent,
+    SSDMetric4thPartyComponent >;
+  const int numberOfPairs = 25;
+  const int numberOfRuns  = 20;
+
+  logger->SetLogLevel( LogLevel::OFF );
+  BlueprintPointer blueprint = BlueprintPointer( new BlueprintImpl( *logger ) );
+  for( int i = 0; i < numberOfPairs; ++i )
+  {
+    const std::string transform = "Transform" + std::to_string( i );
+    const std::string metric    = "Metric" + std::to_string( i );
+    blueprint->SetComponent( transform, { { "NameOfClass", { "TransformComponent1" } } } );
+    blueprint->SetComponent( metric, {} );
+    blueprint->SetConnection( transform, metric, { { "NameOfInterface", { "TransformedImageInterface" } } }, "" );
+  }
+
+  ComponentRegistry & registry = ComponentRegistry::Get< ComponentList >();
+  std::chrono::duration< double, std::milli > duration( 0 );
+  for( int run = 0; run < numberOfRuns; ++run )
+  {
+    registry.GetComponentAssignmentCache().Clear();
+    NetworkBuilder networkBuilder( *logger, *blueprint, registry );
+    const auto     start = std::chrono::steady_clock::now();
+    EXPECT_TRUE( networkBuilder.Configure() );
+    duration += std::chrono::steady_clock::now() - start;
+  }
+  // Reported in the xml output of the test, e.g. by --gtest_output=xml, rather than on the console
+  RecordProperty( "ConfigureMilliseconds", std::to_string( duration.count() / numberOfRuns ) );
+}
+
+TEST_F( NetworkBuilderTest, RebindNetworkInputs )
+{
+  // A minimal Source Component that runs its mini pipeline on Update: the output is its last input.
+  class PassThroughSource : public SourceInterface, public UpdateInterface
+  {
+  public:
+
+    void SetMiniPipelineInput( itk::DataObject::Pointer input ) override { this->m_Input = input; }
+    AnyFileReader::Pointer GetInputFileReader() override { return nullptr; }
+    void Update() override { this->m_Output = this->m_Input; }
+    const std::string GetComponentName() override { return "Source"; }
+    void SetNumberOfThreads( unsigned int ) override {}
+
+    itk::DataObject::Pointer m_Input;
+    itk::DataObject::Pointer m_Output;
+  };
+
+  auto source = std::make_shared< PassThroughSource >();
+  NetworkContainer network( {}, { source }, {}, { { "Source", source } } );
+  EXPECT_EQ( network.GetInputNames(), std::vector< std::string >( { "Source" } ) );
+
+  // The same realized network is executed on each new input.
+  for( int i = 0; i < 3; ++i )
+  {
+    itk::DataObject::Pointer input = itk::DataObject::New();
+    network.SetInput( "Source", input );
+    network.Execute();
+    EXPECT_EQ( source->m_Output, input );
+  }
+
+  EXPECT_THROW( network.SetInput( "UnknownSource", itk::DataObject::New() ), std::runtime_error );
+}
+
+TEST_F( NetworkBuilderTest, ScheduleUpdates )
+{
+  // Records the order in which the updates finished and the number of threads it was given.
+  class RecordingUpdate : public UpdateInterface
+  {
+  public:
+
+    RecordingUpdate( std::size_t id, std::vector< std::size_t > & finished, std::mutex & mutex ) :
+      m_Id( id ), m_Finished( finished ), m_Mutex( mutex ), m_NumberOfThreads( 0 ) {}
+    void Update() override
+    {
+      if( this->m_Id == 3 && this->m_Throw )
+      {
+        throw std::runtime_error( "Update failed" );
+      }
+      std::lock_guard< std::mutex > lock( this->m_Mutex );
+      this->m_Finished.push_back( this->m_Id );
+    }
+    const std::string GetComponentName() override { return std::to_string( this->m_Id ); }
+    void SetNumberOfThreads( unsigned int numberOfThreads ) override { this->m_NumberOfThreads = numberOfThreads; }
+
+    std::size_t                  m_Id;
+    std::vector< std::size_t > & m_Finished;
+    std::mutex &                 m_Mutex;
+    unsigned int                 m_NumberOfThreads;
+    bool                         m_Throw = false;
+  };
+
+  // Diamond: 0 -> { 1, 2, 3 } -> 4
+  std::vector< std::size_t > finished;
+  std::mutex                 mutex;
+  UpdateScheduler::UpdateOrderType updateOrder;
+  std::vector< std::shared_ptr< RecordingUpdate >> updates;
+  for( std::size_t id = 0; id < 5; ++id )
+  {
+    updates.push_back( std::make_shared< RecordingUpdate >( id, finished, mutex ) );
+    updateOrder.push_back( updates.back() );
+  }
+  NetworkContainer::DependenciesType dependencies = { {}, { 0 }, { 0 }, { 0 }, { 1, 2, 3 } };
+
+  NetworkContainer network( {}, updateOrder, {}, {}, dependencies );
+  network.SetNumberOfThreads( 6 );
+  for( int run = 0; run < 20; ++run )
+  {
+    finished.clear();
+    network.Execute();
+    ASSERT_EQ( finished.size(), 5 );
+    EXPECT_EQ( finished.front(), 0 );
+    EXPECT_EQ( finished.back(), 4 );
+  }
+  // 3 branches run side by side, each with 6 / 3 threads
+  EXPECT_EQ( UpdateScheduler( updateOrder, dependencies ).GetMaximumConcurrency(), 3 );
+  EXPECT_EQ( updates[ 1 ]->m_NumberOfThreads, 2 );
+
+  // The first exception is rethrown and the downstream update is not run
+  updates[ 3 ]->m_Throw = true;
+  finished.clear();
+  EXPECT_THROW( network.Execute(), std::runtime_error );
+  EXPECT_EQ( std::count( finished.begin(), finished.end(), 4 ), 0 );
+
+  // Dependencies must refer to earlier updates
+  EXPECT_THROW( UpdateScheduler( updateOrder, { { 1 }, {}, {}, {}, {} } ), std::runtime_error );
+}
+
+TEST_F( NetworkBuilderTest, StopAfterFailedUpdate )
+{
+  class FunctionUpdate : public UpdateInterface
+  {
+  public:
+
+    FunctionUpdate( std::function< void() > function ) : m_Function( function ) {}
+    void Update() override { this->m_Function(); }
+    const std::string GetComponentName() override { return "FunctionUpdate"; }
+    void SetNumberOfThreads( unsigned int ) override {}
+
+    std::function< void() > m_Function;
+  };
+
+  // Waits at most a few seconds, such that a broken scheduler fails the test rather than hanging it
+  auto waitFor = []( const std::atomic< bool > & flag ) {
+      for( int i = 0; i < 1000 && !flag; ++i )
+      {
+        std::this_thread::sleep_for( std::chrono::milliseconds( 5 ) );
+      }
+    };
+
+  // Update 0 throws while the independent branch 1 -> 2 is running. Update 2 becomes ready after the throw and must
+  // not be run.
+  std::atomic< bool > isStarted( false );
+  std::atomic< bool > isThrown( false );
+  std::atomic< bool > isRun( false );
+  UpdateScheduler::UpdateOrderType updateOrder = {
+    std::make_shared< FunctionUpdate >( [ & ]() {
+        waitFor( isStarted );
+        isThrown = true;
+        throw std::runtime_error( "Update failed" );
+      } ),
+    std::make_shared< FunctionUpdate >( [ & ]() {
+        isStarted = true;
+        waitFor( isThrown );
+        std::this_thread::sleep_for( std::chrono::milliseconds( 100 ) );
+      } ),
+    std::make_shared< FunctionUpdate >( [ & ]() { isRun = true; } )
+  };
+
+  UpdateScheduler scheduler( updateOrder, { {}, {}, { 1 } } );
+  EXPECT_THROW( scheduler.Execute( 2 ), std::runtime_error );
+  EXPECT_TRUE( isThrown );
+  EXPECT_FALSE( isRun );
+
+  // Likewise, no update is started once the network is cancelled
+  isRun = false;
+  auto cancellationToken = std::make_shared< CancellationToken >();
+  cancellationToken->Cancel();
+  scheduler.SetCancellationToken( cancellationToken );
+  EXPECT_THROW( scheduler.Execute( 2 ), CancellationToken::CancelledError );
+  EXPECT_FALSE( isRun );
+}
+
+TEST_F( NetworkBuilderTest, SerializeSharedPipelines )
+{
+  // Source -> { A, B } and Other -> C, where Source and Other are itk pipeline stages pulled by the updates downstream
+  BlueprintPointer sharedBlueprint = BlueprintPointer( new BlueprintImpl( *logger ) );
+  sharedBlueprint->SetComponent( "Source", { { "NameOfClass", { "TransformComponent1" } } } );
+  sharedBlueprint->SetComponent( "Other", { { "NameOfClass", { "TransformComponent1" } } } );
+  for( const std::string name : { "A", "B", "C" } )
+  {
+    sharedBlueprint->SetComponent( name, { { "NameOfClass", { "UpdateComponent1" } } } );
+  }
+  sharedBlueprint->SetConnection( "Source", "A", { { "NameOfInterface", { "TransformedImageInterface" } } }, "" );
+  sharedBlueprint->SetConnection( "Source", "B", { { "NameOfInterface", { "TransformedImageInterface" } } }, "" );
+  sharedBlueprint->SetConnection( "Other", "C", { { "NameOfInterface", { "TransformedImageInterface" } } }, "" );
+
+  using UpdateComponentList = TypeList< TransformComponent1, UpdateComponent1 >;
+  NetworkBuilderPointer networkBuilder = NetworkBuilderPointer( new NetworkBuilder( *logger, *sharedBlueprint, ComponentRegistry::Get< UpdateComponentList >() ) );
+  EXPECT_TRUE( networkBuilder->Configure() );
+  EXPECT_TRUE( networkBuilder->ConnectComponents() );
+  NetworkContainer network = networkBuilder->GetRealizedNetwork();
+
+  // A and B share Source and run one after another, beside C
+  network.SetNumberOfThreads( 3 );
+  EXPECT_EQ( network.GetPlanReport().maximumConcurrency, 2 );
+  EXPECT_NO_THROW( network.Execute() );
+}
+
+TEST_F( NetworkBuilderTest, NumberOfThreads )
+{
+  // NumberOfThreads is supported by all components, without affecting the selection.
+  blueprint->SetComponent( "Metric", { { "NameOfClass", { "MetricComponent1" } }, { "NumberOfThreads", { "3" } } } );
+  NetworkBuilderPointer networkBuilder = NetworkBuilderPointer( new NetworkBuilder( *logger, *blueprint, ComponentRegistry::Get< CustomComponentList >() ) );
+  EXPECT_TRUE( networkBuilder->Configure() );
+  EXPECT_TRUE( networkBuilder->ConnectComponents() );
+  EXPECT_NO_THROW( networkBuilder->GetRealizedNetwork() );
+
+  for( const auto & invalidValue : std::vector< ParameterValueType >( { { "0" }, { "two" }, { "1", "2" } } ) )
+  {
+    blueprint->SetComponent( "Metric", { { "NameOfClass", { "MetricComponent1" } }, { "NumberOfThreads", invalidValue } } );
+    NetworkBuilderPointer invalidNetworkBuilder = NetworkBuilderPointer( new NetworkBuilder( *logger, *blueprint, ComponentRegistry::Get< CustomComponentList >() ) );
+    EXPECT_THROW( invalidNetworkBuilder->Configure(), std::runtime_error );
+  }
+
+  // The criterion takes precedence over the share of the threads of the network
+  TransformComponent1 component( "Transform", *logger );
+  component.SetNumberOfThreads( 2 );
+  EXPECT_EQ( component.m_NumberOfThreads, 2 );
+  component.m_NumberOfThreadsCriterion = 3;
+  component.SetNumberOfThreads( 2 );
+  EXPECT_EQ( component.m_NumberOfThreads, 3 );
+}
+
+TEST_F( NetworkBuilderTest, Deterministic )
+{
+  auto component = std::make_shared< TransformComponent1 >( "Transform", *logger );
+  NetworkContainer network( { component }, {}, {} );
+
+  // By default the seeds are left to the backends
+  network.Execute();
+  EXPECT_EQ( component->m_RandomSeed, 0 );
+  EXPECT_FALSE( component->m_IsDeterministic );
+
+  // A deterministic network seeds all components, by default with the same seed on each run
+  network.SetDeterministic( true );
+  network.Execute();
+  EXPECT_EQ( component->m_RandomSeed, NetworkContainer::DefaultRandomSeed );
+  EXPECT_TRUE( component->m_IsDeterministic );
+
+  network.SetRandomSeed( 42 );
+  network.Execute();
+  EXPECT_EQ( component->m_RandomSeed, 42 );
+
+  // A seed alone does not avoid multithreading
+  network.SetDeterministic( false );
+  network.Execute();
+  EXPECT_EQ( component->m_RandomSeed, 42 );
+  EXPECT_FALSE( component->m_IsDeterministic );
+}
+
+TEST_F( NetworkBuilderTest, MemoryPlanner )
+{
+  // A -> B -> C, where C is updated at the last step and A is an itk pipeline pulled by B.
+  auto a = std::make_shared< UpdateComponent1 >( "A", *logger );
+  auto b = std::make_shared< UpdateComponent1 >( "B", *logger );
+  auto c = std::make_shared< UpdateComponent1 >( "C", *logger );
+  a->m_OutputMemorySize = 100;
+  b->m_OutputMemorySize = 10;
+  c->m_OutputMemorySize = 1;
+  MemoryPlanner memoryPlanner( 2 );
+  memoryPlanner.AddComponent( a, 0, { 0 }, true );
+  memoryPlanner.AddComponent( b, 0, { 1 }, true );
+  memoryPlanner.AddComponent( c, 1, {}, true );
+
+  // A is released before C is produced
+  EXPECT_EQ( memoryPlanner.GetEstimatedPeakMemorySize(), 110 );
+  EXPECT_EQ( memoryPlanner.GetEstimatedPeakMemorySize( false ), 111 );
+
+  auto d = std::make_shared< UpdateComponent1 >( "D", *logger );
+  d->m_OutputMemorySize = 1000;
+  memoryPlanner.AddComponent( d, 1, { 1 }, false );
+  EXPECT_EQ( memoryPlanner.GetEstimatedPeakMemorySize(), 1011 );
+  EXPECT_EQ( memoryPlanner.GetEstimatedPeakMemorySize( false ), 1111 );
+
+  // Data is released once, after its last consumer, on each execution
+  for( unsigned int execution = 1; execution <= 2; ++execution )
+  {
+    memoryPlanner.Reset();
+    memoryPlanner.UpdateFinished( 0 );
+    EXPECT_EQ( a->m_NumberOfReleases, execution );
+    EXPECT_EQ( b->m_NumberOfReleases, execution - 1 );
+    memoryPlanner.UpdateFinished( 1 );
+    EXPECT_EQ( b->m_NumberOfReleases, execution );
+    EXPECT_EQ( c->m_NumberOfReleases, 0 );
+  }
+}
+
+TEST_F( NetworkBuilderTest, Checkpoint )
+{
+  const boost::filesystem::path directory = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+
+  // A -> B, where B is interrupted the first time
+  auto a = std::make_shared< UpdateComponent1 >( "A", *logger );
+  auto b = std::make_shared< UpdateComponent1 >( "B", *logger );
+  NetworkContainer network( { a, b }, { a, b }, {}, {}, {}, nullptr, "Blueprint" );
+  network.SetCheckpoint( directory.string(), "Inputs" );
+  b->m_Throw = true;
+  EXPECT_THROW( network.Execute(), std::runtime_error );
+  EXPECT_EQ( a->m_NumberOfUpdates, 1 );
+
+  // Resuming, with a new network of new components, restores A and updates only B
+  auto resumedA = std::make_shared< UpdateComponent1 >( "A", *logger );
+  auto resumedB = std::make_shared< UpdateComponent1 >( "B", *logger );
+  NetworkContainer resumedNetwork( { resumedA, resumedB }, { resumedA, resumedB }, {}, {}, {}, nullptr, "Blueprint" );
+  resumedNetwork.SetCheckpoint( directory.string(), "Inputs" );
+  EXPECT_NO_THROW( resumedNetwork.Execute() );
+  EXPECT_EQ( resumedA->m_NumberOfUpdates, 0 );
+  EXPECT_EQ( resumedA->m_Result, 1 );
+  EXPECT_EQ( resumedB->m_NumberOfUpdates, 1 );
+
+  // Once completed, nothing is updated again
+  resumedNetwork.Execute();
+  EXPECT_EQ( resumedA->m_NumberOfUpdates, 0 );
+  EXPECT_EQ( resumedB->m_NumberOfUpdates, 1 );
+
+  // Other inputs start anew
+  resumedNetwork.SetCheckpoint( directory.string(), "Other inputs" );
+  resumedNetwork.Execute();
+  EXPECT_EQ( resumedA->m_NumberOfUpdates, 1 );
+  EXPECT_EQ( resumedB->m_NumberOfUpdates, 2 );
+
+  // Without an input key, e.g. for images in memory, checkpoints are written but never restored
+  resumedNetwork.SetCheckpoint( directory.string(), "" );
+  resumedNetwork.Execute();
+  resumedNetwork.Execute();
+  EXPECT_EQ( resumedA->m_NumberOfUpdates, 3 );
+  EXPECT_EQ( resumedB->m_NumberOfUpdates, 4 );
+
+  // A new input makes the key refer to the previous inputs: nothing is restored until the key of the new inputs is set
+  class InputSource : public SourceInterface
+  {
+  public:
+
+    void SetMiniPipelineInput( itk::DataObject::Pointer ) override {}
+    AnyFileReader::Pointer GetInputFileReader() override { return nullptr; }
+  };
+
+  auto source = std::make_shared< InputSource >();
+  auto reboundA = std::make_shared< UpdateComponent1 >( "A", *logger );
+  auto reboundB = std::make_shared< UpdateComponent1 >( "B", *logger );
+  NetworkContainer reboundNetwork( { reboundA, reboundB }, { reboundA, reboundB }, {}, { { "Source", source } }, {}, nullptr, "Blueprint" );
+  reboundNetwork.SetCheckpoint( directory.string(), "Inputs" );
+  reboundNetwork.Execute();
+  EXPECT_EQ( reboundA->m_NumberOfUpdates, 1 );
+  reboundNetwork.SetInput( "Source", itk::DataObject::New() );
+  reboundNetwork.Execute();
+  EXPECT_EQ( reboundA->m_NumberOfUpdates, 2 );
+  EXPECT_EQ( reboundB->m_NumberOfUpdates, 2 );
+  reboundNetwork.SetCheckpoint( directory.string(), "New inputs" );
+  reboundNetwork.Execute();
+  reboundNetwork.Execute();
+  EXPECT_EQ( reboundA->m_NumberOfUpdates, 3 );
+  EXPECT_EQ( reboundB->m_NumberOfUpdates, 3 );
+
+  // The key is hashed in the manifest
+  EXPECT_EQ( Checkpoint::GetHash( "" ), "cbf29ce484222325" );
+  EXPECT_EQ( Checkpoint::GetHash( "a" ), "af63dc4c8601ec8c" );
+
+  boost::filesystem::remove_all( directory );
+}
+
+TEST_F( NetworkBuilderTest, Cancel )
+{
+  // A -> B, with long running updates that poll the cancellation token at each iteration, cancelled from another
+  // thread while A runs
+  auto a = std::make_shared< UpdateComponent1 >( "A", *logger );
+  auto b = std::make_shared< UpdateComponent1 >( "B", *logger );
+  for( const auto & component : { a, b } )
+  {
+    component->m_NumberOfIterations = 10000;
+    component->m_IterationDuration = std::chrono::milliseconds( 1 );
+  }
+  NetworkContainer network( { a, b }, { a, b }, {} );
+  std::thread canceller( [ &network, &a ]() {
+      while( a->m_NumberOfUpdates == 0 )
+      {
+        std::this_thread::yield();
+      }
+      network.Cancel();
+    } );
+  const auto start = std::chrono::steady_clock::now();
+  EXPECT_THROW( network.Execute(), CancellationToken::CancelledError );
+  canceller.join();
+  EXPECT_LT( std::chrono::steady_clock::now() - start, std::chrono::seconds( 5 ) );
+  EXPECT_EQ( b->m_NumberOfUpdates, 0 );
+
+  // The network stays cancelled until its token is reset
+  EXPECT_THROW( network.Execute(), CancellationToken::CancelledError );
+  EXPECT_EQ( a->m_NumberOfUpdates, 1 );
+  a->m_NumberOfIterations = 1;
+  b->m_NumberOfIterations = 1;
+  network.GetCancellationToken()->Reset();
+  EXPECT_NO_THROW( network.Execute() );
+  EXPECT_EQ( b->m_NumberOfUpdates, 1 );
+
+  // A deadline cancels as well
+  a->m_NumberOfIterations = 10000;
+  network.GetCancellationToken()->CancelAfter( std::chrono::milliseconds( 10 ) );
+  EXPECT_THROW( network.Execute(), CancellationToken::CancelledError );
+  EXPECT_EQ( b->m_NumberOfUpdates, 1 );
+}
+
+TEST_F( NetworkBuilderTest, ProgressEvents )
+{
+  // A and B report 1000 iterations at each of 2 levels. Nobody listens: no events
+  auto a = std::make_shared< UpdateComponent1 >( "A", *logger );
+  auto b = std::make_shared< UpdateComponent1 >( "B", *logger );
+  for( const auto & component : { a, b } )
+  {
+    component->m_NumberOfLevels = 2;
+    component->m_NumberOfIterations = 1000;
+  }
+  NetworkContainer network( { a, b }, { a, b }, {}, {}, { {}, {} } );
+  network.SetNumberOfThreads( 2 );
+  EXPECT_NO_THROW( network.Execute() );
+
+  // A and B push concurrently while the events are popped
+  auto buffer = std::make_shared< ProgressEventBuffer >( 100 );
+  EXPECT_EQ( buffer->GetCapacity(), 128 );
+  network.SetProgressEventBuffer( buffer );
+  std::atomic< bool > isDone( false );
+  std::map< std::string, std::size_t > numberOfEvents;
+  std::map< std::string, std::size_t > lastIteration;
+  bool isOrdered = true;
+  std::thread listener( [ & ]() {
+      ProgressEvent event;
+      bool          wasDone = false;
+      while( !wasDone )
+      {
+        wasDone = isDone;
+        while( buffer->Pop( event ) )
+        {
+          // Events of the same component arrive in the order in which they were pushed
+          const std::size_t previous = lastIteration.count( event.componentName ) ? lastIteration[ event.componentName ] : 0;
+          isOrdered = isOrdered && ( event.iteration > previous || event.iteration == 0 );
+          lastIteration[ event.componentName ] = event.iteration;
+          ++numberOfEvents[ event.componentName ];
+        }
+      }
+    } );
+  network.Execute();
+  isDone = true;
+  listener.join();
+  EXPECT_TRUE( isOrdered );
+  EXPECT_EQ( numberOfEvents[ "A" ] + numberOfEvents[ "B" ] + buffer->GetNumberOfDroppedEvents(), 4000 );
+
+  // Events that do not fit are dropped
+  ProgressEventBuffer smallBuffer( 2 );
+  EXPECT_TRUE( smallBuffer.Push( { "A", 0, 0, 1.0, 0.0 } ) );
+  EXPECT_TRUE( smallBuffer.Push( { "A", 0, 1, 0.5, 0.0 } ) );
+  EXPECT_FALSE( smallBuffer.Push( { "A", 0, 2, 0.25, 0.0 } ) );
+  EXPECT_EQ( smallBuffer.GetNumberOfDroppedEvents(), 1 );
+  ProgressEvent event;
+  EXPECT_TRUE( smallBuffer.Pop( event ) );
+  EXPECT_EQ( event.iteration, 0 );
+  EXPECT_TRUE( smallBuffer.Push( { "A", 0, 3, 0.125, 0.0 } ) );
+  EXPECT_TRUE( smallBuffer.Pop( event ) );
+  EXPECT_TRUE( smallBuffer.Pop( event ) );
+  EXPECT_EQ( event.iteration, 3 );
+  EXPECT_FALSE( smallBuffer.Pop( event ) );
+}
+
+TEST_F( NetworkBuilderTest, PlanReport )
+{
+  // A -> B, where B needs 1000 bytes besides its output while it runs
+  auto a = std::make_shared< UpdateComponent1 >( "A", *logger );
+  auto b = std::make_shared< UpdateComponent1 >( "B", *logger );
+  a->m_OutputMemorySize = 100;
+  a->m_Estimate = { ResourceEstimate::RuntimeClass::Linear, 100 };
+  b->m_OutputMemorySize = 10;
+  b->m_Estimate = { ResourceEstimate::RuntimeClass::Iterative, 1010 };
+  auto memoryPlanner = std::make_shared< MemoryPlanner >( 2 );
+  memoryPlanner->AddComponent( b, 1, {}, true );
+  memoryPlanner->AddComponent( a, 0, { 1 }, true );
+
+  NetworkContainer network( { a, b }, {}, {}, {}, {}, memoryPlanner );
+  network.SetNumberOfThreads( 4 );
+  const NetworkPlanReport report = network.GetPlanReport();
+  ASSERT_EQ( report.components.size(), 2 );
+  EXPECT_EQ( report.components[ 0 ].name, "A" );
+  EXPECT_EQ( report.components[ 0 ].update, 0 );
+  EXPECT_EQ( report.components[ 1 ].name, "B" );
+  EXPECT_EQ( report.components[ 1 ].estimate.peakMemorySize, 1010 );
+  EXPECT_EQ( report.runtimeClass, ResourceEstimate::RuntimeClass::Iterative );
+  EXPECT_EQ( report.peakMemorySize, 1110 );
+  EXPECT_EQ( report.numberOfThreads, 4 );
+
+  // Components without estimates report their output memory
+  NetworkBuilderPointer networkBuilder = NetworkBuilderPointer( new NetworkBuilder( *logger, *blueprint, ComponentRegistry::Get< CustomComponentList >() ) );
+  EXPECT_TRUE( networkBuilder->Configure() );
+  EXPECT_TRUE( networkBuilder->ConnectComponents() );
+  const NetworkPlanReport builderReport = networkBuilder->GetPlanReport( 0 );
+  EXPECT_EQ( builderReport.components.size(), 2 );
+  EXPECT_EQ( builderReport.runtimeClass, ResourceEstimate::RuntimeClass::Unknown );
+  EXPECT_EQ( builderReport.peakMemorySize, 0 );
+
+  // The network can still be realized after planning
+  EXPECT_NO_THROW( networkBuilder->GetRealizedNetwork() );
+
+  EXPECT_EQ( ResourceEstimate::GetPyramidMemorySize( 64, 2, 3, 3 ), 128 + 16 + 2 );
+}
+
 TEST_F( NetworkBuilderTest, DeduceComponentsFromConnections )
 {
   // Fill the component database with all combinations of Dimensionality:[2,3], PixelType:[float,double] and InternalComputationValueType:[float,double]
@@ -243,7 +1015,7 @@ TEST_F( NetworkBuilderTest, DeduceComponentsFromConnections )
   blueprint->SetConnection( "FixedImageSource", "ResampleFilter", { {} }, "" );
   blueprint->SetConnection( "MovingImageSource", "ResampleFilter", { { keys::NameOfInterface, { "itkImageMovingInterface" } } }, "" );
 
-  std::unique_ptr< NetworkBuilderBase > networkBuilder( new NetworkBuilder< RegisterComponents >( *logger, *blueprint ) );
+  std::unique_ptr< NetworkBuilderBase > networkBuilder( new NetworkBuilder( *logger, *blueprint, ComponentRegistry::Get< RegisterComponents >() ) );
   bool allUniqueComponents;
   EXPECT_NO_THROW( allUniqueComponents = networkBuilder->Configure() );
   EXPECT_TRUE( allUniqueComponents );
@@ -18,12 +18,12 @@
 #=========================================================================
 #
 # This CMakeLists file will generate the file selxCompiledLibraryComponents.h
-# in the bin directory. This file defines the components to be compiled.
+# in the bin directory. This file registers the components of the enabled
+# component modules, which are compiled in the library of each module.
 #
 
-set( MODULE_COMPONENT_GROUP_INCLUDE_FILES ) 
-set( MODULE_COMPONENT_TYPELISTS_ )
-set( MODULE_COMPONENT_TYPELISTS )
+set( MODULE_COMPONENT_REGISTRATION_DECLARATIONS )
+set( MODULE_COMPONENT_REGISTRATIONS )
 
 foreach( MODULE ${SUPERELASTIX_MODULES} )
   if( ${USE_${MODULE}} )
@@ -31,24 +31,12 @@ foreach( MODULE ${SUPERELASTIX_MODULES} )
     if ( ${MODULE} STREQUAL "ModuleFilter" OR ${MODULE} STREQUAL "ModuleCore" OR ${MODULE} STREQUAL "ModuleBlueprints" OR ${MODULE} STREQUAL "ModuleLogger" OR ${MODULE} STREQUAL "ModuleFileIO" OR ${MODULE} STREQUAL "ModuleCommon")
     else()
       # building the strings:
-      set( MODULE_COMPONENT_GROUP_INCLUDE_FILES "${MODULE_COMPONENT_GROUP_INCLUDE_FILES}#include \"selx${MODULE}.h\"\n" )
-      set( MODULE_COMPONENT_TYPELISTS_ "${MODULE_COMPONENT_TYPELISTS_}  ${MODULE}Components,\n")
+      set( MODULE_COMPONENT_REGISTRATION_DECLARATIONS "${MODULE_COMPONENT_REGISTRATION_DECLARATIONS}void Register${MODULE}Components( ComponentRegistry & registry );\n" )
+      set( MODULE_COMPONENT_REGISTRATIONS "${MODULE_COMPONENT_REGISTRATIONS}  Register${MODULE}Components( registry );\n" )
     endif()
   endif()
 endforeach()
 
-# Lots of cmake code just to remove the last comma and \n from the string
-if( MODULE_COMPONENT_TYPELISTS_ )
-  string(LENGTH ${MODULE_COMPONENT_TYPELISTS_} LEN_WITH_LAST_COMMA )
-  math(EXPR LEN_WITHOUT_LAST_COMMA "${LEN_WITH_LAST_COMMA}-2" ) 
-  string( SUBSTRING ${MODULE_COMPONENT_TYPELISTS_} 0 ${LEN_WITHOUT_LAST_COMMA} MODULE_COMPONENT_TYPELISTS )
-  unset( LEN_WITH_LAST_COMMA )
-  unset( LEN_WITHOUT_LAST_COMMA )
-else()
-  set( MODULE_COMPONENT_TYPELISTS ${MODULE_COMPONENT_TYPELISTS_} )
-endif()
-unset( MODULE_COMPONENT_TYPELISTS_ )
-
 configure_file(
   ${ModuleFilter_SOURCE_DIR}/include/selxCompiledLibraryComponents.h.in
   ${PROJECT_BINARY_DIR}/selxCompiledLibraryComponents.h
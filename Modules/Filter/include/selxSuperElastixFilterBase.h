@@ -22,6 +22,9 @@
 
 #include "selxBlueprint.h"
 #include "selxLogger.h"
+#include "selxResourceEstimate.h"
+#include "selxCancellationToken.h"
+#include "selxProgressEventBuffer.h"
 
 #include "selxAnyFileReader.h"
 #include "selxAnyFileWriter.h"
@@ -69,6 +72,44 @@ public:
   itkSetObjectMacro( Logger, Logger );
   itkGetObjectMacro( Logger, Logger );
 
+  /** The total number of threads of all components together. Independent branches of the network are executed
+   * concurrently, dividing the threads among them. The NumberOfThreads criterion of a component in the blueprint
+   * overrides its share. The default of 0 executes the components one by one, each with all threads of the backend. */
+  itkSetMacro( MaximumNumberOfThreads, unsigned int );
+  itkGetConstMacro( MaximumNumberOfThreads, unsigned int );
+
+  /** Make the results bit-reproducible, e.g. for regression benchmarks: random samplers of all components are seeded by
+   * the RandomSeed and multithreaded reductions are avoided. A RandomSeed of 0 leaves the seeds to the components, or,
+   * if Deterministic, uses NetworkContainer::DefaultRandomSeed. */
+  itkSetMacro( Deterministic, bool );
+  itkGetConstMacro( Deterministic, bool );
+  itkBooleanMacro( Deterministic );
+  itkSetMacro( RandomSeed, unsigned int );
+  itkGetConstMacro( RandomSeed, unsigned int );
+
+  /** The directory to which the results of each component are written as soon as it has finished. An execution that
+   * was interrupted resumes from these, provided that the blueprint and the CheckpointInputKey did not change. The
+   * key identifies the inputs, e.g. by their file names and modification times. Without a key, checkpoints are
+   * written but not restored, because other inputs, e.g. other images in memory, cannot be told apart. The default
+   * empty directory writes no checkpoints. */
+  itkSetStringMacro( CheckpointDirectory );
+  itkGetStringMacro( CheckpointDirectory );
+  itkSetStringMacro( CheckpointInputKey );
+  itkGetStringMacro( CheckpointInputKey );
+
+  /** Stop the execution of the network, from another thread. The Update() that executes it throws a
+   * CancellationToken::CancelledError. The filter remains cancelled until its cancellation token is Reset(). */
+  void Cancel();
+
+  /** The token by which the network is cancelled, e.g. by a deadline set by CancellationToken::CancelAfter() */
+  CancellationToken::Pointer GetCancellationToken() const;
+
+  /** Let the registration components stream their progress to progressEventBuffer during Update(), from which the
+   * caller pops the ProgressEvents, e.g. from another thread. The default nullptr reports no progress. */
+  void SetProgressEventBuffer( ProgressEventBuffer::Pointer progressEventBuffer );
+
+  ProgressEventBuffer::Pointer GetProgressEventBuffer() const;
+
   // Adding a BlueprintImpl composes SuperElastixFilter' internal blueprint (accessible by Set/Get BlueprintImpl) with the otherBlueprint.
   // void AddBlueprint(BlueprintPointer otherBlueprint);
 
@@ -108,6 +149,10 @@ public:
     return newOutput;
   }
 
+  /** The estimated runtime class and peak memory of each component and of the network as a whole, without executing
+   * the network. The inputs must be set, since the components derive their estimates from the input image domains. */
+  NetworkPlanReport GetPlanReport( void );
+
   void Update( void ) ITK_OVERRIDE;
 
   // The default logger redirects to std::cout 
@@ -132,6 +177,22 @@ private:
 
   bool m_IsConnected;
   bool m_AllUniqueComponents;
+
+  // The blueprint of m_NetworkBuilder and its modified time when it was configured last
+  BlueprintConstPointer m_ConfiguredBlueprint;
+  itk::ModifiedTimeType m_ConfiguredBlueprintMTime;
+
+  unsigned int m_MaximumNumberOfThreads;
+
+  bool         m_Deterministic;
+  unsigned int m_RandomSeed;
+
+  std::string m_CheckpointDirectory;
+  std::string m_CheckpointInputKey;
+
+  const CancellationToken::Pointer m_CancellationToken;
+
+  ProgressEventBuffer::Pointer m_ProgressEventBuffer;
 };
 } // namespace elx
 
@@ -33,8 +33,7 @@ template< typename ComponentTypeList >
 SuperElastixFilterCustomComponents< ComponentTypeList >
 ::SuperElastixFilterCustomComponents( void ) : SuperElastixFilterBase()
 {
-  //std::make_unique<NetworkBuilder<ComponentTypeList>>();
-  m_NetworkBuilderFactory = std::unique_ptr< NetworkBuilderFactory< ComponentTypeList >>( new NetworkBuilderFactory< ComponentTypeList > );
+  m_NetworkBuilderFactory = std::unique_ptr< NetworkBuilderFactory >( new NetworkBuilderFactory( ComponentRegistry::Get< ComponentTypeList >() ) );
   m_Logger = Logger::New();
 } // end Constructor
 } // namespace elx
@@ -22,6 +22,8 @@
 #include "selxNetworkBuilderFactory.h"
 #include "selxCompiledLibraryComponents.h"
 
+#include <mutex>
+
 namespace selx
 {
 /**
@@ -31,7 +33,11 @@ namespace selx
 SuperElastixFilter
 ::SuperElastixFilter( void ) : SuperElastixFilterBase()
 {
-  // The default constructor registers the default components.
-  m_NetworkBuilderFactory = std::unique_ptr< NetworkBuilderFactory< CompiledLibraryComponents >>(new NetworkBuilderFactory< CompiledLibraryComponents >);
+  // The default constructor registers the default components, once, in the default registry.
+  static std::once_flag isRegistered;
+  std::call_once( isRegistered, []() {
+      RegisterCompiledLibraryComponents( ComponentRegistry::GetDefault() );
+    } );
+  m_NetworkBuilderFactory = std::unique_ptr< NetworkBuilderFactory >( new NetworkBuilderFactory( ComponentRegistry::GetDefault() ) );
 } // end Constructor
 } // namespace elx
@@ -30,7 +30,12 @@ namespace selx
 SuperElastixFilterBase
 ::SuperElastixFilterBase() :
   m_IsConnected( false ),
-  m_AllUniqueComponents( false )
+  m_AllUniqueComponents( false ),
+  m_ConfiguredBlueprintMTime( 0 ),
+  m_MaximumNumberOfThreads( 0 ),
+  m_Deterministic( false ),
+  m_RandomSeed( 0 ),
+  m_CancellationToken( std::make_shared< CancellationToken >() )
 {
   this->m_Blueprint = nullptr;
 
@@ -47,11 +52,18 @@ bool
 SuperElastixFilterBase
 ::ParseBlueprint()
 {
-  if( ( this->m_Blueprint->GetMTime() > this->GetMTime() || !this->m_NetworkBuilder ) )
+  if( !this->m_NetworkBuilder || this->m_ConfiguredBlueprint != this->m_Blueprint )
   {
     m_NetworkBuilder = m_NetworkBuilderFactory->New( this->m_Logger->GetLoggerImpl(), this->m_Blueprint->GetBlueprintImpl() );
+    this->m_ConfiguredBlueprint = this->m_Blueprint;
     this->m_AllUniqueComponents = this->m_NetworkBuilder->Configure();
   }
+  else if( this->m_Blueprint->GetMTime() > this->m_ConfiguredBlueprintMTime )
+  {
+    // The NetworkBuilder reconfigures only the components that were modified in the blueprint
+    this->m_AllUniqueComponents = this->m_NetworkBuilder->Configure();
+  }
+  this->m_ConfiguredBlueprintMTime = this->m_Blueprint->GetMTime();
   return this->m_AllUniqueComponents;
 }
 
@@ -189,6 +201,21 @@ SuperElastixFilterBase
   // this->m_NetworkBuilder = nullptr;
 
   // This calls controller components that take over the control flow if the itk pipeline is broken.
+  fullyConfiguredNetwork.SetNumberOfThreads( this->m_MaximumNumberOfThreads );
+  fullyConfiguredNetwork.SetDeterministic( this->m_Deterministic );
+  fullyConfiguredNetwork.SetRandomSeed( this->m_RandomSeed );
+  fullyConfiguredNetwork.SetCancellationToken( this->m_CancellationToken );
+  fullyConfiguredNetwork.SetProgressEventBuffer( this->m_ProgressEventBuffer );
+  if( !this->m_CheckpointDirectory.empty() )
+  {
+    this->m_Logger->Log( LogLevel::INF, "Writing checkpoints to {0}", this->m_CheckpointDirectory );
+    if( this->m_CheckpointInputKey.empty() )
+    {
+      this->m_Logger->Log( LogLevel::WRN, "No CheckpointInputKey is set: the checkpoints in {0} are not restored, because other inputs cannot be told apart",
+        this->m_CheckpointDirectory );
+    }
+    fullyConfiguredNetwork.SetCheckpoint( this->m_CheckpointDirectory, this->m_CheckpointInputKey );
+  }
   fullyConfiguredNetwork.Execute();
 
   // Connect the itk pipeline.
@@ -271,6 +298,48 @@ SuperElastixFilterBase
 }
 
 
+NetworkPlanReport
+SuperElastixFilterBase
+::GetPlanReport( void )
+{
+  // Connect the network and propagate the image domains of the inputs to all components
+  this->UpdateOutputInformation();
+  return this->m_NetworkBuilder->GetPlanReport( this->m_MaximumNumberOfThreads );
+}
+
+
+void
+SuperElastixFilterBase
+::Cancel( void )
+{
+  this->m_CancellationToken->Cancel();
+}
+
+
+CancellationToken::Pointer
+SuperElastixFilterBase
+::GetCancellationToken( void ) const
+{
+  return this->m_CancellationToken;
+}
+
+
+void
+SuperElastixFilterBase
+::SetProgressEventBuffer( ProgressEventBuffer::Pointer progressEventBuffer )
+{
+  this->m_ProgressEventBuffer = progressEventBuffer;
+}
+
+
+ProgressEventBuffer::Pointer
+SuperElastixFilterBase
+::GetProgressEventBuffer( void ) const
+{
+  return this->m_ProgressEventBuffer;
+}
+
+
 void
 SuperElastixFilterBase
 ::Update( void )
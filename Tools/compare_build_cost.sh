@@ -0,0 +1,62 @@
+#!/usr/bin/env bash
+
+# Compare the build time and binary size of SuperElastix at two git revisions, e.g. before and after a change
+# in how components are instantiated.
+#
+# Usage, from the root of the source, i.e. the local git repo:
+#   Tools/compare_build_cost.sh <before-revision> <after-revision> [cmake arguments ...]
+#
+# The cmake arguments must point to the dependencies, e.g. -DCMAKE_PREFIX_PATH=<directory of the SuperBuild>.
+# Each revision is checked out in a temporary git worktree and built from scratch with the same arguments.
+# Set JOBS to change the number of parallel build jobs (default: number of cores).
+
+set -e
+
+if [ $# -lt 2 ]
+then
+  echo "Usage: $0 <before-revision> <after-revision> [cmake arguments ...]"
+  exit 1
+fi
+
+BEFORE=$1
+AFTER=$2
+shift 2
+JOBS=${JOBS:-$(getconf _NPROCESSORS_ONLN)}
+WORK_DIR=$(mktemp -d)
+
+cleanup() {
+  for revision in before after; do
+    git worktree remove --force "$WORK_DIR/$revision-source" > /dev/null 2>&1 || true
+  done
+  rm -rf "$WORK_DIR"
+}
+trap cleanup EXIT
+
+build() {
+  local name=$1
+  local revision=$2
+  shift 2
+  local source_dir="$WORK_DIR/$name-source"
+  local build_dir="$WORK_DIR/$name-build"
+
+  git worktree add --detach "$source_dir" "$revision" > /dev/null
+  cmake -S "$source_dir" -B "$build_dir" -DCMAKE_BUILD_TYPE=Release -DBUILD_TESTING=OFF "$@" > "$WORK_DIR/$name-configure.log"
+
+  local start=$(date +%s)
+  cmake --build "$build_dir" -j "$JOBS" > "$WORK_DIR/$name-build.log"
+  local end=$(date +%s)
+
+  local library_size=$(find "$build_dir" -name "*.a" -o -name "*.so" -o -name "*.lib" -o -name "*.dll" | xargs -r du -cb | tail -n 1 | cut -f 1)
+  local executable=$(find "$build_dir" -type f \( -name "SuperElastix" -o -name "SuperElastix.exe" \) | head -n 1)
+  local executable_size=0
+  if [ -n "$executable" ]; then
+    executable_size=$(du -b "$executable" | cut -f 1)
+  fi
+
+  printf "%-8s %-12s %10s s %14s bytes %14s bytes\n" "$name" "$(git rev-parse --short "$revision")" \
+    $(( end - start )) "${library_size:-0}" "$executable_size"
+}
+
+printf "%-8s %-12s %12s %20s %20s\n" "" "revision" "build time" "libraries" "SuperElastix"
+build before "$BEFORE" "$@"
+build after "$AFTER" "$@"